@@ -0,0 +1,113 @@
+//
+// Copyright (c) 2016 CNRS
+//
+// This file is part of Pinocchio
+// Pinocchio is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// Pinocchio is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Lesser Public License for more details. You should have
+// received a copy of the GNU Lesser General Public License along with
+// Pinocchio If not, see
+// <http://www.gnu.org/licenses/>.
+
+#include "pinocchio/multibody/model.hpp"
+#include "pinocchio/algorithm/kinematics.hpp"
+#include "pinocchio/algorithm/rnea.hpp"
+#include "pinocchio/algorithm/aba.hpp"
+#include "pinocchio/multibody/parser/sample-models.hpp"
+
+// Generated at build time by pinocchio_generate_c_kernels -f HS humanoid_simple
+#include "humanoid_simple.h"
+
+#include <iostream>
+
+#include "pinocchio/tools/timer.hpp"
+
+int main()
+{
+  using namespace Eigen;
+  using namespace se3;
+
+  StackTicToc timer(StackTicToc::US);
+  #ifdef NDEBUG
+  const int NBT = 1000*100;
+  #else
+    const int NBT = 1;
+    std::cout << "(the time score in debug mode is not relevant) " << std::endl;
+  #endif
+
+  // Same model as the one given to the generator.
+  se3::Model model;
+  se3::buildModels::humanoidSimple(model,true);
+  assert(model.nq == HUMANOID_SIMPLE_NQ && model.nv == HUMANOID_SIMPLE_NV);
+  se3::Data data(model);
+  std::cout << "nq = " << model.nq << std::endl;
+
+  std::vector<VectorXd> qs     (NBT);
+  std::vector<VectorXd> qdots  (NBT);
+  std::vector<VectorXd> qddots (NBT);
+  for(size_t i=0;i<NBT;++i)
+    {
+      qs[i]     = Eigen::VectorXd::Random(model.nq);
+      qs[i].segment<4>(3) /= qs[i].segment<4>(3).norm();
+      qdots[i]  = Eigen::VectorXd::Random(model.nv);
+      qddots[i] = Eigen::VectorXd::Random(model.nv);
+    }
+  VectorXd tau (model.nv), ddq (model.nv);
+  std::vector<double> oMi (12*(std::size_t)model.nbody);
+
+  // Check the generated kernels against the generic algorithms.
+  humanoid_simple_rnea(qs[0].data(),qdots[0].data(),qddots[0].data(),tau.data());
+  std::cout << "RNEA codegen error = \t" << (tau - rnea(model,data,qs[0],qdots[0],qddots[0])).norm() << std::endl;
+  humanoid_simple_aba(qs[0].data(),qdots[0].data(),tau.data(),ddq.data());
+  std::cout << "ABA codegen error = \t" << (ddq - qddots[0]).norm() << std::endl;
+
+  timer.tic();
+  SMOOTH(NBT)
+  {
+    rnea(model,data,qs[_smooth],qdots[_smooth],qddots[_smooth]);
+  }
+  std::cout << "RNEA = \t\t"; timer.toc(std::cout,NBT);
+
+  timer.tic();
+  SMOOTH(NBT)
+  {
+    humanoid_simple_rnea(qs[_smooth].data(),qdots[_smooth].data(),qddots[_smooth].data(),tau.data());
+  }
+  std::cout << "RNEA codegen = \t"; timer.toc(std::cout,NBT);
+
+  timer.tic();
+  SMOOTH(NBT)
+  {
+    aba(model,data,qs[_smooth],qdots[_smooth],qddots[_smooth]);
+  }
+  std::cout << "ABA = \t\t"; timer.toc(std::cout,NBT);
+
+  timer.tic();
+  SMOOTH(NBT)
+  {
+    humanoid_simple_aba(qs[_smooth].data(),qdots[_smooth].data(),qddots[_smooth].data(),ddq.data());
+  }
+  std::cout << "ABA codegen = \t"; timer.toc(std::cout,NBT);
+
+  timer.tic();
+  SMOOTH(NBT)
+  {
+    forwardKinematics(model,data,qs[_smooth]);
+  }
+  std::cout << "Geometry = \t"; timer.toc(std::cout,NBT);
+
+  timer.tic();
+  SMOOTH(NBT)
+  {
+    humanoid_simple_forward_kinematics(qs[_smooth].data(),oMi.data());
+  }
+  std::cout << "Geometry codegen = \t"; timer.toc(std::cout,NBT);
+
+  return 0;
+}
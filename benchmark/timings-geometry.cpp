@@ -28,6 +28,9 @@
 #include "pinocchio/algorithm/compute-all-terms.hpp"
 #include "pinocchio/algorithm/kinematics.hpp"
 #include "pinocchio/algorithm/collisions.hpp"
+#include "pinocchio/algorithm/continuous-collisions.hpp"
+#include "pinocchio/algorithm/joint-configuration.hpp"
+#include "pinocchio/algorithm/parallel-collisions.hpp"
 #include "pinocchio/multibody/parser/urdf.hpp"
 #include "pinocchio/multibody/parser/sample-models.hpp"
 
@@ -129,6 +132,48 @@ int main()
   std::cout << "Collision Test : robot in collision? = \t" << is_colliding_time
             << StackTicToc::unitName(StackTicToc::US) << std::endl;
 
+  geom_data.setBroadPhase(false);
+  timer.tic();
+  SMOOTH(NBD)
+  {
+    computeCollisions(model,data,geom_model,geom_data,qs_romeo[_smooth], false);
+  }
+  double narrow_phase_time = timer.toc(StackTicToc::US)/NBD - (update_col_time + geom_time);
+  std::cout << "Collision Test : all pairs, narrow phase only = \t" << narrow_phase_time
+            << StackTicToc::unitName(StackTicToc::US) << std::endl;
+
+  geom_data.setCollisionProxies(false);
+  timer.tic();
+  SMOOTH(NBD)
+  {
+    computeCollisions(model,data,geom_model,geom_data,qs_romeo[_smooth], false);
+  }
+  double mesh_only_time = timer.toc(StackTicToc::US)/NBD - (update_col_time + geom_time);
+  std::cout << "Collision Test : all pairs, narrow phase on the meshes only = \t" << mesh_only_time
+            << StackTicToc::unitName(StackTicToc::US)
+            << " (bounding capsules first: speedup " << mesh_only_time / narrow_phase_time << ")" << std::endl;
+  geom_data.setCollisionProxies(true);
+
+  geom_data.setBroadPhase(true);
+  timer.tic();
+  SMOOTH(NBD)
+  {
+    computeCollisions(model,data,geom_model,geom_data,qs_romeo[_smooth], false);
+  }
+  double broad_phase_time = timer.toc(StackTicToc::US)/NBD - (update_col_time + geom_time);
+  std::cout << "Collision Test : all pairs, broad phase + narrow phase = \t" << broad_phase_time
+            << StackTicToc::unitName(StackTicToc::US)
+            << " (speedup " << narrow_phase_time / broad_phase_time << ", "
+            << geom_data.broad_phase_candidates.size() << " / " << geom_data.nCollisionPairs << " pairs tested)" << std::endl;
+
+  timer.tic();
+  SMOOTH(NBT)
+  {
+    geom_data.updateBroadPhase();
+  }
+  std::cout << "Broad phase alone = \t" << timer.toc(StackTicToc::US)/NBT
+            << StackTicToc::unitName(StackTicToc::US) << std::endl;
+
 
   timer.tic();
   SMOOTH(NBD)
@@ -139,6 +184,98 @@ int main()
   std::cout << "Compute distance between two geometry objects (mean time) = \t" << computeDistancesTime / geom_data.nCollisionPairs
             << " " << StackTicToc::unitName(StackTicToc::US) << " " << geom_data.nCollisionPairs << " col pairs" << std::endl;
 
+  parallel::NarrowPhasePool narrow_phase_pool;
+  geom_data.setBroadPhase(false);
+  timer.tic();
+  SMOOTH(NBD)
+  {
+    parallel::computeCollisions(narrow_phase_pool,model,data,geom_model,geom_data,qs_romeo[_smooth], false);
+  }
+  double parallel_narrow_phase_time = timer.toc(StackTicToc::US)/NBD - (update_col_time + geom_time);
+  std::cout << "Collision Test : all pairs, parallel narrow phase (" << narrow_phase_pool.size() << " threads) = \t"
+            << parallel_narrow_phase_time << StackTicToc::unitName(StackTicToc::US)
+            << " (speedup " << narrow_phase_time / parallel_narrow_phase_time << ")" << std::endl;
+  geom_data.setBroadPhase(true);
+
+  timer.tic();
+  SMOOTH(NBD)
+  {
+    parallel::computeDistances(narrow_phase_pool,model,data,geom_model,geom_data,qs_romeo[_smooth]);
+  }
+  double parallel_distances_time = timer.toc(StackTicToc::US)/NBD - (update_col_time + geom_time);
+  std::cout << "Compute distances, parallel (" << narrow_phase_pool.size() << " threads) = \t" << parallel_distances_time
+            << " " << StackTicToc::unitName(StackTicToc::US)
+            << " (speedup " << computeDistancesTime / parallel_distances_time << ")" << std::endl;
+
+  // Distances along a smooth trajectory: only the pairs which may be closer than the threshold are evaluated
+  const double DISTANCE_THRESHOLD = 0.05;
+  std::vector<VectorXd> qs_trajectory (NBD);
+  qs_trajectory[0] = qs_romeo[0];
+  for(size_t i=1;i<NBD;++i)
+    qs_trajectory[i] = integrate(model, qs_trajectory[i-1], 0.01*Eigen::VectorXd::Random(model.nv));
+
+  timer.tic();
+  SMOOTH(NBD)
+  {
+    computeDistances(model,data,geom_model,geom_data,qs_trajectory[_smooth]);
+  }
+  double trajectory_distances_time = timer.toc(StackTicToc::US)/NBD;
+
+  geom_data.resetDistanceCache();
+  long nb_evaluated_pairs = 0;
+  timer.tic();
+  SMOOTH(NBD)
+  {
+    computeDistances(model,data,geom_model,geom_data,qs_trajectory[_smooth],DISTANCE_THRESHOLD);
+  }
+  double cached_distances_time = timer.toc(StackTicToc::US)/NBD;
+  for(long k=0;k<(long)geom_data.nCollisionPairs;++k)
+    nb_evaluated_pairs += (geom_data.distance_lower_bounds[k] == geom_data.distance_results[(size_t)k].distance());
+  std::cout << "Update + Compute distances along a trajectory (K+D) = \t" << trajectory_distances_time
+            << " " << StackTicToc::unitName(StackTicToc::US) << std::endl;
+  std::cout << "Update + Compute distances along a trajectory, cached below " << DISTANCE_THRESHOLD << " (K+D) = \t"
+            << cached_distances_time << " " << StackTicToc::unitName(StackTicToc::US)
+            << " (speedup " << trajectory_distances_time / cached_distances_time << ", "
+            << nb_evaluated_pairs << " / " << geom_data.nCollisionPairs << " pairs evaluated at the last step)" << std::endl;
+
+
+  // Validation of the straight motions between close configurations: continuous collision checking against a dense discretization
+  const int NB_STEPS = 100;
+  std::vector<VectorXd> qs_romeo_end (NBD);
+  for(size_t i=0;i<NBD;++i)
+    qs_romeo_end[i] = integrate(model, qs_romeo[i], 0.2*Eigen::VectorXd::Random(model.nv));
+
+  int nb_continuous_collisions = 0;
+  double time_of_contact;
+  timer.tic();
+  SMOOTH(NBD)
+  {
+    nb_continuous_collisions += computeContinuousCollisions(model,data,geom_model,geom_data,
+                                                            qs_romeo[_smooth],qs_romeo_end[_smooth],time_of_contact);
+  }
+  double continuous_time = timer.toc(StackTicToc::US)/NBD;
+
+  int nb_discrete_collisions = 0;
+  VectorXd q_step(model.nq);
+  timer.tic();
+  SMOOTH(NBD)
+  {
+    for(int k=0;k<=NB_STEPS;++k)
+    {
+      interpolate(model,qs_romeo[_smooth],qs_romeo_end[_smooth],k/(double)NB_STEPS,q_step);
+      if(computeCollisions(model,data,geom_model,geom_data,q_step,true))
+      {
+        ++nb_discrete_collisions;
+        break;
+      }
+    }
+  }
+  double discrete_time = timer.toc(StackTicToc::US)/NBD;
+  std::cout << "Continuous collision checking of a motion = \t" << continuous_time << " " << StackTicToc::unitName(StackTicToc::US)
+            << " (" << nb_continuous_collisions << " / " << NBD << " motions in collision)" << std::endl;
+  std::cout << "Discretized collision checking of a motion (" << NB_STEPS << " steps) = \t" << discrete_time
+            << " " << StackTicToc::unitName(StackTicToc::US)
+            << " (" << nb_discrete_collisions << " / " << NBD << " motions in collision)" << std::endl;
 
 
 #ifdef WITH_HPP_MODEL_URDF
@@ -22,12 +22,18 @@
 #include "pinocchio/multibody/model.hpp"
 #include "pinocchio/algorithm/crba.hpp"
 #include "pinocchio/algorithm/aba.hpp"
+#include "pinocchio/algorithm/aba-derivatives.hpp"
 #include "pinocchio/algorithm/rnea.hpp"
+#include "pinocchio/algorithm/rnea-batch.hpp"
+#include "pinocchio/algorithm/rnea-derivatives.hpp"
+#include "pinocchio/algorithm/joint-configuration.hpp"
 #include "pinocchio/algorithm/cholesky.hpp"
+#include "pinocchio/algorithm/dynamics.hpp"
 #include "pinocchio/algorithm/jacobian.hpp"
 #include "pinocchio/algorithm/center-of-mass.hpp"
 #include "pinocchio/algorithm/compute-all-terms.hpp"
 #include "pinocchio/algorithm/kinematics.hpp"
+#include "pinocchio/algorithm/parallel.hpp"
 #include "pinocchio/multibody/parser/urdf.hpp"
 #include "pinocchio/multibody/parser/sample-models.hpp"
 
@@ -100,6 +106,134 @@ int main(int argc, const char ** argv)
     rnea(model,data,qs[_smooth],qdots[_smooth],Eigen::VectorXd::Zero(model.nv));
   }
   std::cout << "NLE via RNEA = \t\t"; timer.toc(std::cout,NBT);
+
+  se3::DataSoA data_soa(model);
+  timer.tic();
+  SMOOTH(NBT)
+  {
+    rnea(model,data_soa,qs[_smooth],qdots[_smooth],qddots[_smooth]);
+  }
+  std::cout << "RNEA SoA = \t\t"; timer.toc(std::cout,NBT);
+
+  const se3::ModelTpl<double> model_d (model);
+  se3::DataTpl<double> data_d (model_d);
+  const se3::ModelTpl<float> model_f (model);
+  se3::DataTpl<float> data_f (model_f);
+  std::vector<VectorXf> qs_f ((size_t)NBT), qdots_f ((size_t)NBT), qddots_f ((size_t)NBT);
+  for(size_t i=0;i<(size_t)NBT;++i)
+  {
+    qs_f[i] = qs[i].cast<float>(); qdots_f[i] = qdots[i].cast<float>(); qddots_f[i] = qddots[i].cast<float>();
+  }
+  timer.tic();
+  SMOOTH(NBT)
+  {
+    rnea(model_d,data_d,qs[_smooth],qdots[_smooth],qddots[_smooth]);
+  }
+  std::cout << "RNEA ModelTpl<double> = \t"; timer.toc(std::cout,NBT);
+
+  timer.tic();
+  SMOOTH(NBT)
+  {
+    rnea(model_f,data_f,qs_f[_smooth],qdots_f[_smooth],qddots_f[_smooth]);
+  }
+  std::cout << "RNEA ModelTpl<float> = \t"; timer.toc(std::cout,NBT);
+
+  timer.tic();
+  SMOOTH(NBT)
+  {
+    aba(model_f,data_f,qs_f[_smooth],qdots_f[_smooth],qddots_f[_smooth]);
+  }
+  std::cout << "ABA ModelTpl<float> = \t"; timer.toc(std::cout,NBT);
+
+  const int BATCH_SIZE = 8;
+  se3::BatchData batch_data(model,BATCH_SIZE);
+  MatrixXd Qs (model.nq,BATCH_SIZE), Qdots (model.nv,BATCH_SIZE), Qddots (model.nv,BATCH_SIZE);
+  for(int k=0;k<BATCH_SIZE;++k)
+  {
+    Qs.col(k) = qs[(size_t)k%NBT]; Qdots.col(k) = qdots[(size_t)k%NBT]; Qddots.col(k) = qddots[(size_t)k%NBT];
+  }
+  timer.tic();
+  SMOOTH(NBT/BATCH_SIZE+1)
+  {
+    rnea(model,batch_data,Qs,Qdots,Qddots);
+  }
+  std::cout << "RNEA batch (per sample) = \t"; timer.toc(std::cout,(NBT/BATCH_SIZE+1)*BATCH_SIZE);
+
+  std::vector<se3::SE3> Ms ((size_t)BATCH_SIZE), Ms2 ((size_t)BATCH_SIZE), Ms12 ((size_t)BATCH_SIZE);
+  batch::SE3Batch M_batch (BATCH_SIZE), M2_batch (BATCH_SIZE), M12_batch (BATCH_SIZE);
+  batch::Matrix6x V_batch (batch::Matrix6x::Random(6,BATCH_SIZE)), AV_batch (6,BATCH_SIZE);
+  for(int k=0;k<BATCH_SIZE;++k)
+  {
+    Ms[(size_t)k] = se3::SE3::Random(); Ms2[(size_t)k] = se3::SE3::Random();
+    M_batch.set(k,Ms[(size_t)k]); M2_batch.set(k,Ms2[(size_t)k]);
+  }
+  timer.tic();
+  SMOOTH(NBT)
+  {
+    for(int k=0;k<BATCH_SIZE;++k)
+      AV_batch.col(k) = Ms[(size_t)k].actInv(se3::Motion(V_batch.col(k))).toVector();
+  }
+  std::cout << "SE3 actInv (x " << BATCH_SIZE << ") = \t"; timer.toc(std::cout,NBT);
+
+  timer.tic();
+  SMOOTH(NBT)
+  {
+    AV_batch.setZero();
+    batch::motionActionInverse(M_batch,V_batch,AV_batch);
+  }
+  std::cout << "SE3 actInv batch (x " << BATCH_SIZE << ") = \t"; timer.toc(std::cout,NBT);
+
+  timer.tic();
+  SMOOTH(NBT)
+  {
+    for(int k=0;k<BATCH_SIZE;++k)
+      Ms12[(size_t)k] = Ms[(size_t)k]*Ms2[(size_t)k];
+  }
+  std::cout << "SE3 compose (x " << BATCH_SIZE << ") = \t"; timer.toc(std::cout,NBT);
+
+  timer.tic();
+  SMOOTH(NBT)
+  {
+    batch::compose(M_batch,M2_batch,M12_batch);
+  }
+  std::cout << "SE3 compose batch (x " << BATCH_SIZE << ") = \t"; timer.toc(std::cout,NBT);
+
+  parallel::DataPool pool(model);
+  MatrixXd Qs_all (model.nq,NBT), Qdots_all (model.nv,NBT), Qddots_all (model.nv,NBT), Taus_all;
+  for(int k=0;k<NBT;++k)
+  {
+    Qs_all.col(k) = qs[(size_t)k]; Qdots_all.col(k) = qdots[(size_t)k]; Qddots_all.col(k) = qddots[(size_t)k];
+  }
+  timer.tic();
+  parallel::rneaBatch(pool,Qs_all,Qdots_all,Qddots_all,Taus_all);
+  std::cout << "RNEA parallel (per sample, " << pool.size() << " threads) = \t"; timer.toc(std::cout,NBT);
+
+  timer.tic();
+  SMOOTH(NBT)
+  {
+    computeRNEADerivatives(model,data,qs[_smooth],qdots[_smooth],qddots[_smooth]);
+  }
+  std::cout << "RNEA derivatives = \t\t"; timer.toc(std::cout,NBT);
+
+  MatrixXd dtau_dq_fd (model.nv,model.nv), dtau_dv_fd (model.nv,model.nv);
+  VectorXd dq_fd (VectorXd::Zero(model.nv)), v_fd (model.nv);
+  const double eps_fd = 1e-8;
+  timer.tic();
+  SMOOTH(NBT/10)
+  {
+    const VectorXd tau0 (rnea(model,data,qs[_smooth],qdots[_smooth],qddots[_smooth]));
+    v_fd = qdots[_smooth];
+    for(int k=0;k<model.nv;++k)
+    {
+      dq_fd[k] = eps_fd;
+      dtau_dq_fd.col(k) = (rnea(model,data,integrate(model,qs[_smooth],dq_fd),qdots[_smooth],qddots[_smooth]) - tau0)/eps_fd;
+      dq_fd[k] = 0.;
+      v_fd[k] += eps_fd;
+      dtau_dv_fd.col(k) = (rnea(model,data,qs[_smooth],v_fd,qddots[_smooth]) - tau0)/eps_fd;
+      v_fd[k] = qdots[_smooth][k];
+    }
+  }
+  std::cout << "RNEA finite differences (2 nv + 1 calls) = \t"; timer.toc(std::cout,NBT/10);
  
   timer.tic();
   SMOOTH(NBT)
@@ -108,6 +242,13 @@ int main(int argc, const char ** argv)
     }
   std::cout << "CRBA = \t\t"; timer.toc(std::cout,NBT);
 
+  timer.tic();
+  SMOOTH(NBT)
+    {
+      crbaSparse(model,data,qs[_smooth]);
+    }
+  std::cout << "CRBA sparse = \t\t"; timer.toc(std::cout,NBT);
+
   timer.tic();
   SMOOTH(NBT)
   {
@@ -125,6 +266,98 @@ int main(int argc, const char ** argv)
     }
   std::cout << "Cholesky = \t" << (total/NBT) 
 	    << " " << timer.unitName(timer.DEFAULT_UNIT) <<std::endl;
+
+  total = 0;
+  SMOOTH(NBT)
+    {
+      crbaSparse(model,data,qs[_smooth]);
+      timer.tic();
+      cholesky::decomposeSparse(model,data);
+      total += timer.toc(timer.DEFAULT_UNIT);
+    }
+  std::cout << "Cholesky sparse = \t" << (total/NBT) 
+	    << " " << timer.unitName(timer.DEFAULT_UNIT) <<std::endl;
+
+  // Two contacts, on the last body and on a body in the middle of the tree.
+  computeJacobians(model,data,q);
+  MatrixXd J_contacts (12,model.nv);
+  {
+    Data::Matrix6x J_body (6,model.nv);
+    J_body.setZero(); getJacobian<true>(model,data,(Model::Index)model.nbody-1,J_body); J_contacts.topRows<6>() = J_body;
+    J_body.setZero(); getJacobian<true>(model,data,(Model::Index)model.nbody/2,J_body); J_contacts.bottomRows<6>() = J_body;
+  }
+  crba(model,data,q);
+  cholesky::decompose(model,data);
+  timer.tic();
+  SMOOTH(NBT)
+  {
+    computeJMinvJt(model,data,J_contacts);
+  }
+  std::cout << "J Minv Jt (2 contacts) = \t"; timer.toc(std::cout,NBT);
+
+  timer.tic();
+  SMOOTH(NBT)
+  {
+    data.sDUiJt = J_contacts.transpose();
+    cholesky::Uiv(model,data,data.sDUiJt);
+    for(int k=0;k<model.nv;++k) data.sDUiJt.row(k) /= sqrt(data.D[k]);
+    data.JMinvJt.noalias() = data.sDUiJt.transpose() * data.sDUiJt;
+    data.llt_JMinvJt.compute(data.JMinvJt);
+  }
+  std::cout << "J Minv Jt dense (2 contacts) = \t"; timer.toc(std::cout,NBT);
+
+  std::vector<Model::JointIndex> contacts;
+  contacts.push_back((Model::JointIndex)model.nbody-1);
+  contacts.push_back((Model::JointIndex)model.nbody/2);
+  const VectorXd gamma_contacts (VectorXd::Zero(12));
+  timer.tic();
+  SMOOTH(NBT)
+  {
+    forwardDynamics(model,data,qs[_smooth],qdots[_smooth],qddots[_smooth],J_contacts,gamma_contacts);
+  }
+  std::cout << "forwardDynamics (2 contacts) = \t"; timer.toc(std::cout,NBT);
+
+  // Simulation-like trajectory: q moves at each step and the same two contacts stay active, so that forwardDynamics
+  // reuses the constraint pattern cached in data. As a comparison, the two contacts are swapped at every step.
+  const size_t NTRAJ = std::min((size_t)NBT,(size_t)1000);
+  std::vector<VectorXd> qs_traj (NTRAJ);
+  std::vector<MatrixXd> J_traj (NTRAJ), J_traj_swapped (NTRAJ);
+  {
+    Data::Matrix6x J_body (6,model.nv);
+    VectorXd q_traj (qs[0]);
+    for(size_t k=0;k<NTRAJ;++k)
+    {
+      integrate(model,q_traj,1e-3*qdots[0],q_traj);
+      qs_traj[k] = q_traj;
+      computeJacobians(model,data,q_traj);
+      J_traj[k].resize(12,model.nv); J_traj_swapped[k].resize(12,model.nv);
+      J_body.setZero(); getJacobian<true>(model,data,(Model::Index)model.nbody-1,J_body);
+      J_traj[k].topRows<6>() = J_body; J_traj_swapped[k].bottomRows<6>() = J_body;
+      J_body.setZero(); getJacobian<true>(model,data,(Model::Index)model.nbody/2,J_body);
+      J_traj[k].bottomRows<6>() = J_body; J_traj_swapped[k].topRows<6>() = J_body;
+    }
+  }
+  timer.tic();
+  SMOOTH(NTRAJ)
+  {
+    forwardDynamics(model,data,qs_traj[_smooth],qdots[_smooth],qddots[_smooth],J_traj[_smooth],gamma_contacts);
+  }
+  std::cout << "forwardDynamics trajectory (same contacts) = \t"; timer.toc(std::cout,NTRAJ);
+
+  timer.tic();
+  SMOOTH(NTRAJ)
+  {
+    const MatrixXd & J_step = (_smooth%2) ? J_traj_swapped[_smooth] : J_traj[_smooth];
+    forwardDynamics(model,data,qs_traj[_smooth],qdots[_smooth],qddots[_smooth],J_step,gamma_contacts);
+  }
+  std::cout << "forwardDynamics trajectory (contacts swapped at each step) = \t"; timer.toc(std::cout,NTRAJ);
+
+  timer.tic();
+  SMOOTH(NBT)
+  {
+    forwardDynamicsRecursive(model,data,qs[_smooth],qdots[_smooth],qddots[_smooth],contacts,gamma_contacts);
+  }
+  std::cout << "forwardDynamicsRecursive (2 contacts) = \t"; timer.toc(std::cout,NBT);
  
   timer.tic();
   SMOOTH(NBT)
@@ -154,6 +387,23 @@ int main(int argc, const char ** argv)
   }
   std::cout << "Zero Order Kinematics = \t"; timer.toc(std::cout,NBT);
 
+  timer.tic();
+  SMOOTH(NBT)
+  {
+    forwardKinematics(model,data_soa,qs[_smooth]);
+  }
+  std::cout << "Zero Order Kinematics SoA = \t"; timer.toc(std::cout,NBT);
+
+  const Model::JointIndex last_joint = (Model::JointIndex)(model.nbody-1);
+  forwardKinematicsIncremental(model,data,qs[0]);
+  timer.tic();
+  SMOOTH(NBT)
+  {
+    qs[0][idx_q(model.joints[last_joint])] = qs[_smooth][0];
+    forwardKinematicsIncremental(model,data,qs[0]);
+  }
+  std::cout << "Zero Order Kinematics incremental (last joint moved) = \t"; timer.toc(std::cout,NBT);
+
 
   timer.tic();
   SMOOTH(NBT)
@@ -182,6 +432,49 @@ int main(int argc, const char ** argv)
     aba(model,data,qs[_smooth],qdots[_smooth], qddots[_smooth]);
   }
   std::cout << "ABA = \t"; timer.toc(std::cout,NBT);
+
+  timer.tic();
+  SMOOTH(NBT)
+  {
+    computeABADerivatives(model,data,qs[_smooth],qdots[_smooth],qddots[_smooth]);
+  }
+  std::cout << "ABA derivatives = \t"; timer.toc(std::cout,NBT);
+
+  MatrixXd ddq_dq_fd (model.nv,model.nv), ddq_dv_fd (model.nv,model.nv);
+  timer.tic();
+  SMOOTH(NBT/10)
+  {
+    const VectorXd ddq0 (aba(model,data,qs[_smooth],qdots[_smooth],qddots[_smooth]));
+    v_fd = qdots[_smooth];
+    for(int k=0;k<model.nv;++k)
+    {
+      dq_fd[k] = eps_fd;
+      ddq_dq_fd.col(k) = (aba(model,data,integrate(model,qs[_smooth],dq_fd),qdots[_smooth],qddots[_smooth]) - ddq0)/eps_fd;
+      dq_fd[k] = 0.;
+      v_fd[k] += eps_fd;
+      ddq_dv_fd.col(k) = (aba(model,data,qs[_smooth],v_fd,qddots[_smooth]) - ddq0)/eps_fd;
+      v_fd[k] = qdots[_smooth][k];
+    }
+  }
+  std::cout << "ABA finite differences (2 nv + 1 calls) = \t"; timer.toc(std::cout,NBT/10);
+
+  timer.tic();
+  SMOOTH(NBT)
+  {
+    computeMinverse(model,data,qs[_smooth]);
+  }
+  std::cout << "Minv = \t"; timer.toc(std::cout,NBT);
+
+  MatrixXd Minv_chol (model.nv,model.nv);
+  timer.tic();
+  SMOOTH(NBT)
+  {
+    crba(model,data,qs[_smooth]);
+    cholesky::decompose(model,data);
+    Minv_chol.setIdentity();
+    cholesky::solve(model,data,Minv_chol);
+  }
+  std::cout << "Minv via CRBA + Cholesky = \t"; timer.toc(std::cout,NBT);
   
   timer.tic();
   SMOOTH(NBT)
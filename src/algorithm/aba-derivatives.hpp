@@ -0,0 +1,87 @@
+//
+// Copyright (c) 2016 CNRS
+//
+// This file is part of Pinocchio
+// Pinocchio is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// Pinocchio is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Lesser Public License for more details. You should have
+// received a copy of the GNU Lesser General Public License along with
+// Pinocchio If not, see
+// <http://www.gnu.org/licenses/>.
+
+
+#ifndef __se3_aba_derivatives_hpp__
+#define __se3_aba_derivatives_hpp__
+
+#include "pinocchio/multibody/model.hpp"
+#include "pinocchio/algorithm/aba.hpp"
+#include "pinocchio/algorithm/rnea.hpp"
+#include "pinocchio/algorithm/rnea-derivatives.hpp"
+
+namespace se3
+{
+  ///
+  /// \brief Computes the partial derivatives of the Articulated-Body algorithm, i.e. of the joint accelerations
+  ///        \f$ \ddot{q}(q,\dot{q},\tau) \f$ with respect to the joint configuration, velocity and torque.
+  ///
+  /// \note The joint accelerations are given by \f$ \ddot{q} = M^{-1} (\tau - b(q,\dot{q})) \f$, \f$ b \f$ being evaluated by
+  ///       se3::nonLinearEffects, as se3::aba would give them. Differentiating \f$ M(q) \ddot{q} + b(q,\dot{q}) = \tau \f$ yields
+  ///       \f$ \frac{\partial \ddot{q}}{\partial q} = -M^{-1} \frac{\partial \tau}{\partial q} \f$,
+  ///       \f$ \frac{\partial \ddot{q}}{\partial \dot{q}} = -M^{-1} \frac{\partial \tau}{\partial \dot{q}} \f$ and
+  ///       \f$ \frac{\partial \ddot{q}}{\partial \tau} = M^{-1} \f$, the derivatives of \f$ \tau \f$ being evaluated by
+  ///       se3::computeRNEADerivatives at \f$ \ddot{q} \f$, and \f$ M^{-1} \f$ by se3::computeMinverse.
+  ///       The results are stored in data.ddq (the joint accelerations), data.ddq_dq, data.ddq_dv and data.Minv.
+  ///       The derivative with respect to q follows the convention of se3::computeRNEADerivatives.
+  ///
+  /// \warning The recursions (RNEA derivatives and \f$ M^{-1} \f$) cost O(nv^2), but the two dense products by
+  ///          \f$ M^{-1} \f$ cost O(nv^3) and dominate for large nv: the derivatives are not propagated through the ABA recursion.
+  ///
+  /// \param[in] model The model structure of the rigid body system.
+  /// \param[in] data The data structure of the rigid body system.
+  /// \param[in] q The joint configuration vector (dim model.nq).
+  /// \param[in] v The joint velocity vector (dim model.nv).
+  /// \param[in] tau The joint torque vector (dim model.nv).
+  ///
+  inline void
+  computeABADerivatives(const Model & model, Data & data,
+                        const Eigen::VectorXd & q,
+                        const Eigen::VectorXd & v,
+                        const Eigen::VectorXd & tau);
+
+} // namespace se3
+
+/* --- Details -------------------------------------------------------------------- */
+namespace se3
+{
+  inline void
+  computeABADerivatives(const Model & model, Data & data,
+                        const Eigen::VectorXd & q,
+                        const Eigen::VectorXd & v,
+                        const Eigen::VectorXd & tau)
+  {
+    assert(q.size() == model.nq);
+    assert(v.size() == model.nv);
+    assert(tau.size() == model.nv);
+
+    // The joint accelerations are obtained from Minv, without running the AB recursion a second time.
+    computeMinverse(model,data,q);
+    nonLinearEffects(model,data,q,v);
+    data.torque_residual = tau - data.nle;
+    data.ddq.noalias() = data.Minv*data.torque_residual;
+
+    // data.ddq is not modified by the RNEA derivatives, which also fill data.M.
+    computeRNEADerivatives(model,data,q,v,data.ddq);
+
+    data.ddq_dq.noalias() = -data.Minv*data.dtau_dq;
+    data.ddq_dv.noalias() = -data.Minv*data.dtau_dv;
+  }
+
+} // namespace se3
+
+#endif // ifndef __se3_aba_derivatives_hpp__
@@ -19,6 +19,7 @@
 #define __se3_aba_hpp__
 
 #include "pinocchio/multibody/model.hpp"
+#include "pinocchio/multibody/model-tpl.hpp"
 
 namespace se3
 {
@@ -40,6 +41,44 @@ namespace se3
       const Eigen::VectorXd & v,
       const Eigen::VectorXd & tau);
 
+  ///
+  /// \brief Computes the inverse of the joint space inertia matrix by a variant of the Articulated-Body algorithm.
+  ///
+  /// \note The columns of \f$ M^{-1} \f$ are the joint accelerations produced by unit joint torques, without velocity nor gravity.
+  ///       The backward pass of se3::aba is run on all these torques at once, the bias forces being stored as a 6 x nv force set
+  ///       (data.Fminv), then the forward pass propagates the corresponding 6 x nv sets of accelerations (data.Aminv).
+  ///       Only the upper triangular part is computed by the recursion, in O(nv^2) operations for a tree of bounded degree,
+  ///       and the lower triangular part is then copied from it.
+  ///
+  /// \param[in] model The model structure of the rigid body system.
+  /// \param[in] data The data structure of the rigid body system.
+  /// \param[in] q The joint configuration vector (dim model.nq).
+  ///
+  /// \return The inverse of the joint space inertia matrix stored in data.Minv.
+  ///
+  inline const Eigen::MatrixXd &
+  computeMinverse(const Model & model,
+                  Data & data,
+                  const Eigen::VectorXd & q);
+
+  ///
+  /// \brief The Articulated-Body algorithm, with an arbitrary scalar type (e.g. float).
+  ///
+  /// \param[in] model The model structure of the rigid body system, converted to Scalar.
+  /// \param[in] data The data structure of the rigid body system.
+  /// \param[in] q The joint configuration vector (dim model.nq).
+  /// \param[in] v The joint velocity vector (dim model.nv).
+  /// \param[in] tau The joint torque vector (dim model.nv).
+  ///
+  /// \return The current joint acceleration stored in data.ddq.
+  ///
+  template<typename Scalar>
+  inline const Eigen::Matrix<Scalar,Eigen::Dynamic,1> &
+  aba(const ModelTpl<Scalar> & model, DataTpl<Scalar> & data,
+      const Eigen::Matrix<Scalar,Eigen::Dynamic,1> & q,
+      const Eigen::Matrix<Scalar,Eigen::Dynamic,1> & v,
+      const Eigen::Matrix<Scalar,Eigen::Dynamic,1> & tau);
+
 } // namespace se3
 
 /* --- Details -------------------------------------------------------------------- */
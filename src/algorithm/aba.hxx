@@ -19,6 +19,7 @@
 #define __se3_aba_hxx__
 
 #include "pinocchio/multibody/visitor.hpp"
+#include "pinocchio/spatial/act-on-set.hpp"
 
 /// @cond DEV
 
@@ -217,6 +218,269 @@ namespace se3
     
     return data.ddq;
   }
+
+  struct ComputeMinverseForwardStep1 : public fusion::JointVisitor<ComputeMinverseForwardStep1>
+  {
+    typedef boost::fusion::vector<const se3::Model &,
+    se3::Data &,
+    const Eigen::VectorXd &
+    > ArgsType;
+    
+    JOINT_VISITOR_INIT(ComputeMinverseForwardStep1);
+    
+    template<typename JointModel>
+    static void algo(const se3::JointModelBase<JointModel> & jmodel,
+                     se3::JointDataBase<typename JointModel::JointData> & jdata,
+                     const se3::Model & model,
+                     se3::Data & data,
+                     const Eigen::VectorXd & q)
+    {
+      const Model::JointIndex & i = jmodel.id();
+      jmodel.calc(jdata.derived(),q);
+      
+      const Model::Index & parent = model.parents[i];
+      data.liMi[i] = model.jointPlacements[i] * jdata.M();
+      
+      if (parent>0)
+        data.oMi[i] = data.oMi[parent] * data.liMi[i];
+      else
+        data.oMi[i] = data.liMi[i];
+      
+      jmodel.jointCols(data.J) = data.oMi[i].act(jdata.S());
+      data.Yaba[i] = model.inertias[i].matrix();
+    }
+    
+  };
+  
+  struct ComputeMinverseBackwardStep : public fusion::JointVisitor<ComputeMinverseBackwardStep>
+  {
+    typedef boost::fusion::vector<const Model &,
+    Data &> ArgsType;
+    
+    JOINT_VISITOR_INIT(ComputeMinverseBackwardStep);
+    
+    template<typename JointModel>
+    static void algo(const JointModelBase<JointModel> & jmodel,
+                     JointDataBase<typename JointModel::JointData> & jdata,
+                     const Model & model,
+                     Data & data)
+    {
+      /*
+       * Minv[i,SUBTREE] = Dinv (I - J_i' F[1:6,SUBTREE])
+       * if li>0
+       *   F[1:6,SUBTREE] += oU_i Minv[i,SUBTREE]
+       *   Yli += liXi (Ia - U Dinv U')
+       */
+      typedef typename JointModel::U_t U_t;
+      const Model::JointIndex & i = jmodel.id();
+      const Model::Index & parent  = model.parents[i];
+      Inertia::Matrix6 & Ia = data.Yaba[i];
+      const int nv = jmodel.nv();
+      const int nv_subtree = data.nvSubtree[i];
+      
+      jmodel.calc_aba(jdata.derived(), Ia, parent > 0);
+      
+      Eigen::Block<Eigen::MatrixXd> Minv_i = data.Minv.block(jmodel.idx_v(),jmodel.idx_v(),nv,nv_subtree);
+      Minv_i.leftCols(nv) = jdata.Dinv();
+      if(nv_subtree > nv)
+      {
+        const Eigen::Matrix<double,JointModel::NV,6> DinvJt (jdata.Dinv() * jmodel.jointCols(data.J).transpose());
+        Minv_i.rightCols(nv_subtree-nv).noalias()
+        = -DinvJt * data.Fminv.middleCols(jmodel.idx_v()+nv,nv_subtree-nv);
+      }
+      
+      if (parent > 0)
+      {
+        U_t oU (jdata.U());
+        forceSet::se3Action(data.oMi[i],jdata.U(),oU);
+        data.Fminv.middleCols(jmodel.idx_v(),nv_subtree).noalias() += oU * Minv_i;
+        data.Yaba[parent] += AbaBackwardStep::SE3actOn(data.liMi[i], Ia);
+      }
+    }
+  };
+  
+  struct ComputeMinverseForwardStep2 : public fusion::JointVisitor<ComputeMinverseForwardStep2>
+  {
+    typedef boost::fusion::vector<const se3::Model &,
+    se3::Data &
+    > ArgsType;
+    
+    JOINT_VISITOR_INIT(ComputeMinverseForwardStep2);
+    
+    template<typename JointModel>
+    static void algo(const se3::JointModelBase<JointModel> & jmodel,
+                     se3::JointDataBase<typename JointModel::JointData> & jdata,
+                     const se3::Model & model,
+                     se3::Data & data)
+    {
+      /*
+       * if li>0
+       *   Minv[i,i:] -= (oUDinv_i)' A_li[1:6,i:]
+       * A_i[1:6,i:] = A_li[1:6,i:] + J_i Minv[i,i:]
+       */
+      typedef typename JointModel::UD_t UD_t;
+      const Model::JointIndex & i = jmodel.id();
+      const Model::Index & parent = model.parents[i];
+      const int ncols = model.nv - jmodel.idx_v();
+      
+      Eigen::Block<Eigen::MatrixXd> Minv_i = data.Minv.block(jmodel.idx_v(),jmodel.idx_v(),jmodel.nv(),ncols);
+      Data::Matrix6x::ColsBlockXpr A_i = data.Aminv[i].rightCols(ncols);
+      
+      if (parent > 0)
+      {
+        const Data::Matrix6x::ColsBlockXpr A_parent = data.Aminv[parent].rightCols(ncols);
+        UD_t oUDinv (jdata.UDinv());
+        forceSet::se3Action(data.oMi[i],jdata.UDinv(),oUDinv);
+        Minv_i.noalias() -= oUDinv.transpose() * A_parent;
+        A_i = A_parent;
+        A_i.noalias() += jmodel.jointCols(data.J) * Minv_i;
+      }
+      else
+        A_i.noalias() = jmodel.jointCols(data.J) * Minv_i;
+    }
+    
+  };
+  
+  inline const Eigen::MatrixXd &
+  computeMinverse(const Model & model,
+                  Data & data,
+                  const Eigen::VectorXd & q)
+  {
+    // The buffers are only sized by the first call, so that a Data which never computes Minv does not hold nv x nv matrices.
+    data.Minv.setZero(model.nv,model.nv);
+    data.Fminv.setZero(6,model.nv);
+    if(data.Aminv.size() != (std::size_t)model.nbody)
+      data.Aminv.assign((std::size_t)model.nbody,Data::Matrix6x(6,model.nv));
+    
+    for(Model::Index i=1;i<(Model::Index)model.nbody;++i)
+    {
+      ComputeMinverseForwardStep1::run(model.joints[i],data.joints[i],
+                                       ComputeMinverseForwardStep1::ArgsType(model,data,q));
+    }
+    
+    for( Model::Index i=(Model::Index)model.nbody-1;i>0;--i )
+    {
+      ComputeMinverseBackwardStep::run(model.joints[i],data.joints[i],
+                                       ComputeMinverseBackwardStep::ArgsType(model,data));
+    }
+    
+    for(Model::Index i=1;i<(Model::Index)model.nbody;++i)
+    {
+      ComputeMinverseForwardStep2::run(model.joints[i],data.joints[i],
+                                       ComputeMinverseForwardStep2::ArgsType(model,data));
+    }
+    
+    data.Minv.triangularView<Eigen::StrictlyLower>()
+    = data.Minv.transpose().triangularView<Eigen::StrictlyLower>();
+    return data.Minv;
+  }
+
+  namespace internal
+  {
+    ///
+    /// \brief Inverse of a small symmetric positive definite matrix, through its LDL^T factorization without pivoting.
+    ///
+    /// \note Contrary to Eigen's inverse, the sequence of operations does not depend on the values of A, which keeps
+    ///       the templated aba traceable by se3::codegen::TraceScalar.
+    ///
+    template<typename Scalar>
+    inline void inverseSymmetricPositive(const Eigen::Matrix<Scalar,Eigen::Dynamic,Eigen::Dynamic> & A,
+                                         Eigen::Matrix<Scalar,Eigen::Dynamic,Eigen::Dynamic> & Ainv)
+    {
+      typedef Eigen::Matrix<Scalar,Eigen::Dynamic,Eigen::Dynamic> MatrixXs;
+      const int n = (int)A.rows();
+      MatrixXs L (MatrixXs::Identity(n,n));
+      Eigen::Matrix<Scalar,Eigen::Dynamic,1> d (n);
+      for(int j=0;j<n;++j)
+      {
+        d[j] = A(j,j);
+        for(int k=0;k<j;++k) d[j] -= L(j,k)*L(j,k)*d[k];
+        for(int i=j+1;i<n;++i)
+        {
+          L(i,j) = A(i,j);
+          for(int k=0;k<j;++k) L(i,j) -= L(i,k)*L(j,k)*d[k];
+          L(i,j) /= d[j];
+        }
+      }
+
+      /* Ainv = L^{-T} D^{-1} L^{-1}, column by column. */
+      Ainv.resize(n,n);
+      for(int c=0;c<n;++c)
+      {
+        for(int i=0;i<n;++i)
+        {
+          Ainv(i,c) = (i==c) ? Scalar(1) : Scalar(0);
+          for(int k=0;k<i;++k) Ainv(i,c) -= L(i,k)*Ainv(k,c);
+        }
+        for(int i=0;i<n;++i) Ainv(i,c) /= d[i];
+        for(int i=n-1;i>=0;--i)
+          for(int k=i+1;k<n;++k) Ainv(i,c) -= L(k,i)*Ainv(k,c);
+      }
+    }
+  } // namespace internal
+
+  template<typename Scalar>
+  inline const Eigen::Matrix<Scalar,Eigen::Dynamic,1> &
+  aba(const ModelTpl<Scalar> & model, DataTpl<Scalar> & data,
+      const Eigen::Matrix<Scalar,Eigen::Dynamic,1> & q,
+      const Eigen::Matrix<Scalar,Eigen::Dynamic,1> & v,
+      const Eigen::Matrix<Scalar,Eigen::Dynamic,1> & tau)
+  {
+    typedef typename ModelTpl<Scalar>::JointIndex JointIndex;
+    typedef typename DataTpl<Scalar>::Motion Motion;
+    typedef typename DataTpl<Scalar>::Force Force;
+    typedef typename DataTpl<Scalar>::Matrix6 Matrix6;
+    assert(q.size() == model.nq);
+    assert(v.size() == model.nv);
+    assert(tau.size() == model.nv);
+
+    data.v[0].setZero();
+    data.a[0] = -model.gravity;
+
+    for( JointIndex i=1;i<(JointIndex)model.nbody;++i )
+    {
+      const JointIndex & parent = model.parents[i];
+      const Motion vJ (model.S[i] * v.segment(model.idx_vs[i],model.nvs[i]));
+
+      data.liMi[i] = model.jointPlacements[i] * jointTransform(model,i,q);
+      data.v[i] = vJ;
+      if(parent>0) data.v[i] += data.liMi[i].actInv(data.v[parent]);
+
+      data.c[i] = data.v[i] ^ vJ;
+      data.Yaba[i] = model.inertias[i].matrix();
+      data.f[i] = model.inertias[i].vxiv(data.v[i]); // -f_ext
+    }
+
+    for( JointIndex i=(JointIndex)model.nbody-1;i>0;--i )
+    {
+      const JointIndex & parent = model.parents[i];
+      data.U[i] = data.Yaba[i] * model.S[i];
+      internal::inverseSymmetricPositive(typename DataTpl<Scalar>::MatrixXs(model.S[i].transpose() * data.U[i]),data.Dinv[i]);
+      data.u[i] = tau.segment(model.idx_vs[i],model.nvs[i]) - model.S[i].transpose() * data.f[i].toVector();
+
+      if(parent>0)
+      {
+        const Matrix6 Ia (data.Yaba[i] - data.U[i] * data.Dinv[i] * data.U[i].transpose());
+        const Force pa (data.f[i].toVector() + Ia * data.c[i].toVector() + data.U[i] * (data.Dinv[i] * data.u[i]));
+        const Matrix6 X (data.liMi[i].inverse().toActionMatrix());
+        data.Yaba[parent] += X.transpose() * Ia * X;
+        data.f[parent] += data.liMi[i].act(pa);
+      }
+    }
+
+    for( JointIndex i=1;i<(JointIndex)model.nbody;++i )
+    {
+      const JointIndex & parent = model.parents[i];
+      const int idx_v = model.idx_vs[i], nv = model.nvs[i];
+
+      data.a[i] = data.liMi[i].actInv(data.a[parent]) + data.c[i];
+      data.ddq.segment(idx_v,nv) = data.Dinv[i] * (data.u[i] - data.U[i].transpose() * data.a[i].toVector());
+      data.a[i] += Motion(model.S[i] * data.ddq.segment(idx_v,nv));
+    }
+
+    return data.ddq;
+  }
+
 } // namespace se3
 
 /// @endcond
@@ -131,6 +131,21 @@ namespace se3
   inline const Data::Matrix3x &
   getJacobianComFromCrba(const Model & model, Data & data);
   
+  ///
+  /// \brief Computes the center of mass position of the system, with an arbitrary scalar type.
+  ///        The result is accessible through data.com, and the total mass through data.mass.
+  ///
+  /// \param[in] model The model structure of the rigid body system, converted to Scalar.
+  /// \param[in] data The data structure of the rigid body system.
+  /// \param[in] q The joint configuration vector (dim model.nq).
+  ///
+  /// \return The center of mass position of the full rigid body system expressed in the world frame.
+  ///
+  template<typename Scalar>
+  inline const Eigen::Matrix<Scalar,3,1> &
+  centerOfMass(const ModelTpl<Scalar> & model, DataTpl<Scalar> & data,
+               const Eigen::Matrix<Scalar,Eigen::Dynamic,1> & q);
+
 } // namespace se3 
 
 /* --- Details -------------------------------------------------------------------- */
@@ -318,6 +318,28 @@ namespace se3
     return data.Jcom;
   }
 
+  template<typename Scalar>
+  inline const Eigen::Matrix<Scalar,3,1> &
+  centerOfMass(const ModelTpl<Scalar> & model, DataTpl<Scalar> & data,
+               const Eigen::Matrix<Scalar,Eigen::Dynamic,1> & q)
+  {
+    typedef typename ModelTpl<Scalar>::JointIndex JointIndex;
+
+    forwardKinematics(model, data, q);
+
+    data.com.setZero();
+    data.mass = Scalar(0);
+    for(JointIndex i=1;i<(JointIndex)model.nbody;++i)
+    {
+      const Scalar & mass = model.inertias[i].mass();
+      data.mass += mass;
+      data.com += mass * data.oMi[i].act(model.inertias[i].lever());
+    }
+    data.com /= data.mass;
+
+    return data.com;
+  }
+
 } // namespace se3
 
 /// @endcond
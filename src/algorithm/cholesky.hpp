@@ -151,6 +151,85 @@ namespace se3
                 const Data & data ,
                 Eigen::MatrixBase<Mat> & v);
 
+    ///
+    /// \brief Compute the Cholesky decomposition \f$ M = U D U^{\top}\f$ of the joint space inertia matrix stored in data.Msparse
+    ///        (see se3::crbaSparse), in the branch-induced sparse format.
+    ///
+    /// \note The factorization follows the LTDL algorithm (Table 6.3, Rigid-Body Dynamics Algorithms, R. Featherstone, 2008):
+    ///       the sparsity pattern of U is the one of M, so no fill-in occurs. The result is stored in data.Usparse, whose
+    ///       diagonal contains D. D is also copied in data.D.
+    ///
+    /// \param[in] model The model structure of the rigid body system.
+    /// \param[in] data The data structure of the rigid body system.
+    ///
+    /// \return A reference to the factor stored in data.Usparse.
+    ///
+    inline const BranchSparseMatrix &
+    decomposeSparse(const Model & model,
+                    Data & data);
+
+    ///
+    /// \brief Perform the multiplication \f$ U v \f$ in place, using the sparse factor stored in data.Usparse.
+    ///
+    template<typename Mat>
+    Mat & UvSparse(const Model & model,
+                   const Data & data,
+                   Eigen::MatrixBase<Mat> & v);
+
+    ///
+    /// \brief Perform the multiplication \f$ U^{\top} v \f$ in place, using the sparse factor stored in data.Usparse.
+    ///
+    template<typename Mat>
+    Mat & UtvSparse(const Model & model,
+                    const Data & data,
+                    Eigen::MatrixBase<Mat> & v);
+
+    ///
+    /// \brief Perform the inversion \f$ U^{-1} v \f$ in place, using the sparse factor stored in data.Usparse.
+    ///
+    template<typename Mat>
+    Mat & UivSparse(const Model & model,
+                    const Data & data,
+                    Eigen::MatrixBase<Mat> & v);
+
+    ///
+    /// \brief Perform the inversion \f$ U^{-\top} v \f$ in place, using the sparse factor stored in data.Usparse.
+    ///
+    template<typename Mat>
+    Mat & UtivSparse(const Model & model,
+                     const Data & data,
+                     Eigen::MatrixBase<Mat> & v);
+
+    ///
+    /// \brief Perform the multiplication \f$ M v \f$ in place, either from data.Msparse or from its Cholesky decomposition data.Usparse.
+    ///
+    /// \param[in] model The model structure of the rigid body system.
+    /// \param[in] data The data structure of the rigid body system.
+    /// \param[inout] v The input matrix to multiply with M and storing the result.
+    /// \param[in] usingCholesky If true, use the Cholesky decomposition stored in data.Usparse.
+    ///
+    /// \return A reference to the result of \f$ Mv \f$.
+    ///
+    template<typename Mat>
+    Mat & MvSparse(const Model & model,
+                   const Data & data,
+                   Eigen::MatrixBase<Mat> & v,
+                   const bool usingCholesky = false);
+
+    ///
+    /// \brief Perform the inversion \f$ M^{-1} v \f$ in place, using the sparse Cholesky decomposition stored in data.Usparse.
+    ///
+    /// \param[in] model The model structure of the rigid body system.
+    /// \param[in] data The data structure of the rigid body system.
+    /// \param[inout] v The input matrix to multiply with M^{-1} and also storing the result.
+    ///
+    /// \return A reference to the result of \f$ M^{-1}v \f$ stored in v.
+    ///
+    template<typename Mat>
+    Mat & solveSparse(const Model & model,
+                      const Data & data,
+                      Eigen::MatrixBase<Mat> & v);
+
   } // namespace cholesky  
 } // namespace se3 
 
@@ -77,7 +77,7 @@ namespace se3
       const std::vector<int> & nvt = data.nvSubtree_fromRow;
       
       for(int k=0;k < model.nv-1;++k) // You can stop one step before nv
-        v.row(k) += U.row(k).segment(k+1,nvt[(Model::Index)k]-1) * v.middleRows(k+1,nvt[(Model::Index)k]-1);
+        v.row(k).noalias() += U.row(k).segment(k+1,nvt[(Model::Index)k]-1) * v.middleRows(k+1,nvt[(Model::Index)k]-1);
       
       return v.derived();
     }
@@ -93,7 +93,7 @@ namespace se3
       const Eigen::MatrixXd & U = data.U;
       const std::vector<int> & nvt = data.nvSubtree_fromRow;
       for( int k=model.nv-2;k>=0;--k ) // You can start from nv-2 (no child in nv-1)
-        v.middleRows(k+1,nvt[(Model::Index)k]-1) += U.row(k).segment(k+1,nvt[(Model::Index)k]-1).transpose()*v.row(k);
+        v.middleRows(k+1,nvt[(Model::Index)k]-1).noalias() += U.row(k).segment(k+1,nvt[(Model::Index)k]-1).transpose()*v.row(k);
       
       return v.derived();
     }
@@ -114,7 +114,7 @@ namespace se3
       const std::vector<int> & nvt = data.nvSubtree_fromRow;
       
       for( int k=model.nv-2;k>=0;--k ) // You can start from nv-2 (no child in nv-1)
-        v.row(k) -= U.row(k).segment(k+1,nvt[(Model::Index)k]-1) * v.middleRows(k+1,nvt[(Model::Index)k]-1);
+        v.row(k).noalias() -= U.row(k).segment(k+1,nvt[(Model::Index)k]-1) * v.middleRows(k+1,nvt[(Model::Index)k]-1);
       return v.derived();
     }
 
@@ -130,7 +130,7 @@ namespace se3
       const Eigen::MatrixXd & U = data.U;
       const std::vector<int> & nvt = data.nvSubtree_fromRow;
       for( int k=0;k<model.nv-1;++k ) // You can stop one step before nv.
-        v.middleRows(k+1,nvt[(Model::Index)k]-1) -= U.row(k).segment(k+1,nvt[(Model::Index)k]-1).transpose()*v.row(k);
+        v.middleRows(k+1,nvt[(Model::Index)k]-1).noalias() -= U.row(k).segment(k+1,nvt[(Model::Index)k]-1).transpose()*v.row(k);
 
       return v.derived();
     }
@@ -188,6 +188,163 @@ namespace se3
       return Utiv(model,data,v);
     }
 
+    inline const BranchSparseMatrix &
+    decomposeSparse(const Model & model,
+                    Data & data)
+    {
+      /*
+       *    U = M;
+       *    for k=n:-1:1
+       *      i=parent(k);
+       *      while i>0
+       *          a = U(i,k) / U(k,k);
+       *          U(CHAIN(i),i) -= a * U(CHAIN(i),k);
+       *          U(i,k) = a;
+       *          i=parent(i);
+       *      end
+       *    end
+       */
+      assert(data.Msparse.size() == model.nv);
+
+      BranchSparseMatrix & U = data.Usparse;
+      U.values = data.Msparse.values;
+
+      for(int k=model.nv-1;k>=0;--k)
+      {
+        BranchSparseMatrix::ChainXpr Uk = U.chain(k);
+        const double Dk = Uk[U.depth[(std::size_t)k]];
+
+        for(int i=U.parents[(std::size_t)k];i>=0;i=U.parents[(std::size_t)i])
+        {
+          const int di = U.depth[(std::size_t)i];
+          const double a = Uk[di] / Dk;
+          U.chain(i) -= a * Uk.head(di+1);
+          Uk[di] = a;
+        }
+        data.D[k] = Dk;
+      }
+
+      return data.Usparse;
+    }
+
+    template<typename Mat>
+    Mat & UvSparse(const Model & model,
+                   const Data & data,
+                   Eigen::MatrixBase<Mat> & v)
+    {
+      assert(v.rows() == model.nv);
+
+      const BranchSparseMatrix & U = data.Usparse;
+      for(int k=1;k<model.nv;++k)
+        for(int i=U.parents[(std::size_t)k];i>=0;i=U.parents[(std::size_t)i])
+          v.row(i) += U(i,k) * v.row(k);
+
+      return v.derived();
+    }
+
+    template<typename Mat>
+    Mat & UtvSparse(const Model & model,
+                    const Data & data,
+                    Eigen::MatrixBase<Mat> & v)
+    {
+      assert(v.rows() == model.nv);
+
+      const BranchSparseMatrix & U = data.Usparse;
+      for(int k=model.nv-1;k>0;--k)
+        for(int i=U.parents[(std::size_t)k];i>=0;i=U.parents[(std::size_t)i])
+          v.row(k) += U(i,k) * v.row(i);
+
+      return v.derived();
+    }
+
+    template<typename Mat>
+    Mat & UivSparse(const Model & model,
+                    const Data & data,
+                    Eigen::MatrixBase<Mat> & v)
+    {
+      /* We search y s.t. v = U y: y_k is final once all the dofs supported by k have been processed. */
+      assert(v.rows() == model.nv);
+
+      const BranchSparseMatrix & U = data.Usparse;
+      for(int k=model.nv-1;k>0;--k)
+        for(int i=U.parents[(std::size_t)k];i>=0;i=U.parents[(std::size_t)i])
+          v.row(i) -= U(i,k) * v.row(k);
+
+      return v.derived();
+    }
+
+    template<typename Mat>
+    Mat & UtivSparse(const Model & model,
+                     const Data & data,
+                     Eigen::MatrixBase<Mat> & v)
+    {
+      /* We search y s.t. v = U' y: y_k only depends on the dofs supporting k. */
+      assert(v.rows() == model.nv);
+
+      const BranchSparseMatrix & U = data.Usparse;
+      for(int k=1;k<model.nv;++k)
+        for(int i=U.parents[(std::size_t)k];i>=0;i=U.parents[(std::size_t)i])
+          v.row(k) -= U(i,k) * v.row(i);
+
+      return v.derived();
+    }
+
+    namespace internal
+    {
+      template<typename Mat>
+      Mat MvSparse(const Model & model,
+                   const Data & data,
+                   const Eigen::MatrixBase<Mat> & v)
+      {
+        assert(v.rows() == model.nv);
+
+        const BranchSparseMatrix & M = data.Msparse;
+        Mat res(v.rows(),v.cols());
+
+        for(int k=0;k<model.nv;++k)
+        {
+          res.row(k) = M(k,k) * v.row(k);
+          for(int i=M.parents[(std::size_t)k];i>=0;i=M.parents[(std::size_t)i])
+          {
+            res.row(k) += M(i,k) * v.row(i);
+            res.row(i) += M(i,k) * v.row(k);
+          }
+        }
+
+        return res;
+      }
+
+      template<typename Mat>
+      Mat & UDUtvSparse(const Model & model,
+                        const Data & data,
+                        Eigen::MatrixBase<Mat> & v)
+      {
+        UtvSparse(model,data,v);
+        for( int k=0;k<model.nv;++k ) v.row(k) *= data.D[k];
+        return UvSparse(model,data,v);
+      }
+    } // internal
+
+    template<typename Mat>
+    Mat & MvSparse(const Model & model,
+                   const Data & data,
+                   Eigen::MatrixBase<Mat> & v,
+                   const bool usingCholesky)
+    {
+      if(usingCholesky) return internal::UDUtvSparse(model,data,v);
+      else return v = internal::MvSparse(model,data,v);
+    }
+
+    template<typename Mat>
+    Mat & solveSparse(const Model & model,
+                      const Data & data,
+                      Eigen::MatrixBase<Mat> & v)
+    {
+      UivSparse(model,data,v);
+      for(int k=0;k<model.nv;++k) v.row(k) /= data.D[k];
+      return UtivSparse(model,data,v);
+    }
+
   } //   namespace cholesky
 } // namespace se3
 
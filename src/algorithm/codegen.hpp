@@ -0,0 +1,659 @@
+//
+// Copyright (c) 2016 CNRS
+//
+// This file is part of Pinocchio
+// Pinocchio is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// Pinocchio is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Lesser Public License for more details. You should have
+// received a copy of the GNU Lesser General Public License along with
+// Pinocchio If not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef __se3_codegen_hpp__
+#define __se3_codegen_hpp__
+
+#include "pinocchio/multibody/model.hpp"
+#include "pinocchio/multibody/model-tpl.hpp"
+#include "pinocchio/algorithm/kinematics.hpp"
+#include "pinocchio/algorithm/rnea.hpp"
+#include "pinocchio/algorithm/aba.hpp"
+#include "pinocchio/algorithm/operational-frames.hpp"
+
+#include <cmath>
+#include <cctype>
+#include <map>
+#include <ostream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+namespace se3
+{
+  namespace codegen
+  {
+    ///
+    /// \brief One operation recorded on a se3::codegen::Tape.
+    ///
+    struct Instruction
+    {
+      enum Operation { INPUT, CONSTANT, NEG, ADD, SUB, MUL, DIV, SQRT, SIN, COS, ABS };
+
+      Operation op;
+      /// \brief Indexes of the operands in the tape (-1 if unused).
+      int lhs, rhs;
+      /// \brief Value of the operation for the inputs of the last trace (or replay).
+      double value;
+      /// \brief Name of the input (e.g. "q[3]"), for INPUT only.
+      std::string name;
+    };
+
+    class TraceScalar;
+
+    ///
+    /// \brief Record of the arithmetic operations performed on se3::codegen::TraceScalar, in execution order.
+    ///
+    /// \note Identical operations on identical operands are recorded once, so that the tape is free of common
+    ///       subexpressions. The operations are recorded on the active tape, set by Tape::activate (one at a time).
+    ///
+    class Tape
+    {
+    public:
+      Tape() {}
+      ~Tape() { deactivate(); }
+
+      /// \brief Record the operations performed on TraceScalar on this tape.
+      void activate() { current() = this; }
+      void deactivate() { if(current() == this) current() = NULL; }
+      static Tape * active() { return current(); }
+
+      /// \brief Create a new input of the traced function, named name and valued value during the trace.
+      inline TraceScalar input(const std::string & name, const double value);
+
+      /// \brief Record an operation and return its index (or the index of the same operation, already recorded).
+      inline int push(const Instruction::Operation op, const int lhs, const int rhs, const double value);
+
+      /// \brief Index of the constant value in the tape.
+      inline int constant(const double value);
+
+      /// \brief Re-evaluate all the operations for new values of the inputs (in the order of their creation).
+      inline void replay(const std::vector<double> & inputs);
+
+      /// \brief Value of x for the inputs of the last trace or replay.
+      inline double value(const TraceScalar & x) const;
+
+      const std::vector<Instruction> & instructions() const { return m_instructions; }
+      std::size_t size() const { return m_instructions.size(); }
+
+    private:
+      static Tape * & current() { static Tape * tape = NULL; return tape; }
+
+      std::vector<Instruction> m_instructions;
+      std::map< std::pair<int,std::pair<int,int> >, int> m_operations;
+      std::map<double,int> m_constants;
+    };
+
+    ///
+    /// \brief Scalar type recording on the active se3::codegen::Tape the operations it takes part in.
+    ///
+    /// \note A TraceScalar is either a constant, known when tracing (e.g. the entries of the joint placements
+    ///       and of the inertias), or a variable depending on the inputs. Operations on constants are folded, and the
+    ///       operations with an absorbing or neutral constant (0 or 1) are simplified, so that only the arithmetic
+    ///       depending on the inputs is recorded. Each TraceScalar also holds its value for the inputs of the trace,
+    ///       used by the comparison operators: the traced algorithm must not branch on the inputs.
+    ///
+    class TraceScalar
+    {
+    public:
+      TraceScalar() : id(-1), value(0.) {}
+      TraceScalar(const double value) : id(-1), value(value) {}
+
+      static TraceScalar variable(const int id, const double value)
+      { TraceScalar res(value); res.id = id; return res; }
+
+      bool isConstant() const { return id < 0; }
+      bool isConstant(const double c) const { return id < 0 && value == c; }
+
+      inline TraceScalar & operator+=(const TraceScalar & other);
+      inline TraceScalar & operator-=(const TraceScalar & other);
+      inline TraceScalar & operator*=(const TraceScalar & other);
+      inline TraceScalar & operator/=(const TraceScalar & other);
+
+      /// \brief Index of the variable in the active tape, -1 for a constant.
+      int id;
+      /// \brief Value for the inputs of the trace.
+      double value;
+    };
+
+    namespace internal
+    {
+      inline TraceScalar record(const Instruction::Operation op, const TraceScalar & lhs, const TraceScalar & rhs,
+                                const double value)
+      {
+        Tape * tape = Tape::active();
+        assert(tape != NULL && "No active tape");
+        const int l = lhs.isConstant() ? tape->constant(lhs.value) : lhs.id;
+        const int r = rhs.isConstant() ? tape->constant(rhs.value) : rhs.id;
+        return TraceScalar::variable(tape->push(op,l,r,value),value);
+      }
+
+      inline TraceScalar record(const Instruction::Operation op, const TraceScalar & x, const double value)
+      {
+        Tape * tape = Tape::active();
+        assert(tape != NULL && "No active tape");
+        return TraceScalar::variable(tape->push(op,x.id,-1,value),value);
+      }
+    } // namespace internal
+
+    inline TraceScalar operator-(const TraceScalar & x)
+    {
+      if(x.isConstant()) return TraceScalar(-x.value);
+      const Tape * tape = Tape::active();
+      if(tape != NULL && tape->instructions()[(std::size_t)x.id].op == Instruction::NEG)
+        return TraceScalar::variable(tape->instructions()[(std::size_t)x.id].lhs,-x.value);
+      return internal::record(Instruction::NEG,x,-x.value);
+    }
+
+    inline TraceScalar operator+(const TraceScalar & x) { return x; }
+
+    inline TraceScalar operator+(const TraceScalar & a, const TraceScalar & b)
+    {
+      if(a.isConstant() && b.isConstant()) return TraceScalar(a.value + b.value);
+      if(a.isConstant(0.)) return b;
+      if(b.isConstant(0.)) return a;
+      return internal::record(Instruction::ADD,a,b,a.value + b.value);
+    }
+
+    inline TraceScalar operator-(const TraceScalar & a, const TraceScalar & b)
+    {
+      if(a.isConstant() && b.isConstant()) return TraceScalar(a.value - b.value);
+      if(a.isConstant(0.)) return -b;
+      if(b.isConstant(0.)) return a;
+      return internal::record(Instruction::SUB,a,b,a.value - b.value);
+    }
+
+    inline TraceScalar operator*(const TraceScalar & a, const TraceScalar & b)
+    {
+      if(a.isConstant() && b.isConstant()) return TraceScalar(a.value * b.value);
+      if(a.isConstant(0.) || b.isConstant(0.)) return TraceScalar(0.);
+      if(a.isConstant(1.)) return b;
+      if(b.isConstant(1.)) return a;
+      if(a.isConstant(-1.)) return -b;
+      if(b.isConstant(-1.)) return -a;
+      return internal::record(Instruction::MUL,a,b,a.value * b.value);
+    }
+
+    inline TraceScalar operator/(const TraceScalar & a, const TraceScalar & b)
+    {
+      if(a.isConstant() && b.isConstant()) return TraceScalar(a.value / b.value);
+      if(a.isConstant(0.)) return TraceScalar(0.);
+      if(b.isConstant(1.)) return a;
+      if(b.isConstant(-1.)) return -a;
+      return internal::record(Instruction::DIV,a,b,a.value / b.value);
+    }
+
+    inline TraceScalar & TraceScalar::operator+=(const TraceScalar & other) { return *this = *this + other; }
+    inline TraceScalar & TraceScalar::operator-=(const TraceScalar & other) { return *this = *this - other; }
+    inline TraceScalar & TraceScalar::operator*=(const TraceScalar & other) { return *this = *this * other; }
+    inline TraceScalar & TraceScalar::operator/=(const TraceScalar & other) { return *this = *this / other; }
+
+    inline bool operator==(const TraceScalar & a, const TraceScalar & b) { return a.value == b.value; }
+    inline bool operator!=(const TraceScalar & a, const TraceScalar & b) { return a.value != b.value; }
+    inline bool operator< (const TraceScalar & a, const TraceScalar & b) { return a.value <  b.value; }
+    inline bool operator<=(const TraceScalar & a, const TraceScalar & b) { return a.value <= b.value; }
+    inline bool operator> (const TraceScalar & a, const TraceScalar & b) { return a.value >  b.value; }
+    inline bool operator>=(const TraceScalar & a, const TraceScalar & b) { return a.value >= b.value; }
+
+    inline TraceScalar sqrt(const TraceScalar & x)
+    {
+      if(x.isConstant()) return TraceScalar(std::sqrt(x.value));
+      return internal::record(Instruction::SQRT,x,std::sqrt(x.value));
+    }
+
+    inline TraceScalar sin(const TraceScalar & x)
+    {
+      if(x.isConstant()) return TraceScalar(std::sin(x.value));
+      return internal::record(Instruction::SIN,x,std::sin(x.value));
+    }
+
+    inline TraceScalar cos(const TraceScalar & x)
+    {
+      if(x.isConstant()) return TraceScalar(std::cos(x.value));
+      return internal::record(Instruction::COS,x,std::cos(x.value));
+    }
+
+    inline TraceScalar abs(const TraceScalar & x)
+    {
+      if(x.isConstant()) return TraceScalar(std::fabs(x.value));
+      return internal::record(Instruction::ABS,x,std::fabs(x.value));
+    }
+
+    inline TraceScalar fabs(const TraceScalar & x) { return abs(x); }
+    inline TraceScalar abs2(const TraceScalar & x) { return x*x; }
+    inline const TraceScalar & conj(const TraceScalar & x) { return x; }
+    inline const TraceScalar & real(const TraceScalar & x) { return x; }
+    inline TraceScalar imag(const TraceScalar &) { return TraceScalar(0.); }
+
+    inline TraceScalar Tape::input(const std::string & name, const double value)
+    {
+      Instruction instruction;
+      instruction.op = Instruction::INPUT; instruction.lhs = instruction.rhs = -1;
+      instruction.value = value; instruction.name = name;
+      m_instructions.push_back(instruction);
+      return TraceScalar::variable((int)m_instructions.size()-1,value);
+    }
+
+    inline int Tape::push(const Instruction::Operation op, const int lhs, const int rhs, const double value)
+    {
+      const bool commutative = (op == Instruction::ADD || op == Instruction::MUL);
+      const std::pair<int,std::pair<int,int> > key (op,(commutative && rhs < lhs) ? std::make_pair(rhs,lhs)
+                                                                                   : std::make_pair(lhs,rhs));
+      std::map< std::pair<int,std::pair<int,int> >, int>::const_iterator it = m_operations.find(key);
+      if(it != m_operations.end()) return it->second;
+
+      Instruction instruction;
+      instruction.op = op; instruction.lhs = key.second.first; instruction.rhs = key.second.second;
+      instruction.value = value;
+      m_instructions.push_back(instruction);
+      const int id = (int)m_instructions.size()-1;
+      m_operations[key] = id;
+      return id;
+    }
+
+    inline int Tape::constant(const double value)
+    {
+      std::map<double,int>::const_iterator it = m_constants.find(value);
+      if(it != m_constants.end()) return it->second;
+
+      Instruction instruction;
+      instruction.op = Instruction::CONSTANT; instruction.lhs = instruction.rhs = -1;
+      instruction.value = value;
+      m_instructions.push_back(instruction);
+      const int id = (int)m_instructions.size()-1;
+      m_constants[value] = id;
+      return id;
+    }
+
+    inline void Tape::replay(const std::vector<double> & inputs)
+    {
+      std::size_t k = 0;
+      for(std::vector<Instruction>::iterator it = m_instructions.begin(); it != m_instructions.end(); ++it)
+      {
+        const double l = (it->lhs >= 0) ? m_instructions[(std::size_t)it->lhs].value : 0.;
+        const double r = (it->rhs >= 0) ? m_instructions[(std::size_t)it->rhs].value : 0.;
+        switch(it->op)
+        {
+          case Instruction::INPUT: assert(k < inputs.size()); it->value = inputs[k++]; break;
+          case Instruction::CONSTANT: break;
+          case Instruction::NEG: it->value = -l; break;
+          case Instruction::ADD: it->value = l + r; break;
+          case Instruction::SUB: it->value = l - r; break;
+          case Instruction::MUL: it->value = l * r; break;
+          case Instruction::DIV: it->value = l / r; break;
+          case Instruction::SQRT: it->value = std::sqrt(l); break;
+          case Instruction::SIN: it->value = std::sin(l); break;
+          case Instruction::COS: it->value = std::cos(l); break;
+          case Instruction::ABS: it->value = std::fabs(l); break;
+        }
+      }
+      assert(k == inputs.size());
+    }
+
+    inline double Tape::value(const TraceScalar & x) const
+    {
+      return x.isConstant() ? x.value : m_instructions[(std::size_t)x.id].value;
+    }
+
+    ///
+    /// \brief A function of a model traced on a se3::codegen::Tape: double arrays as inputs, one double array as output.
+    ///
+    struct Kernel
+    {
+      /// \brief Name of the function (e.g. "rnea"), prefixed by the name of the model in the generated code.
+      std::string name;
+
+      /// \brief Names and sizes of the input arrays, in the order of the arguments (and of the tape inputs).
+      std::vector<std::string> input_names;
+      std::vector<int> input_sizes;
+
+      /// \brief Name of the output array, and its traced entries.
+      std::string output_name;
+      std::vector<TraceScalar> outputs;
+
+      Tape tape;
+    };
+
+    ///
+    /// \brief Trace forwardKinematics: input q, output oMi of size 12 * model.nbody, holding for each joint
+    ///        (universe included) its rotation (column major) followed by its translation.
+    ///
+    inline void traceForwardKinematics(const ModelTpl<TraceScalar> & model, Kernel & kernel);
+
+    ///
+    /// \brief Trace rnea: inputs q, v and a, output tau.
+    ///
+    inline void traceRnea(const ModelTpl<TraceScalar> & model, Kernel & kernel);
+
+    ///
+    /// \brief Trace aba: inputs q, v and tau, output ddq.
+    ///
+    inline void traceAba(const ModelTpl<TraceScalar> & model, Kernel & kernel);
+
+    ///
+    /// \brief Trace the Jacobians of the operational frames, expressed in the local frames: input q, output J
+    ///        of size 6 * model.nv * model.nOperationalFrames, holding the Jacobians (column major) one after the other.
+    ///
+    inline void traceFrameJacobians(const ModelTpl<TraceScalar> & model, Kernel & kernel);
+
+    ///
+    /// \brief Write the C definition of a traced kernel, named prefix_<kernel.name>.
+    ///
+    /// \note The body is straight-line code: one const double per recorded operation the outputs depend on,
+    ///       the constants being written as literals. It needs no allocation and only depends on <math.h>.
+    ///
+    inline void writeKernel(const std::string & prefix, const Kernel & kernel, std::ostream & os);
+
+    ///
+    /// \brief Write the C prototype of a traced kernel, named prefix_<kernel.name>.
+    ///
+    inline void writeKernelDeclaration(const std::string & prefix, const Kernel & kernel, std::ostream & os);
+
+  } // namespace codegen
+
+  ///
+  /// \brief Generate the C code of the kernels forward_kinematics, rnea, aba and frame_jacobians for one given model.
+  ///
+  /// \note The kernels are traced from the templated algorithms with the scalar type se3::codegen::TraceScalar,
+  ///       which folds the joint placements, the inertias and the joint axes of model into the arithmetic. They are
+  ///       thus only valid for this model. Their prototypes, e.g.
+  ///       void prefix_rnea(const double * q, const double * v, const double * a, double * tau),
+  ///       are declared in the header, and defined in the source which includes it as "prefix.h".
+  ///       The joints SphericalZYX and Dense are not supported (see se3::ModelTpl).
+  ///
+  /// \param[in] model The model structure of the rigid body system.
+  /// \param[in] prefix The prefix of the kernels, which must be a valid C identifier.
+  /// \param[out] header The stream where the C header is written.
+  /// \param[out] source The stream where the C source is written.
+  ///
+  inline void generateCode(const Model & model,
+                           const std::string & prefix,
+                           std::ostream & header,
+                           std::ostream & source);
+
+} // namespace se3
+
+namespace Eigen
+{
+  template<> struct NumTraits<se3::codegen::TraceScalar> : NumTraits<double>
+  {
+    typedef se3::codegen::TraceScalar Real;
+    typedef se3::codegen::TraceScalar NonInteger;
+    typedef se3::codegen::TraceScalar Nested;
+    typedef se3::codegen::TraceScalar Literal;
+
+    enum
+    {
+      IsComplex = 0,
+      IsInteger = 0,
+      IsSigned = 1,
+      RequireInitialization = 1,
+      ReadCost = 1,
+      AddCost = 1,
+      MulCost = 1
+    };
+  };
+} // namespace Eigen
+
+/* --- Details -------------------------------------------------------------------- */
+namespace se3
+{
+  namespace codegen
+  {
+    namespace internal
+    {
+      typedef Eigen::Matrix<TraceScalar,Eigen::Dynamic,1> VectorXt;
+
+      /// \brief Add an input array to the kernel, traced with the given sample values.
+      inline VectorXt traceInput(Kernel & kernel, const std::string & name, const Eigen::VectorXd & sample)
+      {
+        kernel.input_names.push_back(name);
+        kernel.input_sizes.push_back((int)sample.size());
+        VectorXt res (sample.size());
+        for(int k=0;k<sample.size();++k)
+        {
+          std::ostringstream input; input << name << "[" << k << "]";
+          res[k] = kernel.tape.input(input.str(),sample[k]);
+        }
+        return res;
+      }
+
+      /// \brief Random configuration of the model, with normalized quaternions.
+      inline Eigen::VectorXd sampleConfiguration(const ModelTpl<TraceScalar> & model)
+      {
+        Eigen::VectorXd q (Eigen::VectorXd::Random(model.nq));
+        for(int i=1;i<model.nbody;++i)
+        {
+          if(model.joint_types[(std::size_t)i] == JOINT_SPHERICAL)
+            q.segment<4>(model.idx_qs[(std::size_t)i]).normalize();
+          else if(model.joint_types[(std::size_t)i] == JOINT_FREE_FLYER)
+            q.segment<4>(model.idx_qs[(std::size_t)i]+3).normalize();
+        }
+        return q;
+      }
+
+      inline void beginKernel(Kernel & kernel, const std::string & name, const std::string & output_name)
+      {
+        kernel.name = name;
+        kernel.output_name = output_name;
+        kernel.input_names.clear(); kernel.input_sizes.clear(); kernel.outputs.clear();
+        kernel.tape = Tape();
+        kernel.tape.activate();
+      }
+
+      /// \brief C literal of a constant, exact in double precision.
+      inline std::string literal(const double value)
+      {
+        std::ostringstream os; os << std::setprecision(17) << value;
+        std::string res (os.str());
+        if(res.find_first_of(".en") == std::string::npos) res += ".";
+        if(value < 0.) res = "(" + res + ")";
+        return res;
+      }
+    } // namespace internal
+
+    inline void traceForwardKinematics(const ModelTpl<TraceScalar> & model, Kernel & kernel)
+    {
+      internal::beginKernel(kernel,"forward_kinematics","oMi");
+      const internal::VectorXt q (internal::traceInput(kernel,"q",internal::sampleConfiguration(model)));
+
+      DataTpl<TraceScalar> data(model);
+      forwardKinematics(model,data,q);
+      for(int i=0;i<model.nbody;++i)
+      {
+        const SE3Tpl<TraceScalar> & oMi = data.oMi[(std::size_t)i];
+        for(int k=0;k<9;++k) kernel.outputs.push_back(oMi.rotation()(k%3,k/3));
+        for(int k=0;k<3;++k) kernel.outputs.push_back(oMi.translation()[k]);
+      }
+      kernel.tape.deactivate();
+    }
+
+    inline void traceRnea(const ModelTpl<TraceScalar> & model, Kernel & kernel)
+    {
+      internal::beginKernel(kernel,"rnea","tau");
+      const internal::VectorXt q (internal::traceInput(kernel,"q",internal::sampleConfiguration(model)));
+      const internal::VectorXt v (internal::traceInput(kernel,"v",Eigen::VectorXd::Random(model.nv)));
+      const internal::VectorXt a (internal::traceInput(kernel,"a",Eigen::VectorXd::Random(model.nv)));
+
+      DataTpl<TraceScalar> data(model);
+      rnea(model,data,q,v,a);
+      kernel.outputs.assign(data.tau.data(),data.tau.data()+model.nv);
+      kernel.tape.deactivate();
+    }
+
+    inline void traceAba(const ModelTpl<TraceScalar> & model, Kernel & kernel)
+    {
+      internal::beginKernel(kernel,"aba","ddq");
+      const internal::VectorXt q (internal::traceInput(kernel,"q",internal::sampleConfiguration(model)));
+      const internal::VectorXt v (internal::traceInput(kernel,"v",Eigen::VectorXd::Random(model.nv)));
+      const internal::VectorXt tau (internal::traceInput(kernel,"tau",Eigen::VectorXd::Random(model.nv)));
+
+      DataTpl<TraceScalar> data(model);
+      aba(model,data,q,v,tau);
+      kernel.outputs.assign(data.ddq.data(),data.ddq.data()+model.nv);
+      kernel.tape.deactivate();
+    }
+
+    inline void traceFrameJacobians(const ModelTpl<TraceScalar> & model, Kernel & kernel)
+    {
+      internal::beginKernel(kernel,"frame_jacobians","J");
+      const internal::VectorXt q (internal::traceInput(kernel,"q",internal::sampleConfiguration(model)));
+
+      DataTpl<TraceScalar> data(model);
+      framesForwardKinematics(model,data,q);
+      for(int f=0;f<model.nOperationalFrames;++f)
+      {
+        ModelTpl<TraceScalar>::Matrix6x J (ModelTpl<TraceScalar>::Matrix6x::Zero(6,model.nv));
+        getFrameJacobian(model,data,(ModelTpl<TraceScalar>::FrameIndex)f,J);
+        kernel.outputs.insert(kernel.outputs.end(),J.data(),J.data()+J.size());
+      }
+      kernel.tape.deactivate();
+    }
+
+    inline void writeKernelDeclaration(const std::string & prefix, const Kernel & kernel, std::ostream & os)
+    {
+      os << "void " << prefix << "_" << kernel.name << "(";
+      for(std::size_t k=0;k<kernel.input_names.size();++k)
+        os << "const double * " << kernel.input_names[k] << ", ";
+      os << "double * " << kernel.output_name << ")";
+    }
+
+    inline void writeKernel(const std::string & prefix, const Kernel & kernel, std::ostream & os)
+    {
+      const std::vector<Instruction> & instructions = kernel.tape.instructions();
+
+      /* Only the operations the outputs depend on are written. */
+      std::vector<bool> used (instructions.size(),false);
+      for(std::size_t k=0;k<kernel.outputs.size();++k)
+        if(!kernel.outputs[k].isConstant()) used[(std::size_t)kernel.outputs[k].id] = true;
+      for(std::size_t i=instructions.size();i-- > 0;)
+      {
+        if(!used[i]) continue;
+        if(instructions[i].lhs >= 0) used[(std::size_t)instructions[i].lhs] = true;
+        if(instructions[i].rhs >= 0) used[(std::size_t)instructions[i].rhs] = true;
+      }
+
+      std::vector<std::string> names (instructions.size());
+      std::vector<bool> referenced (kernel.input_names.size(),false);
+      int nb_temporaries = 0;
+
+      writeKernelDeclaration(prefix,kernel,os);
+      os << "\n{\n";
+      std::ostringstream body;
+      for(std::size_t i=0;i<instructions.size();++i)
+      {
+        if(!used[i]) continue;
+        const Instruction & instruction = instructions[i];
+        if(instruction.op == Instruction::INPUT)
+        {
+          names[i] = instruction.name;
+          for(std::size_t k=0;k<kernel.input_names.size();++k)
+            if(instruction.name.compare(0,kernel.input_names[k].size()+1,kernel.input_names[k] + "[") == 0)
+              referenced[k] = true;
+          continue;
+        }
+        if(instruction.op == Instruction::CONSTANT)
+        {
+          names[i] = internal::literal(instruction.value);
+          continue;
+        }
+
+        std::ostringstream name; name << "t" << nb_temporaries++;
+        names[i] = name.str();
+        const std::string & l = names[(std::size_t)std::max(instruction.lhs,0)];
+        const std::string & r = names[(std::size_t)std::max(instruction.rhs,0)];
+        body << "  const double " << names[i] << " = ";
+        switch(instruction.op)
+        {
+          case Instruction::NEG: body << "-" << l; break;
+          case Instruction::ADD: body << l << " + " << r; break;
+          case Instruction::SUB: body << l << " - " << r; break;
+          case Instruction::MUL: body << l << " * " << r; break;
+          case Instruction::DIV: body << l << " / " << r; break;
+          case Instruction::SQRT: body << "sqrt(" << l << ")"; break;
+          case Instruction::SIN: body << "sin(" << l << ")"; break;
+          case Instruction::COS: body << "cos(" << l << ")"; break;
+          case Instruction::ABS: body << "fabs(" << l << ")"; break;
+          default: assert(false && "Unexpected instruction"); break;
+        }
+        body << ";\n";
+      }
+
+      os << body.str();
+      for(std::size_t k=0;k<kernel.input_names.size();++k)
+        if(!referenced[k]) os << "  (void)" << kernel.input_names[k] << ";\n";
+      if(kernel.outputs.empty()) os << "  (void)" << kernel.output_name << ";\n";
+      for(std::size_t k=0;k<kernel.outputs.size();++k)
+      {
+        const TraceScalar & x = kernel.outputs[k];
+        os << "  " << kernel.output_name << "[" << k << "] = "
+           << (x.isConstant() ? internal::literal(x.value) : names[(std::size_t)x.id]) << ";\n";
+      }
+      os << "}\n";
+    }
+
+  } // namespace codegen
+
+  inline void generateCode(const Model & model,
+                           const std::string & prefix,
+                           std::ostream & header,
+                           std::ostream & source)
+  {
+    const ModelTpl<codegen::TraceScalar> model_trace (ModelTpl<double>(model).cast<codegen::TraceScalar>());
+
+    std::vector<codegen::Kernel> kernels (4);
+    codegen::traceForwardKinematics(model_trace,kernels[0]);
+    codegen::traceRnea(model_trace,kernels[1]);
+    codegen::traceAba(model_trace,kernels[2]);
+    codegen::traceFrameJacobians(model_trace,kernels[3]);
+
+    std::string guard (prefix), macro (prefix);
+    for(std::size_t k=0;k<macro.size();++k) macro[k] = (char)std::toupper(macro[k]);
+
+    header << "/* Generated by Pinocchio (se3::generateCode), specialized for one model. Do not edit. */\n"
+           << "#ifndef __" << guard << "_h__\n"
+           << "#define __" << guard << "_h__\n\n"
+           << "#define " << macro << "_NQ " << model.nq << "\n"
+           << "#define " << macro << "_NV " << model.nv << "\n"
+           << "#define " << macro << "_NBODY " << model.nbody << "\n"
+           << "#define " << macro << "_NFRAMES " << model.nOperationalFrames << "\n\n"
+           << "#ifdef __cplusplus\nextern \"C\" {\n#endif\n\n"
+           << "/* Placements of the joints (universe included): rotation (column major) then translation, 12 doubles each. */\n";
+    codegen::writeKernelDeclaration(prefix,kernels[0],header);
+    header << ";\n\n/* Inverse dynamics (Recursive Newton-Euler algorithm). */\n";
+    codegen::writeKernelDeclaration(prefix,kernels[1],header);
+    header << ";\n\n/* Forward dynamics (Articulated-Body algorithm). */\n";
+    codegen::writeKernelDeclaration(prefix,kernels[2],header);
+    header << ";\n\n/* Jacobians of the operational frames in their local frames: 6 x NV (column major) each. */\n";
+    codegen::writeKernelDeclaration(prefix,kernels[3],header);
+    header << ";\n\n#ifdef __cplusplus\n}\n#endif\n\n"
+           << "#endif /* __" << guard << "_h__ */\n";
+
+    source << "/* Generated by Pinocchio (se3::generateCode), specialized for one model. Do not edit. */\n"
+           << "#include \"" << prefix << ".h\"\n"
+           << "#include <math.h>\n";
+    for(std::size_t k=0;k<kernels.size();++k)
+    {
+      source << "\n";
+      codegen::writeKernel(prefix,kernels[k],source);
+    }
+  }
+
+} // namespace se3
+
+#endif // ifndef __se3_codegen_hpp__
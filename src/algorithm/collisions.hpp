@@ -58,6 +58,37 @@ namespace se3
                                        GeometryData & geom_data
                                        );
 
+  ///
+  /// \brief Apply an incremental forward kinematics (see se3::forwardKinematicsIncremental) and update the placement
+  ///        of the geometry objects attached to the joints which have moved.
+  ///
+  /// \param[in] model The model structure of the rigid body system.
+  /// \param[in] data The data structure of the rigid body system.
+  /// \param[in] geom The geometry model containing the collision objects.
+  /// \param[out] geom_data The geometry data containing the placements of the collision objects. See oMg field in GeometryData.
+  /// \param[in] q The joint configuration vector (dim model.nq).
+  ///
+  inline void updateGeometryPlacementsIncremental(const Model & model,
+                                                  Data & data,
+                                                  const GeometryModel & geom,
+                                                  GeometryData & geom_data,
+                                                  const Eigen::VectorXd & q
+                                                  );
+
+  ///
+  /// \brief Update the placement of the geometry objects attached to the joints flagged in data.oMi_updated.
+  ///
+  /// \param[in] model The model structure of the rigid body system.
+  /// \param[in] data The data structure of the rigid body system.
+  /// \param[in] geom The geometry model containing the collision objects.
+  /// \param[out] geom_data The geometry data containing the placements of the collision objects. See oMg field in GeometryData.
+  ///
+  inline void updateGeometryPlacementsIncremental(const Model & model,
+                                                  const Data & data,
+                                                  const GeometryModel & geom,
+                                                  GeometryData & geom_data
+                                                  );
+
   inline bool computeCollisions(const Model & model,
                                 Data & data,
                                 const GeometryModel & model_geom,
@@ -79,6 +110,42 @@ namespace se3
                               const Eigen::VectorXd & q
                               );
 
+  ///
+  /// \brief Compute the distance results of the collision pairs which may be closer than threshold, reusing the previous
+  ///        results of the other ones.
+  ///
+  /// \note At each call, the distance travelled by the points of each collision object is bounded from the change of its
+  ///       placement in GeometryData::oMg_collisions, and accumulated in GeometryData::travelled_distances.
+  ///       The distance of a pair cannot have decreased by more than the distance travelled by its two objects
+  ///       since its last evaluation: the FCL evaluation is skipped as long as this lower bound remains above threshold.
+  ///       The lower bounds are stored in GeometryData::distance_lower_bounds. They are derived from the distances of the
+  ///       last evaluations, kept in GeometryData::distance_cache_distances: the distance results of the skipped pairs are
+  ///       not updated, and may have been modified since by other functions (e.g. GeometryData::resetDistances, which also
+  ///       resets the cache).
+  ///
+  /// \param[in] data_geom The geometry data containing the placements of the collision objects.
+  /// \param[in] threshold The pairs whose distance may be below threshold are evaluated.
+  ///
+  inline void computeDistances(GeometryData & data_geom,
+                               const double threshold);
+
+  ///
+  /// \brief Update the placement of the geometry objects, then call computeDistances(data_geom,threshold).
+  ///
+  /// \param[in] model The model structure of the rigid body system.
+  /// \param[in] data The data structure of the rigid body system.
+  /// \param[in] model_geom The geometry model containing the collision objects.
+  /// \param[in] data_geom The geometry data containing the placements of the collision objects.
+  /// \param[in] q The joint configuration vector (dim model.nq).
+  /// \param[in] threshold The pairs whose distance may be below threshold are evaluated.
+  ///
+  inline void computeDistances(const Model & model,
+                               Data & data,
+                               const GeometryModel & model_geom,
+                               GeometryData & data_geom,
+                               const Eigen::VectorXd & q,
+                               const double threshold);
+
 } // namespace se3 
 
 /* --- Details -------------------------------------------------------------------- */
@@ -115,16 +182,63 @@ namespace se3
     }
   }
   
+  inline void updateGeometryPlacementsIncremental(const Model & model,
+                                                  Data & data,
+                                                  const GeometryModel & model_geom,
+                                                  GeometryData & data_geom,
+                                                  const Eigen::VectorXd & q
+                                                  )
+  {
+    forwardKinematicsIncremental(model, data, q);
+    updateGeometryPlacementsIncremental(model, data, model_geom, data_geom);
+  }
+  
+  inline void updateGeometryPlacementsIncremental(const Model &,
+                                                  const Data & data,
+                                                  const GeometryModel & model_geom,
+                                                  GeometryData & data_geom
+                                                  )
+  {
+    for (GeometryData::GeomIndex i=0; i < (GeometryData::GeomIndex) data_geom.model_geom.ncollisions; ++i)
+    {
+      const Model::JointIndex & parent = model_geom.collision_objects[i].parent;
+      if (!data.oMi_updated[parent]) continue;
+      data_geom.oMg_collisions[i] =  (data.oMi[parent] * model_geom.collision_objects[i].placement);
+      data_geom.oMg_fcl_collisions[i] =  toFclTransform3f(data_geom.oMg_collisions[i]);
+    }
+    for (GeometryData::GeomIndex i=0; i < (GeometryData::GeomIndex) data_geom.model_geom.nvisuals; ++i)
+    {
+      const Model::JointIndex & parent = model_geom.visual_objects[i].parent;
+      if (data.oMi_updated[parent])
+        data_geom.oMg_visuals[i] =  (data.oMi[parent] * model_geom.visual_objects[i].placement);
+    }
+  }
+  
   inline bool computeCollisions(GeometryData & data_geom,
                                 const bool stopAtFirstCollision
                                 )
   {
+    assert(data_geom.collision_status.size() == data_geom.collision_pairs.size()
+           && "The results are not synchronized with the collision pairs.");
     bool isColliding = false;
     
+    if (data_geom.broad_phase_enabled)
+    {
+      // Only the pairs selected by the broad phase can be in collision
+      data_geom.updateBroadPhase();
+      data_geom.resetCollisionResults();
+      for (std::size_t k = 0; k < data_geom.broad_phase_candidates.size(); ++k)
+      {
+        isColliding |= data_geom.computeCollisionResult(data_geom.broad_phase_candidates[k]);
+        if(isColliding && stopAtFirstCollision)
+          return true;
+      }
+      return isColliding;
+    }
+
     for (std::size_t cpt = 0; cpt < data_geom.collision_pairs.size(); ++cpt)
     {
-      data_geom.collision_results[cpt] = data_geom.computeCollision(data_geom.collision_pairs[cpt].first, data_geom.collision_pairs[cpt].second);
-      isColliding |= data_geom.collision_results[cpt].fcl_collision_result.isCollision();
+      isColliding |= data_geom.computeCollisionResult(cpt);
       if(isColliding && stopAtFirstCollision)
         return true;
     }
@@ -149,9 +263,10 @@ namespace se3
   
   inline void computeDistances(GeometryData & data_geom)
   {
+    assert(data_geom.distance_results.size() == data_geom.collision_pairs.size()
+           && "The results are not synchronized with the collision pairs.");
     for (std::size_t cpt = 0; cpt < data_geom.collision_pairs.size(); ++cpt)
-      data_geom.distance_results[cpt] = data_geom.computeDistance(data_geom.collision_pairs[cpt].first,
-                                                                  data_geom.collision_pairs[cpt].second);
+      data_geom.computeDistance(data_geom.collision_pairs[cpt], data_geom.distance_results[cpt].fcl_distance_result);
   }
   
   inline void computeDistances(const Model & model,
@@ -164,6 +279,72 @@ namespace se3
     updateGeometryPlacements (model, data, model_geom, data_geom, q);
     computeDistances(data_geom);
   }
+
+  inline void computeDistances(GeometryData & data_geom,
+                               const double threshold)
+  {
+    assert(data_geom.distance_results.size() == data_geom.collision_pairs.size()
+           && "The results are not synchronized with the collision pairs.");
+    const long npairs = (long)data_geom.nCollisionPairs;
+
+    if (data_geom.distance_cache_dirty)
+    {
+      data_geom.oMg_distance_cache = data_geom.oMg_collisions;
+      data_geom.travelled_distances.setZero();
+      data_geom.distance_cache_travels.setZero(npairs);
+      data_geom.distance_cache_distances.resize(npairs);
+      data_geom.distance_lower_bounds.resize(npairs);
+      for (long k = 0; k < npairs; ++k)
+      {
+        DistanceResult & result = data_geom.distance_results[(std::size_t)k];
+        data_geom.computeDistance(data_geom.collision_pairs[(std::size_t)k], result.fcl_distance_result);
+        data_geom.distance_cache_distances[k] = data_geom.distance_lower_bounds[k] = result.distance();
+      }
+      data_geom.distance_cache_dirty = false;
+      return;
+    }
+
+    // Distance travelled by the points of the objects since the previous call. For a point p at distance r of the origin
+    // of the object, |R1 p + t1 - R0 p - t0| <= |t1 - t0| + 2 sin(theta/2) r, with 4 sin^2(theta/2) = 3 - trace(R0^T R1)
+    for (std::size_t i = 0; i < data_geom.oMg_collisions.size(); ++i)
+    {
+      SE3 & oMg_previous = data_geom.oMg_distance_cache[i];
+      const SE3 & oMg = data_geom.oMg_collisions[i];
+      const double trace = oMg_previous.rotation().cwiseProduct(oMg.rotation()).sum();
+      data_geom.travelled_distances[(long)i] += (oMg.translation() - oMg_previous.translation()).norm()
+                                              + std::sqrt(std::max(3. - trace, 0.)) * data_geom.collision_object_radii[(long)i];
+      oMg_previous = oMg;
+    }
+
+    for (long k = 0; k < npairs; ++k)
+    {
+      const GeometryData::CollisionPair_t & pair = data_geom.collision_pairs[(std::size_t)k];
+      const double travel = data_geom.travelled_distances[(long)pair.first] + data_geom.travelled_distances[(long)pair.second];
+      DistanceResult & result = data_geom.distance_results[(std::size_t)k];
+
+      const double lower_bound = data_geom.distance_cache_distances[k] - (travel - data_geom.distance_cache_travels[k]);
+      if (lower_bound > threshold)
+      {
+        data_geom.distance_lower_bounds[k] = lower_bound;
+        continue;
+      }
+
+      data_geom.computeDistance(pair, result.fcl_distance_result);
+      data_geom.distance_cache_distances[k] = data_geom.distance_lower_bounds[k] = result.distance();
+      data_geom.distance_cache_travels[k] = travel;
+    }
+  }
+
+  inline void computeDistances(const Model & model,
+                               Data & data,
+                               const GeometryModel & model_geom,
+                               GeometryData & data_geom,
+                               const Eigen::VectorXd & q,
+                               const double threshold)
+  {
+    updateGeometryPlacements (model, data, model_geom, data_geom, q);
+    computeDistances(data_geom, threshold);
+  }
   
 } // namespace se3
 
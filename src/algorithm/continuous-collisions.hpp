@@ -0,0 +1,263 @@
+//
+// Copyright (c) 2016 CNRS
+//
+// This file is part of Pinocchio
+// Pinocchio is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// Pinocchio is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Lesser Public License for more details. You should have
+// received a copy of the GNU Lesser General Public License along with
+// Pinocchio If not, see
+// <http://www.gnu.org/licenses/>.
+
+
+#ifndef __se3_continuous_collisions_hpp__
+#define __se3_continuous_collisions_hpp__
+
+#include "pinocchio/multibody/model.hpp"
+#include "pinocchio/multibody/geometry.hpp"
+#include "pinocchio/algorithm/kinematics.hpp"
+#include "pinocchio/algorithm/joint-configuration.hpp"
+#include "pinocchio/algorithm/collisions.hpp"
+
+#include <limits>
+
+namespace se3
+{
+
+  ///
+  /// \brief Compute, for each collision pair, an upper bound of the rate of change of the distance between its two
+  ///        collision objects, when the robot moves along the interpolation from q0 to q1 (see se3::interpolate)
+  ///        during one unit of time.
+  ///
+  /// \note Along se3::interpolate, the relative motion of each joint has a constant angular speed \f$ \omega_j \f$ and
+  ///       a constant linear speed \f$ u_j \f$ (its origin moves along a line). The speed of a point of the collision object g
+  ///       supported by the joint k is then bounded by \f$ \sum_j u_j + \omega_j r_{j,g} \f$, where j runs over the joints
+  ///       supporting k, and \f$ r_{j,g} \f$ bounds the distance from the origin of j to the points of g.
+  ///       The joints supporting both objects of a pair do not change their distance, and are skipped.
+  ///
+  /// \param[in] model The model structure of the rigid body system.
+  /// \param[in] data The data structure of the rigid body system.
+  /// \param[in] model_geom The geometry model containing the collision objects.
+  /// \param[in] data_geom The geometry data containing the collision pairs.
+  /// \param[in] q0 The initial configuration (dim model.nq).
+  /// \param[in] q1 The final configuration (dim model.nq).
+  /// \param[out] motion_bounds The bound of each collision pair (dim data_geom.nCollisionPairs).
+  ///
+  inline void computeMotionBounds(const Model & model,
+                                  Data & data,
+                                  const GeometryModel & model_geom,
+                                  const GeometryData & data_geom,
+                                  const Eigen::VectorXd & q0,
+                                  const Eigen::VectorXd & q1,
+                                  Eigen::VectorXd & motion_bounds);
+
+  ///
+  /// \brief Continuous collision checking of the motion interpolating q0 and q1 (see se3::interpolate).
+  ///        It computes the first time of contact between the objects of the collision pairs, by conservative advancement.
+  ///
+  /// \note Each pair is given a safe time, until which it cannot be in contact: its distance at the time of its last
+  ///       evaluation, divided by its motion bound (see se3::computeMotionBounds). The algorithm moves to the smallest safe time,
+  ///       and evaluates again only the pairs whose safe time has been reached. The pairs that are far apart are thus
+  ///       evaluated only once, and thin obstacles cannot be missed as with a discretization of the motion.
+  ///
+  /// \param[in] model The model structure of the rigid body system.
+  /// \param[in] data The data structure of the rigid body system.
+  /// \param[in] model_geom The geometry model containing the collision objects.
+  /// \param[in] data_geom The geometry data containing the collision pairs. The placements and the distance results
+  ///            of the pairs are those of the last evaluations.
+  /// \param[in] q0 The initial configuration (dim model.nq).
+  /// \param[in] q1 The final configuration (dim model.nq).
+  /// \param[out] time_of_contact The time in [0,1] of the first contact if any, 1 otherwise.
+  /// \param[out] pair_index The index in collision_pairs of the pair in contact, if any.
+  /// \param[in] tolerance Two objects are considered in contact when their distance is below tolerance.
+  ///
+  /// \return True if a contact occurs along the motion.
+  ///
+  inline bool computeContinuousCollisions(const Model & model,
+                                          Data & data,
+                                          const GeometryModel & model_geom,
+                                          GeometryData & data_geom,
+                                          const Eigen::VectorXd & q0,
+                                          const Eigen::VectorXd & q1,
+                                          double & time_of_contact,
+                                          GeometryData::Index & pair_index,
+                                          const double tolerance = 1e-4);
+
+  ///
+  /// \brief Same as computeContinuousCollisions(model,data,model_geom,data_geom,q0,q1,time_of_contact,pair_index,tolerance),
+  ///        without the index of the pair in contact.
+  ///
+  inline bool computeContinuousCollisions(const Model & model,
+                                          Data & data,
+                                          const GeometryModel & model_geom,
+                                          GeometryData & data_geom,
+                                          const Eigen::VectorXd & q0,
+                                          const Eigen::VectorXd & q1,
+                                          double & time_of_contact,
+                                          const double tolerance = 1e-4);
+
+} // namespace se3
+
+/* --- Details -------------------------------------------------------------------- */
+namespace se3
+{
+  namespace internal
+  {
+    ///
+    /// \brief Bound of the speed of the points of a collision object, due to the joints from its parent joint
+    ///        up to the ancestor joint (excluded).
+    ///
+    inline double objectMotionBound(const Model & model,
+                                    const Eigen::VectorXd & linear_speeds,
+                                    const Eigen::VectorXd & angular_speeds,
+                                    const Eigen::VectorXd & joint_offsets,
+                                    const double object_radius,
+                                    Model::JointIndex joint,
+                                    const Model::JointIndex ancestor)
+    {
+      double bound = 0.;
+      double radius = object_radius;
+      while (joint != ancestor)
+      {
+        bound += linear_speeds[(long)joint] + angular_speeds[(long)joint] * radius;
+        radius += joint_offsets[(long)joint];
+        joint = model.parents[joint];
+      }
+      return bound;
+    }
+  } // namespace internal
+
+  inline void computeMotionBounds(const Model & model,
+                                  Data & data,
+                                  const GeometryModel & model_geom,
+                                  const GeometryData & data_geom,
+                                  const Eigen::VectorXd & q0,
+                                  const Eigen::VectorXd & q1,
+                                  Eigen::VectorXd & motion_bounds)
+  {
+    typedef Model::JointIndex JointIndex;
+    typedef GeometryData::GeomIndex GeomIndex;
+
+    // Speeds of the joints, from the joint velocities which lead from q0 to q1 in one unit of time
+    Eigen::VectorXd linear_speeds(Eigen::VectorXd::Zero(model.nbody));
+    Eigen::VectorXd angular_speeds(Eigen::VectorXd::Zero(model.nbody));
+    Eigen::VectorXd joint_offsets(Eigen::VectorXd::Zero(model.nbody));
+
+    Eigen::VectorXd v(model.nv);
+    differentiate(model, q0, q1, v);
+    forwardKinematics(model, data, q0, v);
+    for (JointIndex i = 1; i < (JointIndex)model.nbody; ++i)
+    {
+      const Motion vJ (data.v[i] - data.liMi[i].actInv(data.v[model.parents[i]]));
+      linear_speeds[(long)i] = vJ.linear().norm();
+      angular_speeds[(long)i] = vJ.angular().norm();
+      joint_offsets[(long)i] = data.liMi[i].translation().norm();
+    }
+
+    // The translation of the joints is an affine function of the interpolation parameter: its norm is maximal at q0 or q1
+    forwardKinematics(model, data, q1);
+    for (JointIndex i = 1; i < (JointIndex)model.nbody; ++i)
+      joint_offsets[(long)i] = std::max(joint_offsets[(long)i], data.liMi[i].translation().norm());
+
+    motion_bounds.resize((long)data_geom.nCollisionPairs);
+    for (GeometryData::Index k = 0; k < data_geom.nCollisionPairs; ++k)
+    {
+      const GeomIndex co1 = data_geom.collision_pairs[k].first;
+      const GeomIndex co2 = data_geom.collision_pairs[k].second;
+      const GeometryObject & object1 = model_geom.collision_objects[co1];
+      const GeometryObject & object2 = model_geom.collision_objects[co2];
+
+      // Closest common ancestor of the two parent joints
+      JointIndex ancestor = object1.parent, ancestor2 = object2.parent;
+      while (ancestor != ancestor2)
+      {
+        if (ancestor > ancestor2) ancestor = model.parents[ancestor];
+        else ancestor2 = model.parents[ancestor2];
+      }
+
+      const double radius1 = object1.placement.translation().norm() + data_geom.collision_object_radii[(long)co1];
+      const double radius2 = object2.placement.translation().norm() + data_geom.collision_object_radii[(long)co2];
+
+      motion_bounds[(long)k] =
+          internal::objectMotionBound(model, linear_speeds, angular_speeds, joint_offsets, radius1, object1.parent, ancestor)
+        + internal::objectMotionBound(model, linear_speeds, angular_speeds, joint_offsets, radius2, object2.parent, ancestor);
+    }
+  }
+
+  inline bool computeContinuousCollisions(const Model & model,
+                                          Data & data,
+                                          const GeometryModel & model_geom,
+                                          GeometryData & data_geom,
+                                          const Eigen::VectorXd & q0,
+                                          const Eigen::VectorXd & q1,
+                                          double & time_of_contact,
+                                          GeometryData::Index & pair_index,
+                                          const double tolerance)
+  {
+    assert(tolerance > 0. && "The tolerance must be positive.");
+    assert(data_geom.distance_results.size() == data_geom.collision_pairs.size()
+           && "The results are not synchronized with the collision pairs.");
+
+    const long npairs = (long)data_geom.nCollisionPairs;
+    Eigen::VectorXd motion_bounds;
+    computeMotionBounds(model, data, model_geom, data_geom, q0, q1, motion_bounds);
+
+    // Time until which each pair is known to be free
+    Eigen::VectorXd safe_times(Eigen::VectorXd::Zero(npairs));
+    Eigen::VectorXd q(q0);
+    double t = 0.;
+    while (true)
+    {
+      interpolate(model, q0, q1, t, q);
+      updateGeometryPlacements(model, data, model_geom, data_geom, q);
+
+      for (long k = 0; k < npairs; ++k)
+      {
+        if (safe_times[k] > t) continue;
+
+        fcl::DistanceResult & result = data_geom.distance_results[(std::size_t)k].fcl_distance_result;
+        data_geom.computeDistance(data_geom.collision_pairs[(std::size_t)k], result);
+        const double distance = result.min_distance;
+        if (distance <= tolerance)
+        {
+          time_of_contact = t;
+          pair_index = (GeometryData::Index)k;
+          return true;
+        }
+
+        safe_times[k] = (motion_bounds[k] > 0.) ? t + distance / motion_bounds[k]
+                                                : std::numeric_limits<double>::infinity();
+      }
+
+      t = (npairs > 0) ? safe_times.minCoeff() : std::numeric_limits<double>::infinity();
+      if (t > 1.)
+      {
+        time_of_contact = 1.;
+        return false;
+      }
+    }
+  }
+
+  inline bool computeContinuousCollisions(const Model & model,
+                                          Data & data,
+                                          const GeometryModel & model_geom,
+                                          GeometryData & data_geom,
+                                          const Eigen::VectorXd & q0,
+                                          const Eigen::VectorXd & q1,
+                                          double & time_of_contact,
+                                          const double tolerance)
+  {
+    GeometryData::Index pair_index;
+    return computeContinuousCollisions(model, data, model_geom, data_geom, q0, q1,
+                                       time_of_contact, pair_index, tolerance);
+  }
+
+} // namespace se3
+
+#endif // ifndef __se3_continuous_collisions_hpp__
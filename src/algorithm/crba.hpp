@@ -19,6 +19,7 @@
 #define __se3_crba_hpp__
 
 #include "pinocchio/multibody/model.hpp"
+#include "pinocchio/multibody/model-tpl.hpp"
   
 namespace se3
 {
@@ -41,6 +42,26 @@ namespace se3
   crba(const Model & model,
        Data & data,
        const Eigen::VectorXd & q);
+
+  ///
+  /// \brief Computes the joint space inertia matrix M in the branch-induced sparse format of se3::BranchSparseMatrix.
+  ///        The result is accessible through data.Msparse. No matrix of dim model.nv x model.nv is used.
+  ///
+  /// \note The entries of M are computed as \f$ M_{rc} = J_r^{\top} \, ^0Y^{c}_{\text{crb}} J_c \f$, J_r being the column of
+  ///       the joint Jacobian expressed in the world frame and \f$ ^0Y^{c}_{\text{crb}} \f$ the composite inertia of the subtree
+  ///       supported by the dof c, expressed in the world frame. As a by-product, data.oMi, data.liMi and data.J are computed
+  ///       (as in se3::computeJacobians) and data.Ycrb contains the composite inertias expressed in the world frame.
+  ///
+  /// \param[in] model The model structure of the rigid body system.
+  /// \param[in] data The data structure of the rigid body system.
+  /// \param[in] q The joint configuration vector (dim model.nq).
+  ///
+  /// \return The joint space inertia matrix stored in data.Msparse.
+  ///
+  inline const BranchSparseMatrix &
+  crbaSparse(const Model & model,
+             Data & data,
+             const Eigen::VectorXd & q);
   
   ///
   /// \brief Computes the upper triangular part of the joint space inertia matrix M by
@@ -64,6 +85,21 @@ namespace se3
         const Eigen::VectorXd & q,
         const Eigen::VectorXd & v);
 
+  ///
+  /// \brief Computes the upper triangular part of the joint space inertia matrix M by the Composite Rigid Body Algorithm,
+  ///        with an arbitrary scalar type (e.g. float).
+  ///
+  /// \param[in] model The model structure of the rigid body system, converted to Scalar.
+  /// \param[in] data The data structure of the rigid body system.
+  /// \param[in] q The joint configuration vector (dim model.nq).
+  ///
+  /// \return The joint space inertia matrix with only the upper triangular part computed, stored in data.M.
+  ///
+  template<typename Scalar>
+  inline const Eigen::Matrix<Scalar,Eigen::Dynamic,Eigen::Dynamic> &
+  crba(const ModelTpl<Scalar> & model, DataTpl<Scalar> & data,
+       const Eigen::Matrix<Scalar,Eigen::Dynamic,1> & q);
+
 } // namespace se3 
 
 /* --- Details -------------------------------------------------------------------- */
@@ -117,6 +117,91 @@ namespace se3
     return data.M;
   }
   
+  struct CrbaSparseForwardStep : public fusion::JointVisitor<CrbaSparseForwardStep>
+  {
+    typedef boost::fusion::vector<const se3::Model&,
+                                  se3::Data &,
+                                  const Eigen::VectorXd &
+                                  > ArgsType;
+
+    JOINT_VISITOR_INIT(CrbaSparseForwardStep);
+
+    template<typename JointModel>
+    static void algo(const se3::JointModelBase<JointModel> & jmodel,
+                     se3::JointDataBase<typename JointModel::JointData> & jdata,
+                     const se3::Model & model,
+                     se3::Data & data,
+                     const Eigen::VectorXd & q)
+    {
+      const Model::JointIndex & i = (Model::JointIndex) jmodel.id();
+      const Model::JointIndex & parent = model.parents[i];
+      jmodel.calc(jdata.derived(),q);
+
+      data.liMi[i] = model.jointPlacements[i]*jdata.M();
+      if(parent>0) data.oMi[i] = data.oMi[parent]*data.liMi[i];
+      else data.oMi[i] = data.liMi[i];
+
+      jmodel.jointCols(data.J) = data.oMi[i].act(jdata.S());
+      data.Ycrb[i] = data.oMi[i].act(model.inertias[i]);
+    }
+
+  };
+
+  struct CrbaSparseBackwardStep : public fusion::JointVisitor<CrbaSparseBackwardStep>
+  {
+    typedef boost::fusion::vector<const Model&,
+                                  Data&>  ArgsType;
+
+    JOINT_VISITOR_INIT(CrbaSparseBackwardStep);
+
+    template<typename JointModel>
+    static void algo(const JointModelBase<JointModel> & jmodel,
+                     JointDataBase<typename JointModel::JointData> &,
+                     const Model & model,
+                     Data & data)
+    {
+      /*
+       * F = Ycrb*J[:,i]
+       * M[CHAIN,i] = J[:,CHAIN]'*F
+       * Yli += Yi
+       */
+      const Model::JointIndex & i = (Model::JointIndex) jmodel.id();
+      BranchSparseMatrix & M = data.Msparse;
+
+      for(int k=0;k<jmodel.nv();++k)
+      {
+        const int c = jmodel.idx_v()+k;
+        data.Fsparse.col(c) = (data.Ycrb[i]*Motion(data.J.col(c))).toVector();
+
+        BranchSparseMatrix::ChainXpr Mc = M.chain(c);
+        for(int r=c;r>=0;r=M.parents[(std::size_t)r])
+          Mc[M.depth[(std::size_t)r]] = data.J.col(r).dot(data.Fsparse.col(c));
+      }
+
+      const Model::JointIndex & parent = model.parents[i];
+      if(parent>0) data.Ycrb[parent] += data.Ycrb[i];
+    }
+  };
+
+  inline const BranchSparseMatrix &
+  crbaSparse(const Model & model, Data & data,
+             const Eigen::VectorXd & q)
+  {
+    for( Model::JointIndex i=1;i<(Model::JointIndex)(model.nbody);++i )
+    {
+      CrbaSparseForwardStep::run(model.joints[i],data.joints[i],
+                                 CrbaSparseForwardStep::ArgsType(model,data,q));
+    }
+
+    for( Model::JointIndex i=(Model::JointIndex)(model.nbody-1);i>0;--i )
+    {
+      CrbaSparseBackwardStep::run(model.joints[i],data.joints[i],
+                                  CrbaSparseBackwardStep::ArgsType(model,data));
+    }
+
+    return data.Msparse;
+  }
+
   struct CcrbaForwardStep : public fusion::JointVisitor<CcrbaForwardStep>
   {
     typedef boost::fusion::vector< const se3::Model &,
@@ -209,6 +294,45 @@ namespace se3
     
     return data.Ag;
   }
+
+  template<typename Scalar>
+  inline const Eigen::Matrix<Scalar,Eigen::Dynamic,Eigen::Dynamic> &
+  crba(const ModelTpl<Scalar> & model, DataTpl<Scalar> & data,
+       const Eigen::Matrix<Scalar,Eigen::Dynamic,1> & q)
+  {
+    typedef typename ModelTpl<Scalar>::JointIndex JointIndex;
+    typedef typename DataTpl<Scalar>::Matrix6 Matrix6;
+    assert(q.size() == model.nq);
+
+    for( JointIndex i=1;i<(JointIndex)model.nbody;++i )
+    {
+      data.liMi[i] = model.jointPlacements[i] * jointTransform(model,i,q);
+      data.Ycrb[i] = model.inertias[i];
+    }
+
+    for( JointIndex i=(JointIndex)model.nbody-1;i>0;--i )
+    {
+      const JointIndex & parent = model.parents[i];
+      const int idx_v = model.idx_vs[i], nv = model.nvs[i], nvSubtree = model.nvSubtree[i];
+
+      /* F[1:6,i] = Y*S */
+      data.Fcrb.middleCols(idx_v,nv) = data.Ycrb[i].matrix() * model.S[i];
+
+      /* M[i,SUBTREE] = S'*F[1:6,SUBTREE] */
+      data.M.block(idx_v,idx_v,nv,nvSubtree) = model.S[i].transpose() * data.Fcrb.middleCols(idx_v,nvSubtree);
+
+      if(parent>0)
+      {
+        /* Yli += liXi Yi, F[1:6,SUBTREE] = liXi F[1:6,SUBTREE] */
+        data.Ycrb[parent] += data.liMi[i].act(data.Ycrb[i]);
+        const Matrix6 Xstar (data.liMi[i].inverse().toActionMatrix().transpose());
+        data.Fcrb.middleCols(idx_v,nvSubtree) = (Xstar * data.Fcrb.middleCols(idx_v,nvSubtree)).eval();
+      }
+    }
+
+    return data.M;
+  }
+
 } // namespace se3
 
 /// @endcond
@@ -22,11 +22,77 @@
 #include "pinocchio/algorithm/compute-all-terms.hpp"
 #include "pinocchio/algorithm/cholesky.hpp"
 #include "pinocchio/algorithm/crba.hpp"
+#include "pinocchio/algorithm/rnea.hpp"
+#include "pinocchio/algorithm/aba.hpp"
+#include "pinocchio/multibody/visitor.hpp"
+#include "pinocchio/spatial/act-on-set.hpp"
 
 #include <Eigen/Cholesky>
 namespace se3
 {
   
+  ///
+  /// \brief Compute the inverse \f$ J M^{-1} J^{\top} \f$ of the operational-space inertia matrix of the constraints
+  ///        and its Cholesky decomposition, exploiting the kinematic-tree sparsity of J.
+  ///
+  /// \note A constraint whose row of J is supported by a single kinematic chain (the ancestors of its deepest nonzero dof,
+  ///       as for a contact on a body) is only processed along this chain, through data.parents_fromRow: the cost is
+  ///       O(d^2) for the computation of \f$ \sqrt{D}^{-1} U^{-1} J^{\top} \f$ and O(d) for each entry of \f$ J M^{-1} J^{\top} \f$,
+  ///       d being the depth of the chain, instead of O(model.nv). The other constraints are processed densely.
+  ///       The chains of the constraints and their common parts are stored in data.constraint_chainEnd and
+  ///       data.constraint_chainCommon. They are only recomputed when the sparsity pattern of J changes, so that
+  ///       successive calls with the same set of active contacts reuse them.
+  ///       The Cholesky decomposition of the joint space inertia matrix must be stored in data (see se3::cholesky::decompose).
+  ///
+  /// \param[in] model The model structure of the rigid body system.
+  /// \param[in] data The data structure of the rigid body system.
+  /// \param[in] J The Jacobian of the constraints (dim nb_constraints*model.nv).
+  ///
+  /// \return A reference to \f$ J M^{-1} J^{\top} \f$ stored in data.JMinvJt. Its Cholesky decomposition is stored in data.llt_JMinvJt
+  ///         and \f$ \sqrt{D}^{-1} U^{-1} J^{\top} \f$ in data.sDUiJt.
+  ///
+  inline const Eigen::MatrixXd & computeJMinvJt(const Model & model,
+                                                Data & data,
+                                                const Eigen::MatrixXd & J);
+  
+  ///
+  /// \brief Activate or deactivate the constraint c (row c of J) in the \f$ J M^{-1} J^{\top} \f$ factorized by the last call to
+  ///        se3::computeJMinvJt, by a rank-two update of its Cholesky decomposition data.llt_JMinvJt instead of a new factorization.
+  ///
+  /// \note This is meant for changes of the active contacts within a step (e.g. an active-set iteration on the contact forces),
+  ///       at the configuration and with the Jacobian J of the last call to se3::computeJMinvJt: the rows of J are all kept,
+  ///       an inactive constraint has a unit row and column in data.JMinvJt and no contact force. When the configuration changes,
+  ///       \f$ J M^{-1} J^{\top} \f$ has to be factorized again by se3::computeJMinvJt, which reuses the constraint pattern
+  ///       of the previous steps (data.constraint_chainEnd and data.constraint_chainCommon) as long as the sparsity of J is unchanged.
+  ///       The constraints are all active after se3::computeJMinvJt.
+  ///
+  /// \param[in] model The model structure of the rigid body system.
+  /// \param[in] data The data structure of the rigid body system.
+  /// \param[in] c The index of the constraint.
+  /// \param[in] active True to activate the constraint, false to deactivate it.
+  ///
+  inline void updateActiveConstraint(const Model & model,
+                                     Data & data,
+                                     const int c,
+                                     const bool active);
+  
+  ///
+  /// \brief Solve the contact problem of se3::forwardDynamics with the dynamic values and the decompositions already stored in data
+  ///        (data.torque_residual, the Cholesky decompositions of data.M and of \f$ J M^{-1} J^{\top} \f$), leaving the constraints
+  ///        deactivated by se3::updateActiveConstraint out.
+  ///
+  /// \param[in] model The model structure of the rigid body system.
+  /// \param[in] data The data structure of the rigid body system.
+  /// \param[in] J The Jacobian of the constraints given to the last call to se3::computeJMinvJt (dim nb_constraints*model.nv).
+  /// \param[in] gamma The drift of the constraints (dim nb_constraints).
+  ///
+  /// \return A reference to the joint acceleration stored in data.ddq. The Lagrange Multipliers linked to the contact forces are available throw data.lambda_c vector.
+  ///
+  inline const Eigen::VectorXd & solveContactDynamics(const Model & model,
+                                                      Data & data,
+                                                      const Eigen::MatrixXd & J,
+                                                      const Eigen::VectorXd & gamma);
+  
   ///
   /// \brief Compute the forward dynamics with contact constraints.
   /// \note It computes the following problem: <BR>
@@ -62,9 +128,6 @@ namespace se3
     assert(J.cols() == model.nv);
     assert(J.rows() == gamma.size());
     
-    Eigen::VectorXd & a = data.ddq;
-    Eigen::VectorXd & lambda_c = data.lambda_c;
-    
     if (updateKinematics)
       computeAllTerms(model, data, q, v);
     
@@ -75,26 +138,115 @@ namespace se3
     data.torque_residual = tau - data.nle;
     cholesky::solve(model, data, data.torque_residual);
     
+    // Compute J M^-1 J.T, exploiting the sparsity of J
+    computeJMinvJt(model, data, J);
+    
+    return solveContactDynamics(model, data, J, gamma);
+  }
+  
+  ///
+  /// \brief Compute the forward dynamics with contact constraints, as se3::forwardDynamics, but using the joint space
+  ///        inertia matrix in the branch-induced sparse format (data.Msparse) and its sparse Cholesky decomposition.
+  ///        No matrix of dim model.nv x model.nv is used.
+  ///
+  /// \param[in] model The model structure of the rigid body system.
+  /// \param[in] data The data structure of the rigid body system.
+  /// \param[in] q The joint configuration (vector dim model.nq).
+  /// \param[in] v The joint velocity (vector dim model.nv).
+  /// \param[in] tau The joint torque vector (dim model.nv).
+  /// \param[in] J The Jacobian of the constraints (dim nb_constraints*model.nv).
+  /// \param[in] gamma The drift of the constraints (dim nb_constraints).
+  /// \param[in] updateKinematics If true, the algorithm calls first se3::crbaSparse and se3::nonLinearEffects. Otherwise, it uses the current values of data.Msparse and data.nle.
+  ///
+  /// \return A reference to the joint acceleration stored in data.ddq. The Lagrange Multipliers linked to the contact forces are available throw data.lambda_c vector.
+  ///
+  inline const Eigen::VectorXd & forwardDynamicsSparse(const Model & model,
+                                                       Data & data,
+                                                       const Eigen::VectorXd & q,
+                                                       const Eigen::VectorXd & v,
+                                                       const Eigen::VectorXd & tau,
+                                                       const Eigen::MatrixXd & J,
+                                                       const Eigen::VectorXd & gamma,
+                                                       const bool updateKinematics = true
+                                                       )
+  {
+    assert(q.size() == model.nq);
+    assert(v.size() == model.nv);
+    assert(tau.size() == model.nv);
+    assert(J.cols() == model.nv);
+    assert(J.rows() == gamma.size());
+    
+    Eigen::VectorXd & a = data.ddq;
+    Eigen::VectorXd & lambda_c = data.lambda_c;
+    
+    if (updateKinematics)
+    {
+      crbaSparse(model, data, q);
+      nonLinearEffects(model, data, q, v);
+    }
+    
+    // Compute the UDUt decomposition of data.Msparse
+    cholesky::decomposeSparse(model, data);
+    
+    // Compute the dynamic drift (control - nle)
+    data.torque_residual = tau - data.nle;
+    cholesky::solveSparse(model, data, data.torque_residual);
+    
     data.sDUiJt = J.transpose();
     // Compute U^-1 * J.T
-    cholesky::Uiv(model, data, data.sDUiJt);
+    cholesky::UivSparse(model, data, data.sDUiJt);
     for(int k=0;k<model.nv;++k) data.sDUiJt.row(k) /= sqrt(data.D[k]);
     
     data.JMinvJt.noalias() = data.sDUiJt.transpose() * data.sDUiJt;
     data.llt_JMinvJt.compute(data.JMinvJt);
     
     // Compute the Lagrange Multipliers
-    lambda_c = -gamma -J*data.torque_residual;
+    lambda_c.noalias() = -J*data.torque_residual;
+    lambda_c -= gamma;
     data.llt_JMinvJt.solveInPlace (lambda_c);
     
     // Compute the joint acceleration
-    a = J.transpose() * lambda_c;
-    cholesky::solve (model, data, a);
+    a.noalias() = J.transpose() * lambda_c;
+    cholesky::solveSparse (model, data, a);
     a += data.torque_residual;
     
     return a;
   }
   
+  ///
+  /// \brief Compute the forward dynamics with 6D contact constraints on joint frames, as se3::forwardDynamics, but with a
+  ///        recursive algorithm based on the Articulated-Body algorithm.
+  ///
+  /// \note The constraint of the contact c is \f$ J_c \ddot{q} + \gamma_c = 0 \f$, where \f$ J_c \f$ is the Jacobian of the
+  ///       joint contacts[c] expressed in its frame (see se3::getJacobian<true>). The result is the one of se3::forwardDynamics
+  ///       with J the stacking of the \f$ J_c \f$. The contacts must be independent (e.g. on distinct joints).
+  ///
+  ///       The free acceleration is computed by se3::aba. The articulated-body quantities of aba are then reused to propagate
+  ///       unit contact forces along the chain supporting each contact (backward), and to evaluate their effect on the other
+  ///       contacts along the chain supporting them (forward), which gives \f$ J M^{-1} J^{\top} \f$. Once the contact forces are
+  ///       known, a last forward pass adds their contribution to the joint accelerations. No matrix of dim model.nv x model.nv
+  ///       is formed: the cost is one se3::aba plus O(model.nv * m + d * m^2), m being the number of contacts and d the
+  ///       depth of the kinematic tree.
+  ///
+  /// \param[in] model The model structure of the rigid body system.
+  /// \param[in] data The data structure of the rigid body system.
+  /// \param[in] q The joint configuration (vector dim model.nq).
+  /// \param[in] v The joint velocity (vector dim model.nv).
+  /// \param[in] tau The joint torque vector (dim model.nv).
+  /// \param[in] contacts The joints supporting the contacts.
+  /// \param[in] gamma The drift of the constraints (dim 6*contacts.size()).
+  ///
+  /// \return A reference to the joint acceleration stored in data.ddq. The Lagrange Multipliers linked to the contact forces,
+  ///         expressed in the joint frames, are available throw data.lambda_c vector.
+  ///
+  inline const Eigen::VectorXd & forwardDynamicsRecursive(const Model & model,
+                                                          Data & data,
+                                                          const Eigen::VectorXd & q,
+                                                          const Eigen::VectorXd & v,
+                                                          const Eigen::VectorXd & tau,
+                                                          const std::vector<Model::JointIndex> & contacts,
+                                                          const Eigen::VectorXd & gamma);
+  
   ///
   /// \brief Compute the impulse dynamics with contact constraints.
   /// \note It computes the following problem: <BR>
@@ -136,20 +288,15 @@ namespace se3
     // Compute the UDUt decomposition of data.M
     cholesky::decompose(model, data);
     
-    data.sDUiJt = J.transpose();
-    // Compute U^-1 * J.T
-    cholesky::Uiv(model, data, data.sDUiJt);
-    for(int k=0;k<model.nv;++k) data.sDUiJt.row(k) /= sqrt(data.D[k]);
-    
-    data.JMinvJt.noalias() = data.sDUiJt.transpose() * data.sDUiJt;
-    data.llt_JMinvJt.compute(data.JMinvJt);
+    // Compute J M^-1 J.T, exploiting the sparsity of J
+    computeJMinvJt(model, data, J);
     
     // Compute the Lagrange Multipliers related to the contact impulses
-    impulse_c = (-r_coeff - 1.) * (J * v_before);
+    impulse_c.noalias() = (-r_coeff - 1.) * (J * v_before);
     data.llt_JMinvJt.solveInPlace (impulse_c);
     
     // Compute the joint velocity after impacts
-    dq_after = J.transpose() * impulse_c;
+    dq_after.noalias() = J.transpose() * impulse_c;
     cholesky::solve (model, data, dq_after);
     dq_after += v_before;
     
@@ -157,5 +304,361 @@ namespace se3
   }
 } // namespace se3
 
+/* --- Details -------------------------------------------------------------------- */
+namespace se3
+{
+  namespace internal
+  {
+    /// \brief Deepest dof of the chain supporting the row c of J, or -1 if the row is not supported by a single chain.
+    inline int constraintChainEnd(const Model & model, const Data & data,
+                                  const Eigen::MatrixXd & J, const int c)
+    {
+      int end = model.nv-1;
+      while(end >= 0 && J(c,end) == 0.) --end;
+      if(end < 0) return -1;
+      
+      // Any other nonzero dof k must support end, i.e. end must be in the subtree of k.
+      for(int k=end-1;k>=0;--k)
+        if(J(c,k) != 0. && end >= k + data.nvSubtree_fromRow[(Model::Index)k]) return -1;
+      return end;
+    }
+    
+    /// \brief Update data.constraint_chainEnd and data.constraint_chainCommon from the sparsity pattern of J, if it has changed.
+    inline void updateConstraintPattern(const Model & model, Data & data,
+                                        const Eigen::MatrixXd & J)
+    {
+      const int nc = (int)J.rows();
+      bool changed = ((int)data.constraint_chainEnd.size() != nc);
+      data.constraint_chainEnd.resize((std::size_t)nc);
+      for(int c=0;c<nc;++c)
+      {
+        const int end = constraintChainEnd(model,data,J,c);
+        changed = changed || (end != data.constraint_chainEnd[(std::size_t)c]);
+        data.constraint_chainEnd[(std::size_t)c] = end;
+      }
+      if(!changed) return;
+      
+      const std::vector<int> & parents = data.parents_fromRow;
+      data.constraint_chainCommon.resize(nc,nc);
+      for(int a=0;a<nc;++a)
+        for(int b=a;b<nc;++b)
+        {
+          int i = data.constraint_chainEnd[(std::size_t)a], j = data.constraint_chainEnd[(std::size_t)b];
+          if(i < 0 && j < 0) i = j = -2;
+          else if(i < 0) i = j;
+          else if(j < 0) j = i;
+          // The parent of a dof has a lower index: move the deepest one up to the common ancestor.
+          while(i != j)
+          {
+            if(i > j) i = parents[(Model::Index)i];
+            else j = parents[(Model::Index)j];
+          }
+          data.constraint_chainCommon(a,b) = data.constraint_chainCommon(b,a) = i;
+        }
+    }
+    
+    /// \brief Entry (a,b) of \f$ J M^{-1} J^{\top} \f$ from data.sDUiJt, summing over the chain common to the constraints a and b only.
+    inline double JMinvJtEntry(const Data & data, const int a, const int b)
+    {
+      const std::vector<int> & parents = data.parents_fromRow;
+      const int common = data.constraint_chainCommon(a,b);
+      if(common == -2)
+        return data.sDUiJt.col(a).dot(data.sDUiJt.col(b));
+      
+      double res = 0.;
+      for(int k=common;k>=0;k=parents[(Model::Index)k])
+        res += data.sDUiJt(k,a) * data.sDUiJt(k,b);
+      return res;
+    }
+  } // namespace internal
+  
+  inline const Eigen::MatrixXd & computeJMinvJt(const Model & model,
+                                                Data & data,
+                                                const Eigen::MatrixXd & J)
+  {
+    assert(J.cols() == model.nv);
+    
+    const std::vector<int> & parents = data.parents_fromRow;
+    const Eigen::MatrixXd & U = data.U;
+    const int nc = (int)J.rows();
+    
+    internal::updateConstraintPattern(model,data,J);
+    
+    // Compute sqrt(D)^-1 U^-1 J.T, column by column
+    data.sDUiJt = J.transpose();
+    for(int c=0;c<nc;++c)
+    {
+      Eigen::MatrixXd::ColXpr col = data.sDUiJt.col(c);
+      const int end = data.constraint_chainEnd[(std::size_t)c];
+      if(end < 0)
+      {
+        cholesky::Uiv(model,data,col);
+        for(int k=0;k<model.nv;++k) col[k] /= sqrt(data.D[k]);
+        continue;
+      }
+      
+      /* We search y s.t. J.T = U y. Both are supported by the chain of end.
+       * For j in the chain from end to the root, y_j is final and is removed from its ancestors. */
+      for(int j=end;j>=0;j=parents[(Model::Index)j])
+      {
+        for(int k=parents[(Model::Index)j];k>=0;k=parents[(Model::Index)k])
+          col[k] -= U(k,j) * col[j];
+        col[j] /= sqrt(data.D[j]);
+      }
+    }
+    
+    // J M^-1 J.T = (sqrt(D)^-1 U^-1 J.T)' (sqrt(D)^-1 U^-1 J.T), summing over the common chains only
+    data.JMinvJt.resize(nc,nc);
+    for(int a=0;a<nc;++a)
+      for(int b=a;b<nc;++b)
+        data.JMinvJt(a,b) = data.JMinvJt(b,a) = internal::JMinvJtEntry(data,a,b);
+    
+    data.constraint_active.assign((std::size_t)nc,true);
+    data.llt_JMinvJt.compute(data.JMinvJt);
+    return data.JMinvJt;
+  }
+  
+  inline void updateActiveConstraint(const Model &,
+                                     Data & data,
+                                     const int c,
+                                     const bool active)
+  {
+    const int nc = (int)data.JMinvJt.rows();
+    assert(c >= 0 && c < nc);
+    assert((int)data.constraint_active.size() == nc);
+    
+    if(data.constraint_active[(std::size_t)c] == active) return;
+    data.constraint_active[(std::size_t)c] = active;
+    
+    // New column c of J M^-1 J.T: the unit vector for an inactive constraint, the entries with the active constraints otherwise
+    Eigen::VectorXd col (Eigen::VectorXd::Unit(nc,c));
+    if(active)
+      for(int b=0;b<nc;++b)
+        if(data.constraint_active[(std::size_t)b]) col[b] = internal::JMinvJtEntry(data,c,b);
+    
+    /* Replacing the row and the column c by col adds w e_c' + e_c w', with w = col - JMinvJt.col(c) except for w_c halved.
+     * It is the sum of the update by (e_c + w)/sqrt(2) and the downdate by (e_c - w)/sqrt(2). */
+    Eigen::VectorXd w (col - data.JMinvJt.col(c));
+    w[c] *= 0.5;
+    Eigen::VectorXd up (w), down (-w);
+    up[c] += 1.; down[c] += 1.;
+    up *= std::sqrt(.5); down *= std::sqrt(.5);
+    
+    data.JMinvJt.col(c) = col;
+    data.JMinvJt.row(c) = col.transpose();
+    
+    data.llt_JMinvJt.rankUpdate(up,1.);
+    data.llt_JMinvJt.rankUpdate(down,-1.);
+    if(data.llt_JMinvJt.info() != Eigen::Success)
+      data.llt_JMinvJt.compute(data.JMinvJt);
+  }
+  
+  inline const Eigen::VectorXd & solveContactDynamics(const Model & model,
+                                                      Data & data,
+                                                      const Eigen::MatrixXd & J,
+                                                      const Eigen::VectorXd & gamma)
+  {
+    assert(J.cols() == model.nv);
+    assert(J.rows() == gamma.size());
+    assert(J.rows() == data.JMinvJt.rows());
+    
+    Eigen::VectorXd & a = data.ddq;
+    Eigen::VectorXd & lambda_c = data.lambda_c;
+    
+    // Compute the Lagrange Multipliers, which vanish for the inactive constraints
+    lambda_c.noalias() = -J*data.torque_residual;
+    lambda_c -= gamma;
+    for(int c=0;c<(int)lambda_c.size();++c)
+      if(!data.constraint_active[(std::size_t)c]) lambda_c[c] = 0.;
+    data.llt_JMinvJt.solveInPlace (lambda_c);
+    
+    // Compute the joint acceleration
+    a.noalias() = J.transpose() * lambda_c;
+    cholesky::solve (model, data, a);
+    a += data.torque_residual;
+    
+    return a;
+  }
+  
+  struct ContactAbaJacobianStep : public fusion::JointVisitor<ContactAbaJacobianStep>
+  {
+    typedef boost::fusion::vector<Data &> ArgsType;
+    
+    JOINT_VISITOR_INIT(ContactAbaJacobianStep);
+    
+    template<typename JointModel>
+    static void algo(const JointModelBase<JointModel> & jmodel,
+                     JointDataBase<typename JointModel::JointData> & jdata,
+                     Data & data)
+    {
+      typedef typename SizeDepType<JointModel::NV>::template ColsReturn<Data::Matrix6x>::Type ColsBlock;
+      const SE3 & oMi = data.oMi[jmodel.id()];
+      jmodel.jointCols(data.J) = oMi.act(jdata.S());
+      
+      ColsBlock oU = jmodel.jointCols(data.contact_oU);
+      forceSet::se3Action(oMi,jdata.U(),oU);
+      ColsBlock oUDinv = jmodel.jointCols(data.contact_oUDinv);
+      forceSet::se3Action(oMi,jdata.UDinv(),oUDinv);
+    }
+  };
+  
+  struct ContactAbaBackwardStep : public fusion::JointVisitor<ContactAbaBackwardStep>
+  {
+    typedef boost::fusion::vector<Data &,
+                                  Eigen::Matrix<double,6,6> &,
+                                  const int
+                                  > ArgsType;
+    
+    JOINT_VISITOR_INIT(ContactAbaBackwardStep);
+    
+    template<typename JointModel>
+    static void algo(const JointModelBase<JointModel> & jmodel,
+                     JointDataBase<typename JointModel::JointData> & jdata,
+                     Data & data,
+                     Eigen::Matrix<double,6,6> & F,
+                     const int col)
+    {
+      /*
+       * F is the set of contact forces, minus the bias forces of the subtree, in the world frame.
+       * ddq[i] = Dinv J_i' F
+       * F -= oU_i ddq[i]
+       */
+      Eigen::Block<Eigen::MatrixXd> ddq_i = data.contact_ddq.block(jmodel.idx_v(),col,jmodel.nv(),6);
+      ddq_i.noalias() = jdata.Dinv() * (jmodel.jointCols(data.J).transpose() * F);
+      F.noalias() -= jmodel.jointCols(data.contact_oU) * ddq_i;
+    }
+  };
+  
+  struct ContactAbaForwardStep : public fusion::JointVisitor<ContactAbaForwardStep>
+  {
+    typedef boost::fusion::vector<Data &,
+                                  Eigen::Matrix<double,6,6> &,
+                                  const int
+                                  > ArgsType;
+    
+    JOINT_VISITOR_INIT(ContactAbaForwardStep);
+    
+    template<typename JointModel>
+    static void algo(const JointModelBase<JointModel> & jmodel,
+                     JointDataBase<typename JointModel::JointData> & jdata,
+                     Data & data,
+                     Eigen::Matrix<double,6,6> & A,
+                     const int col)
+    {
+      /*
+       * A is the set of accelerations of the parent, in the world frame.
+       * ddq[i] = ddq[i] - oUDinv_i' A
+       * A += J_i ddq[i]
+       */
+      typedef Eigen::Matrix<double,JointModel::NV,6> MatrixNV6;
+      MatrixNV6 ddq_i (data.contact_ddq.block(jmodel.idx_v(),col,jmodel.nv(),6));
+      ddq_i.noalias() -= jmodel.jointCols(data.contact_oUDinv).transpose() * A;
+      A.noalias() += jmodel.jointCols(data.J) * ddq_i;
+    }
+  };
+  
+  struct ContactAbaForwardStep2 : public fusion::JointVisitor<ContactAbaForwardStep2>
+  {
+    typedef boost::fusion::vector<const Model &,
+                                  Data &,
+                                  const Eigen::VectorXd &
+                                  > ArgsType;
+    
+    JOINT_VISITOR_INIT(ContactAbaForwardStep2);
+    
+    template<typename JointModel>
+    static void algo(const JointModelBase<JointModel> & jmodel,
+                     JointDataBase<typename JointModel::JointData> & jdata,
+                     const Model & model,
+                     Data & data,
+                     const Eigen::VectorXd & ddq_c)
+    {
+      typedef Eigen::Matrix<double,JointModel::NV,1> VectorNV;
+      const Model::JointIndex & i = jmodel.id();
+      const Motion & oa_parent = data.oa_contact[model.parents[i]];
+      
+      VectorNV ddq_i (jmodel.jointVelocitySelector(ddq_c));
+      ddq_i.noalias() -= jmodel.jointCols(data.contact_oUDinv).transpose() * oa_parent.toVector();
+      jmodel.jointVelocitySelector(data.ddq) += ddq_i;
+      data.oa_contact[i] = oa_parent + Motion(Motion::Vector6(jmodel.jointCols(data.J) * ddq_i));
+    }
+  };
+  
+  inline const Eigen::VectorXd & forwardDynamicsRecursive(const Model & model,
+                                                          Data & data,
+                                                          const Eigen::VectorXd & q,
+                                                          const Eigen::VectorXd & v,
+                                                          const Eigen::VectorXd & tau,
+                                                          const std::vector<Model::JointIndex> & contacts,
+                                                          const Eigen::VectorXd & gamma)
+  {
+    typedef Eigen::Matrix<double,6,6> Matrix6;
+    const int nc = (int)contacts.size();
+    assert(q.size() == model.nq);
+    assert(v.size() == model.nv);
+    assert(tau.size() == model.nv);
+    assert(gamma.size() == 6*nc);
+    
+    // Free acceleration
+    aba(model, data, q, v, tau);
+    for(Model::JointIndex i=1;i<(Model::JointIndex)model.nbody;++i)
+      ContactAbaJacobianStep::run(model.joints[i],data.joints[i],ContactAbaJacobianStep::ArgsType(data));
+    
+    // Unit contact forces, propagated backward along the chain of each contact
+    data.contact_ddq.setZero(model.nv,6*nc);
+    Matrix6 F, A;
+    for(int c=0;c<nc;++c)
+    {
+      const Matrix6 I6 (Matrix6::Identity());
+      forceSet::se3Action(data.oMi[contacts[(std::size_t)c]],I6,F);
+      for(Model::JointIndex i=contacts[(std::size_t)c];i>0;i=model.parents[i])
+        ContactAbaBackwardStep::run(model.joints[i],data.joints[i],ContactAbaBackwardStep::ArgsType(data,F,6*c));
+    }
+    
+    // J M^-1 J.T, evaluated forward along the chain of each contact, and the free contact accelerations.
+    std::vector<Model::JointIndex> & chain = data.contact_chain;
+    data.JMinvJt.resize(6*nc,6*nc);
+    data.lambda_c.resize(6*nc);
+    for(int c2=0;c2<nc;++c2)
+    {
+      const Model::JointIndex & joint = contacts[(std::size_t)c2];
+      const SE3 & oMc = data.oMi[joint];
+      chain.clear();
+      for(Model::JointIndex i=joint;i>0;i=model.parents[i]) chain.push_back(i);
+      
+      for(int c=0;c<=c2;++c)
+      {
+        A.setZero();
+        for(std::size_t k=chain.size();k>0;--k)
+          ContactAbaForwardStep::run(model.joints[chain[k-1]],data.joints[chain[k-1]],
+                                     ContactAbaForwardStep::ArgsType(data,A,6*c));
+        for(int k=0;k<6;++k)
+          data.JMinvJt.col(6*c+k).segment<6>(6*c2) = oMc.actInv(Motion(A.col(k))).toVector();
+        if(c < c2) data.JMinvJt.block<6,6>(6*c,6*c2) = data.JMinvJt.block<6,6>(6*c2,6*c).transpose();
+      }
+      
+      Motion::Vector6 Jddq (Motion::Vector6::Zero());
+      const int last_dof = idx_v(model.joints[joint])+nv(model.joints[joint])-1;
+      for(int k=last_dof;k>=0;k=data.parents_fromRow[(Model::Index)k])
+        Jddq += data.J.col(k) * data.ddq[k];
+      data.lambda_c.segment<6>(6*c2) = -gamma.segment<6>(6*c2) - oMc.actInv(Motion(Jddq)).toVector();
+    }
+    
+    // Contact forces
+    data.llt_JMinvJt.compute(data.JMinvJt);
+    data.llt_JMinvJt.solveInPlace(data.lambda_c);
+    
+    // Joint accelerations due to the contact forces
+    Eigen::VectorXd & ddq_c = data.contact_ddq_lambda;
+    ddq_c.noalias() = data.contact_ddq * data.lambda_c;
+    data.oa_contact[0].setZero();
+    for(Model::JointIndex i=1;i<(Model::JointIndex)model.nbody;++i)
+      ContactAbaForwardStep2::run(model.joints[i],data.joints[i],
+                                  ContactAbaForwardStep2::ArgsType(model,data,ddq_c));
+    
+    return data.ddq;
+  }
+  
+} // namespace se3
 
 #endif // ifndef __se3_dynamics_hpp__
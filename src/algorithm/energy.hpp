@@ -56,6 +56,40 @@ namespace se3 {
                   Data & data,
                   const Eigen::VectorXd & q,
                   const bool update_kinematics = true);
+  
+  ///
+  /// \brief Computes the kinetic energy of the system, with an arbitrary scalar type.
+  ///        The result is accessible through data.kinetic_energy.
+  ///
+  /// \param[in] model The model structure of the rigid body system, converted to Scalar.
+  /// \param[in] data The data structure of the rigid body system.
+  /// \param[in] q The joint configuration vector (dim model.nq).
+  /// \param[in] v The joint velocity vector (dim model.nv).
+  ///
+  /// \return The kinetic energy of the system in [J].
+  ///
+  template<typename Scalar>
+  inline Scalar
+  kineticEnergy(const ModelTpl<Scalar> & model,
+                DataTpl<Scalar> & data,
+                const Eigen::Matrix<Scalar,Eigen::Dynamic,1> & q,
+                const Eigen::Matrix<Scalar,Eigen::Dynamic,1> & v);
+  
+  ///
+  /// \brief Computes the potential energy of the system, with an arbitrary scalar type.
+  ///        The result is accessible through data.potential_energy.
+  ///
+  /// \param[in] model The model structure of the rigid body system, converted to Scalar.
+  /// \param[in] data The data structure of the rigid body system.
+  /// \param[in] q The joint configuration vector (dim model.nq).
+  ///
+  /// \return The potential energy of the system in [J].
+  ///
+  template<typename Scalar>
+  inline Scalar
+  potentialEnergy(const ModelTpl<Scalar> & model,
+                  DataTpl<Scalar> & data,
+                  const Eigen::Matrix<Scalar,Eigen::Dynamic,1> & q);
 }
 
 /* --- Details -------------------------------------------------------------------- */
@@ -104,5 +138,41 @@ namespace se3
     
     return data.potential_energy;
   }
+  
+  template<typename Scalar>
+  inline Scalar
+  kineticEnergy(const ModelTpl<Scalar> & model,
+                DataTpl<Scalar> & data,
+                const Eigen::Matrix<Scalar,Eigen::Dynamic,1> & q,
+                const Eigen::Matrix<Scalar,Eigen::Dynamic,1> & v)
+  {
+    typedef typename ModelTpl<Scalar>::JointIndex JointIndex;
+    
+    forwardKinematics(model,data,q,v);
+    
+    data.kinetic_energy = Scalar(0);
+    for(JointIndex i=1;i<(JointIndex)(model.nbody);++i)
+      data.kinetic_energy += model.inertias[i].vtiv(data.v[i]);
+    
+    data.kinetic_energy *= Scalar(.5);
+    return data.kinetic_energy;
+  }
+  
+  template<typename Scalar>
+  inline Scalar
+  potentialEnergy(const ModelTpl<Scalar> & model,
+                  DataTpl<Scalar> & data,
+                  const Eigen::Matrix<Scalar,Eigen::Dynamic,1> & q)
+  {
+    typedef typename ModelTpl<Scalar>::JointIndex JointIndex;
+    
+    forwardKinematics(model,data,q);
+    
+    data.potential_energy = Scalar(0);
+    for(JointIndex i=1;i<(JointIndex)(model.nbody);++i)
+      data.potential_energy += model.inertias[i].mass() * data.oMi[i].act(model.inertias[i].lever()).dot(model.gravity.linear());
+    
+    return data.potential_energy;
+  }
 }
 #endif // __se3_energy_hpp__
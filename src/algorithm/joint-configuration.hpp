@@ -36,6 +36,19 @@ namespace se3
                                    const Eigen::VectorXd & q,
                                    const Eigen::VectorXd & v);
 
+  /**
+   * @brief      Integrate a configuration for the specified model for a tangent vector during one unit time, without allocation
+   *
+   * @param[in]  model   Model that must be integrated
+   * @param[in]  q       Initial configuration (size model.nq)
+   * @param[in]  v       Velocity (size model.nv)
+   * @param[out] qout    The integrated configuration (size model.nq, it may be q itself)
+   */
+  inline void integrate(const Model & model,
+                        const Eigen::VectorXd & q,
+                        const Eigen::VectorXd & v,
+                        Eigen::VectorXd & qout);
+
 
   /**
    * @brief      Interpolate the model between two configurations
@@ -51,6 +64,21 @@ namespace se3
                                      const Eigen::VectorXd & q1,
                                      const double u);
 
+  /**
+   * @brief      Interpolate the model between two configurations, without allocation
+   *
+   * @param[in]  model   Model to be interpolated
+   * @param[in]  q0      Initial configuration vector (size model.nq)
+   * @param[in]  q1      Final configuration vector (size model.nq)
+   * @param[in]  u       u in [0;1] position along the interpolation.
+   * @param[out] qout    The interpolated configuration (size model.nq, it may be q0 or q1 itself)
+   */
+  inline void interpolate(const Model & model,
+                          const Eigen::VectorXd & q0,
+                          const Eigen::VectorXd & q1,
+                          const double u,
+                          Eigen::VectorXd & qout);
+
 
   /**
    * @brief      Compute the tangent vector that must be integrated during one unit time to go from q0 to q1
@@ -64,6 +92,19 @@ namespace se3
                                        const Eigen::VectorXd & q0,
                                        const Eigen::VectorXd & q1);
 
+  /**
+   * @brief      Compute the tangent vector that must be integrated during one unit time to go from q0 to q1, without allocation
+   *
+   * @param[in]  model   Model to be differentiated
+   * @param[in]  q0      Initial configuration (size model.nq)
+   * @param[in]  q1      Wished configuration (size model.nq)
+   * @param[out] v       The corresponding velocity (size model.nv)
+   */
+  inline void differentiate(const Model & model,
+                            const Eigen::VectorXd & q0,
+                            const Eigen::VectorXd & q1,
+                            Eigen::VectorXd & v);
+
 
   /**
    * @brief      Distance between two configuration vectors
@@ -77,6 +118,19 @@ namespace se3
                                   const Eigen::VectorXd & q0,
                                   const Eigen::VectorXd & q1);
 
+  /**
+   * @brief      Distance between two configuration vectors, without allocation
+   *
+   * @param[in]  model      Model we want to compute the distance
+   * @param[in]  q0         Configuration 0 (size model.nq)
+   * @param[in]  q1         Configuration 1 (size model.nq)
+   * @param[out] distances  The corresponding distances for each joint (size model.nbody-1 = number of joints)
+   */
+  inline void distance(const Model & model,
+                       const Eigen::VectorXd & q0,
+                       const Eigen::VectorXd & q1,
+                       Eigen::VectorXd & distances);
+
 
   /**
    * @brief      Generate a configuration vector uniformly sampled among provided limits.
@@ -93,6 +147,19 @@ namespace se3
                                              const Eigen::VectorXd & lowerLimits,
                                              const Eigen::VectorXd & upperLimits);
 
+  /**
+   * @brief      Generate a configuration vector uniformly sampled among provided limits, without allocation.
+   *
+   * @param[in]  model        Model we want to generate a configuration vector of
+   * @param[in]  lowerLimits  Joints lower limits
+   * @param[in]  upperLimits  Joints upper limits
+   * @param[out] q            The resulted configuration vector (size model.nq)
+   */
+  inline void randomConfiguration(const Model & model,
+                                  const Eigen::VectorXd & lowerLimits,
+                                  const Eigen::VectorXd & upperLimits,
+                                  Eigen::VectorXd & q);
+
   /**
    * @brief      Generate a configuration vector uniformly sampled among the joint limits of the specified Model.
    *
@@ -131,18 +198,28 @@ namespace se3
 
   };
 
-  inline Eigen::VectorXd
+  inline void
   integrate(const Model & model,
-                 const Eigen::VectorXd & q,
-                 const Eigen::VectorXd & v)
+            const Eigen::VectorXd & q,
+            const Eigen::VectorXd & v,
+            Eigen::VectorXd & qout)
   {
-    Eigen::VectorXd integ(model.nq);
+    assert(qout.size() == model.nq);
     for( Model::JointIndex i=1; i<(Model::JointIndex) model.nbody; ++i )
     {
       IntegrateStep::run(model.joints[i],
-                          IntegrateStep::ArgsType (q, v, integ)
+                          IntegrateStep::ArgsType (q, v, qout)
                           );
     }
+  }
+
+  inline Eigen::VectorXd
+  integrate(const Model & model,
+                 const Eigen::VectorXd & q,
+                 const Eigen::VectorXd & v)
+  {
+    Eigen::VectorXd integ(model.nq);
+    integrate(model, q, v, integ);
     return integ;
   }
 
@@ -169,19 +246,30 @@ namespace se3
 
   };
 
-  inline Eigen::VectorXd
+  inline void
   interpolate(const Model & model,
-               const Eigen::VectorXd & q0,
-               const Eigen::VectorXd & q1,
-               const double u)
+              const Eigen::VectorXd & q0,
+              const Eigen::VectorXd & q1,
+              const double u,
+              Eigen::VectorXd & qout)
   {
-    Eigen::VectorXd interp(model.nq);
+    assert(qout.size() == model.nq);
     for( Model::JointIndex i=1; i<(Model::JointIndex) model.nbody; ++i )
     {
       InterpolateStep::run(model.joints[i],
-                            InterpolateStep::ArgsType (q0, q1, u, interp)
+                            InterpolateStep::ArgsType (q0, q1, u, qout)
                             );
     }
+  }
+
+  inline Eigen::VectorXd
+  interpolate(const Model & model,
+               const Eigen::VectorXd & q0,
+               const Eigen::VectorXd & q1,
+               const double u)
+  {
+    Eigen::VectorXd interp(model.nq);
+    interpolate(model, q0, q1, u, interp);
     return interp;
   }
 
@@ -205,18 +293,28 @@ namespace se3
 
   };
 
-  inline Eigen::VectorXd
+  inline void
   differentiate(const Model & model,
-                     const Eigen::VectorXd & q0,
-                     const Eigen::VectorXd & q1)
+                const Eigen::VectorXd & q0,
+                const Eigen::VectorXd & q1,
+                Eigen::VectorXd & v)
   {
-    Eigen::VectorXd diff(model.nv);
+    assert(v.size() == model.nv);
     for( Model::JointIndex i=1; i<(Model::JointIndex) model.nbody; ++i )
     {
       DifferentiateStep::run(model.joints[i],
-                              DifferentiateStep::ArgsType (q0, q1, diff)
+                              DifferentiateStep::ArgsType (q0, q1, v)
                               );
     }
+  }
+
+  inline Eigen::VectorXd
+  differentiate(const Model & model,
+                     const Eigen::VectorXd & q0,
+                     const Eigen::VectorXd & q1)
+  {
+    Eigen::VectorXd diff(model.nv);
+    differentiate(model, q0, q1, diff);
     return diff;
   }
 
@@ -242,18 +340,28 @@ namespace se3
 
   };
 
-  inline Eigen::VectorXd
+  inline void
   distance(const Model & model,
-               const Eigen::VectorXd & q0,
-               const Eigen::VectorXd & q1)
+           const Eigen::VectorXd & q0,
+           const Eigen::VectorXd & q1,
+           Eigen::VectorXd & distances)
   {
-    Eigen::VectorXd distances(model.nbody-1);
+    assert(distances.size() == model.nbody-1);
     for( Model::JointIndex i=1; i<(Model::JointIndex) model.nbody; ++i )
     {
       DistanceStep::run(model.joints[i],
                         DistanceStep::ArgsType (i-1, q0, q1, distances)
                         );
     }
+  }
+
+  inline Eigen::VectorXd
+  distance(const Model & model,
+               const Eigen::VectorXd & q0,
+               const Eigen::VectorXd & q1)
+  {
+    Eigen::VectorXd distances(model.nbody-1);
+    distance(model, q0, q1, distances);
     return distances;
   }
 
@@ -280,16 +388,24 @@ namespace se3
 
   };
 
-  inline Eigen::VectorXd
-  randomConfiguration(const Model & model, const Eigen::VectorXd & lowerLimits, const Eigen::VectorXd & upperLimits)
+  inline void
+  randomConfiguration(const Model & model, const Eigen::VectorXd & lowerLimits, const Eigen::VectorXd & upperLimits,
+                      Eigen::VectorXd & q)
   {
-    Eigen::VectorXd q(model.nq);
+    assert(q.size() == model.nq);
     for( Model::JointIndex i=1; i<(Model::JointIndex) model.nbody; ++i )
     {
       RandomConfiguration::run(model.joints[i],
                                RandomConfiguration::ArgsType ( q, lowerLimits, upperLimits)
                                );
     }
+  }
+
+  inline Eigen::VectorXd
+  randomConfiguration(const Model & model, const Eigen::VectorXd & lowerLimits, const Eigen::VectorXd & upperLimits)
+  {
+    Eigen::VectorXd q(model.nq);
+    randomConfiguration(model, lowerLimits, upperLimits, q);
     return q;
   }
 
@@ -19,6 +19,8 @@
 #define __se3_kinematics_hpp__
 
 #include "pinocchio/multibody/model.hpp"
+#include "pinocchio/multibody/model-tpl.hpp"
+#include "pinocchio/multibody/data-soa.hpp"
 
 namespace se3
 {
@@ -44,6 +46,29 @@ namespace se3
                                 Data & data,
                                 const Eigen::VectorXd & q);
 
+  ///
+  /// \brief Update the joint placement according to the current joint configuration, only recomputing the
+  ///        subtrees supported by the joints whose configuration has changed since the previous call.
+  ///
+  /// \note The configuration of the previous call is stored in data.q_fk, and the joints whose placement has been
+  ///       recomputed are flagged in data.oMi_updated. The placements of the other joints are reused as is: if
+  ///       data.oMi has been modified by another algorithm in the meantime, call se3::resetIncrementalKinematics first.
+  ///
+  /// \param[in] model The model structure of the rigid body system.
+  /// \param[in] data The data structure of the rigid body system.
+  /// \param[in] q The joint configuration (vector dim model.nq).
+  ///
+  inline void forwardKinematicsIncremental(const Model & model,
+                                           Data & data,
+                                           const Eigen::VectorXd & q);
+
+  ///
+  /// \brief Forget the configuration stored by se3::forwardKinematicsIncremental, so that its next call recomputes all the placements.
+  ///
+  /// \param[in] data The data structure of the rigid body system.
+  ///
+  inline void resetIncrementalKinematics(Data & data);
+
   ///
   /// \brief Update the joint placement according to the current joint configuration and velocity.
   ///
@@ -71,6 +96,43 @@ namespace se3
                                 const Eigen::VectorXd & v,
                                 const Eigen::VectorXd & a);
 
+  ///
+  /// \brief Update the joint placement according to the current joint configuration, in a data structure with the structure-of-arrays layout.
+  ///
+  /// \param[in] model The model structure of the rigid body system.
+  /// \param[in] data The SoA data structure of the rigid body system.
+  /// \param[in] q The joint configuration (vector dim model.nq).
+  ///
+  inline void forwardKinematics(const Model & model,
+                                DataSoA & data,
+                                const Eigen::VectorXd & q);
+
+  ///
+  /// \brief Update the joint placements according to the current joint configuration, with an arbitrary scalar type.
+  ///
+  /// \param[in] model The model structure of the rigid body system, converted to Scalar.
+  /// \param[in] data The data structure of the rigid body system.
+  /// \param[in] q The joint configuration (vector dim model.nq).
+  ///
+  template<typename Scalar>
+  inline void forwardKinematics(const ModelTpl<Scalar> & model,
+                                DataTpl<Scalar> & data,
+                                const Eigen::Matrix<Scalar,Eigen::Dynamic,1> & q);
+
+  ///
+  /// \brief Update the joint placements and velocities according to the current joint configuration and velocity, with an arbitrary scalar type.
+  ///
+  /// \param[in] model The model structure of the rigid body system, converted to Scalar.
+  /// \param[in] data The data structure of the rigid body system.
+  /// \param[in] q The joint configuration (vector dim model.nq).
+  /// \param[in] v The joint velocity (vector dim model.nv).
+  ///
+  template<typename Scalar>
+  inline void forwardKinematics(const ModelTpl<Scalar> & model,
+                                DataTpl<Scalar> & data,
+                                const Eigen::Matrix<Scalar,Eigen::Dynamic,1> & q,
+                                const Eigen::Matrix<Scalar,Eigen::Dynamic,1> & v);
+
 } // namespace se3 
 
 /* --- Details -------------------------------------------------------------------- */
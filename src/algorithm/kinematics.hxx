@@ -99,6 +99,120 @@ namespace se3
     }
   }
 
+  struct ForwardKinematicIncrementalStep : public fusion::JointVisitor<ForwardKinematicIncrementalStep>
+  {
+    typedef boost::fusion::vector<const se3::Model &,
+                                  se3::Data &,
+                                  const Eigen::VectorXd &,
+                                  int &
+                                  > ArgsType;
+
+    JOINT_VISITOR_INIT (ForwardKinematicIncrementalStep);
+
+    template<typename JointModel>
+    static void algo(const se3::JointModelBase<JointModel> & jmodel,
+                     se3::JointDataBase<typename JointModel::JointData> & jdata,
+                     const se3::Model & model,
+                     se3::Data & data,
+                     const Eigen::VectorXd & q,
+                     int & last_updated)
+    {
+      const Model::JointIndex & i = jmodel.id();
+      const Model::JointIndex & parent = model.parents[i];
+
+      // The joints to update are the subtrees [j,lastChild[j]] of the joints j that have moved.
+      if (jmodel.jointConfigSelector(q) != jmodel.jointConfigSelector(data.q_fk))
+        last_updated = std::max(last_updated,data.lastChild[i]);
+
+      data.oMi_updated[i] = ((int)i <= last_updated);
+      if (!data.oMi_updated[i]) return;
+
+      jmodel.calc (jdata.derived (), q);
+
+      data.liMi[i] = model.jointPlacements[i] * jdata.M ();
+
+      if (parent>0)
+        data.oMi[i] = data.oMi[parent] * data.liMi[i];
+      else
+        data.oMi[i] = data.liMi[i];
+    }
+
+  };
+
+  inline void
+  forwardKinematicsIncremental(const Model & model,
+                               Data & data,
+                               const Eigen::VectorXd & q)
+  {
+    assert(q.size() == model.nq && "The configuration vector is not of right size");
+
+    int last_updated = 0;
+    for (Model::JointIndex i=1; i < (Model::JointIndex) model.nbody; ++i)
+    {
+      ForwardKinematicIncrementalStep::run(model.joints[i], data.joints[i],
+                                           ForwardKinematicIncrementalStep::ArgsType (model,data,q,last_updated)
+                                           );
+    }
+    data.q_fk = q;
+  }
+
+  inline void resetIncrementalKinematics(Data & data)
+  {
+    data.q_fk.fill(std::numeric_limits<double>::quiet_NaN());
+  }
+
+  struct ForwardKinematicZeroSoAStep : public fusion::JointVisitor<ForwardKinematicZeroSoAStep>
+  {
+    typedef boost::fusion::vector<const se3::Model &,
+                                  se3::DataSoA &,
+                                  const Eigen::VectorXd &
+                                  > ArgsType;
+
+    JOINT_VISITOR_INIT (ForwardKinematicZeroSoAStep);
+
+    template<typename JointModel>
+    static void algo(const se3::JointModelBase<JointModel> & jmodel,
+                     se3::JointDataBase<typename JointModel::JointData> & jdata,
+                     const se3::Model & model,
+                     se3::DataSoA & data,
+                     const Eigen::VectorXd & q)
+    {
+      const Model::JointIndex & i = jmodel.id();
+      const Model::JointIndex & parent = model.parents[i];
+
+      jmodel.calc (jdata.derived (), q);
+
+      const SE3 liMi = model.jointPlacements[i] * jdata.M ();
+      data.setLiMi(i,liMi);
+
+      if (parent>0)
+      {
+        const long ip = (long)parent;
+        data.oMi_translations.col((long)i) = data.oMi_translations.col(ip)
+                                             + data.oMi_rotations.middleCols<3>(3*ip) * liMi.translation();
+        data.oMi_rotations.middleCols<3>(3*(long)i).noalias() = data.oMi_rotations.middleCols<3>(3*ip) * liMi.rotation();
+      }
+      else
+        data.setOMi(i,liMi);
+    }
+
+  };
+
+  inline void
+  forwardKinematics(const Model & model,
+                    DataSoA & data,
+                    const Eigen::VectorXd & q)
+  {
+    assert(q.size() == model.nq && "The configuration vector is not of right size");
+
+    for (Model::JointIndex i=1; i < (Model::JointIndex) model.nbody; ++i)
+    {
+      ForwardKinematicZeroSoAStep::run(model.joints[i], data.joints[i],
+                                       ForwardKinematicZeroSoAStep::ArgsType (model,data,q)
+                                       );
+    }
+  }
+
   struct ForwardKinematicFirstStep : public fusion::JointVisitor<ForwardKinematicFirstStep>
   {
     typedef boost::fusion::vector<const se3::Model &,
@@ -213,6 +327,45 @@ namespace se3
                                       ForwardKinematicSecondStep::ArgsType(model,data,q,v,a));
     }
   }
+
+  template<typename Scalar>
+  inline void
+  forwardKinematics(const ModelTpl<Scalar> & model, DataTpl<Scalar> & data,
+                    const Eigen::Matrix<Scalar,Eigen::Dynamic,1> & q)
+  {
+    typedef typename ModelTpl<Scalar>::JointIndex JointIndex;
+    assert(q.size() == model.nq && "The configuration vector is not of right size");
+
+    for( JointIndex i=1; i < (JointIndex) model.nbody; ++i )
+    {
+      const JointIndex & parent = model.parents[i];
+      data.liMi[i] = model.jointPlacements[i] * jointTransform(model,i,q);
+      data.oMi[i] = data.oMi[parent] * data.liMi[i];
+    }
+  }
+
+  template<typename Scalar>
+  inline void
+  forwardKinematics(const ModelTpl<Scalar> & model, DataTpl<Scalar> & data,
+                    const Eigen::Matrix<Scalar,Eigen::Dynamic,1> & q,
+                    const Eigen::Matrix<Scalar,Eigen::Dynamic,1> & v)
+  {
+    typedef typename ModelTpl<Scalar>::JointIndex JointIndex;
+    typedef typename DataTpl<Scalar>::Motion Motion;
+    assert(q.size() == model.nq && "The configuration vector is not of right size");
+    assert(v.size() == model.nv && "The velocity vector is not of right size");
+
+    data.v[0].setZero();
+    for( JointIndex i=1; i < (JointIndex) model.nbody; ++i )
+    {
+      const JointIndex & parent = model.parents[i];
+      data.liMi[i] = model.jointPlacements[i] * jointTransform(model,i,q);
+      data.oMi[i] = data.oMi[parent] * data.liMi[i];
+      data.v[i] = Motion(model.S[i] * v.segment(model.idx_vs[i],model.nvs[i]));
+      if(parent>0) data.v[i] += data.liMi[i].actInv(data.v[parent]);
+    }
+  }
+
 } // namespace se3
 
 #endif // ifndef __se3_kinematics_hxx__
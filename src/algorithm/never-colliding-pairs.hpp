@@ -0,0 +1,137 @@
+//
+// Copyright (c) 2016 CNRS
+//
+// This file is part of Pinocchio
+// Pinocchio is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// Pinocchio is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Lesser Public License for more details. You should have
+// received a copy of the GNU Lesser General Public License along with
+// Pinocchio If not, see
+// <http://www.gnu.org/licenses/>.
+
+
+#ifndef __se3_never_colliding_pairs_hpp__
+#define __se3_never_colliding_pairs_hpp__
+
+#include "pinocchio/multibody/model.hpp"
+#include "pinocchio/multibody/geometry.hpp"
+#include "pinocchio/algorithm/joint-configuration.hpp"
+#include "pinocchio/algorithm/collisions.hpp"
+#include "pinocchio/multibody/parser/srdf.hpp"
+
+#include <map>
+
+namespace se3
+{
+
+  ///
+  /// \brief Sample random configurations within the given limits, and find the pairs of bodies whose collision objects
+  ///        never collided, among the collision pairs of data_geom.
+  ///        This offline analysis is meant to be written with srdf::writeDisabledCollisionsToSrdf, so that the runtime
+  ///        list of collision pairs can be shrunk with GeometryData::addCollisionPairsFromSrdf.
+  ///
+  /// \note The result is only statistical: a pair of bodies colliding in a small region of the configuration space may be
+  ///       missed. The number of samples should be large (typically several tens of thousands).
+  ///
+  /// \param[in] model The model structure of the rigid body system.
+  /// \param[in] data The data structure of the rigid body system.
+  /// \param[in] model_geom The geometry model containing the collision objects.
+  /// \param[in] data_geom The geometry data containing the collision pairs to test.
+  /// \param[in] nsamples The number of random configurations.
+  /// \param[in] lowerLimits The lower limits of the sampled configurations (dim model.nq).
+  /// \param[in] upperLimits The upper limits of the sampled configurations (dim model.nq).
+  /// \param[out] never_colliding_pairs The pairs of bodies, sorted and with the lowest joint index first.
+  ///
+  inline void computeNeverCollidingBodyPairs(const Model & model,
+                                             Data & data,
+                                             const GeometryModel & model_geom,
+                                             GeometryData & data_geom,
+                                             const std::size_t nsamples,
+                                             const Eigen::VectorXd & lowerLimits,
+                                             const Eigen::VectorXd & upperLimits,
+                                             srdf::BodyPairsVector & never_colliding_pairs);
+
+  ///
+  /// \brief Same as computeNeverCollidingBodyPairs, sampling within the position limits of the model.
+  ///
+  inline void computeNeverCollidingBodyPairs(const Model & model,
+                                             Data & data,
+                                             const GeometryModel & model_geom,
+                                             GeometryData & data_geom,
+                                             const std::size_t nsamples,
+                                             srdf::BodyPairsVector & never_colliding_pairs);
+
+} // namespace se3
+
+/* --- Details -------------------------------------------------------------------- */
+namespace se3
+{
+
+  inline void computeNeverCollidingBodyPairs(const Model & model,
+                                             Data & data,
+                                             const GeometryModel & model_geom,
+                                             GeometryData & data_geom,
+                                             const std::size_t nsamples,
+                                             const Eigen::VectorXd & lowerLimits,
+                                             const Eigen::VectorXd & upperLimits,
+                                             srdf::BodyPairsVector & never_colliding_pairs)
+  {
+    assert(lowerLimits.size() == model.nq && upperLimits.size() == model.nq);
+    typedef std::map<srdf::BodyPair, bool> BodyPairsMap;
+
+    // The body pair of each collision pair, and whether one of its collision pairs has already collided
+    BodyPairsMap body_pairs_colliding;
+    std::vector<srdf::BodyPair> body_pairs(data_geom.nCollisionPairs);
+    for (std::size_t k = 0; k < data_geom.nCollisionPairs; ++k)
+    {
+      const GeometryData::CollisionPair_t & pair = data_geom.collision_pairs[k];
+      const Model::JointIndex joint1 = model_geom.collision_objects[pair.first].parent;
+      const Model::JointIndex joint2 = model_geom.collision_objects[pair.second].parent;
+      body_pairs[k] = srdf::BodyPair(std::min(joint1, joint2), std::max(joint1, joint2));
+      body_pairs_colliding[body_pairs[k]] = false;
+    }
+
+    Eigen::VectorXd q(model.nq);
+    fcl::CollisionResult collision_result;
+    for (std::size_t s = 0; s < nsamples; ++s)
+    {
+      randomConfiguration(model, lowerLimits, upperLimits, q);
+      updateGeometryPlacements(model, data, model_geom, data_geom, q);
+
+      for (std::size_t k = 0; k < data_geom.nCollisionPairs; ++k)
+      {
+        bool & colliding = body_pairs_colliding[body_pairs[k]];
+        if (!colliding)
+          colliding = data_geom.computeCollision(data_geom.collision_pairs[k], collision_result);
+      }
+    }
+
+    never_colliding_pairs.clear();
+    for (BodyPairsMap::const_iterator it = body_pairs_colliding.begin(); it != body_pairs_colliding.end(); ++it)
+    {
+      // Disabling the pairs of a body with itself is meaningless in a SRDF file
+      if (!it->second && it->first.first != it->first.second)
+        never_colliding_pairs.push_back(it->first);
+    }
+  }
+
+  inline void computeNeverCollidingBodyPairs(const Model & model,
+                                             Data & data,
+                                             const GeometryModel & model_geom,
+                                             GeometryData & data_geom,
+                                             const std::size_t nsamples,
+                                             srdf::BodyPairsVector & never_colliding_pairs)
+  {
+    computeNeverCollidingBodyPairs(model, data, model_geom, data_geom, nsamples,
+                                   model.lowerPositionLimit, model.upperPositionLimit, never_colliding_pairs);
+  }
+
+} // namespace se3
+
+#endif // ifndef __se3_never_colliding_pairs_hpp__
@@ -49,6 +49,29 @@ namespace se3
                                       const Eigen::VectorXd & q
                                       );
 
+  /**
+   * @brief      Update the position of the extra frames attached to the joints flagged in data.oMi_updated
+   *
+   * @param[in]  model  The kinematic model
+   * @param      data   Data associated to model
+   * @warning    The function forwardKinematicsIncremental should have been called first, and this function after each of its calls
+   */
+  inline void framesForwardKinematicsIncremental(const Model & model,
+                                                 Data & data
+                                                 );
+
+  /**
+   * @brief      Compute incrementally the kinematics of the model, then the position of the operational frames whose joint has moved
+   *
+   * @param[in]  model                    The kinematic model
+   * @param      data                     Data associated to model
+   * @param[in]  q                        Configuration vector
+   */
+  inline void framesForwardKinematicsIncremental(const Model & model,
+                                                 Data & data,
+                                                 const Eigen::VectorXd & q
+                                                 );
+
   /**
    * @brief      Return the jacobian of the operational frame in the world frame or
      in the local frame depending on the template argument.
@@ -69,6 +92,49 @@ namespace se3
                                Data::Matrix6x & J
                                );
  
+  /**
+   * @brief      Update the position of each operational frame, with an arbitrary scalar type
+   *
+   * @param[in]  model  The kinematic model, converted to Scalar
+   * @param      data   Data associated to model
+   * @warning    One of the templated forwardKinematics should have been called first
+   */
+  template<typename Scalar>
+  inline void framesForwardKinematics(const ModelTpl<Scalar> & model,
+                                      DataTpl<Scalar> & data
+                                      );
+
+  /**
+   * @brief      Compute the kinematics of the model, then the position of each operational frame, with an arbitrary scalar type
+   *
+   * @param[in]  model                    The kinematic model, converted to Scalar
+   * @param      data                     Data associated to model
+   * @param[in]  q                        Configuration vector
+   */
+  template<typename Scalar>
+  inline void framesForwardKinematics(const ModelTpl<Scalar> & model,
+                                      DataTpl<Scalar> & data,
+                                      const Eigen::Matrix<Scalar,Eigen::Dynamic,1> & q
+                                      );
+
+  /**
+   * @brief      Return the jacobian of the operational frame expressed in the local frame, with an arbitrary scalar type
+   *
+   * @param[in]  model       The kinematic model, converted to Scalar
+   * @param[in]  data        Data associated to model
+   * @param[in]  frame_id    Id of the operational frame we want to compute the jacobian
+   * @param      J           The filled Jacobian Matrix (dim 6 x model.nv). Only the columns of the joints supporting
+   *                         the frame are written, the other ones should be set to zero first.
+   *
+   * @warning    One of the templated framesForwardKinematics should have been called first
+   */
+  template<typename Scalar>
+  inline void getFrameJacobian(const ModelTpl<Scalar> & model,
+                               const DataTpl<Scalar> & data,
+                               const typename ModelTpl<Scalar>::FrameIndex frame_id,
+                               typename ModelTpl<Scalar>::Matrix6x & J
+                               );
+
 } // namespace se3
 
 /* --- Details -------------------------------------------------------------------- */
@@ -98,6 +164,27 @@ namespace se3
   
   
   
+  inline void framesForwardKinematicsIncremental(const Model & model,
+                                                 Data & data
+                                                 )
+  {
+    for (Model::FrameIndex i=0; i < (Model::FrameIndex) model.nOperationalFrames; ++i)
+    {
+      const Model::JointIndex & parent = model.operational_frames[i].parent;
+      if (data.oMi_updated[parent])
+        data.oMof[i] = (data.oMi[parent] * model.operational_frames[i].placement);
+    }
+  }
+  
+  inline void framesForwardKinematicsIncremental(const Model & model,
+                                                 Data & data,
+                                                 const Eigen::VectorXd & q
+                                                 )
+  {
+    forwardKinematicsIncremental(model, data, q);
+    framesForwardKinematicsIncremental(model, data);
+  }
+  
   template<bool localFrame>
   inline void getFrameJacobian(const Model & model,
                                const Data & data,
@@ -126,6 +213,46 @@ namespace se3
     }
   }
 
+  template<typename Scalar>
+  inline void framesForwardKinematics(const ModelTpl<Scalar> & model,
+                                      DataTpl<Scalar> & data
+                                      )
+  {
+    for (std::size_t i=0; i < (std::size_t) model.nOperationalFrames; ++i)
+      data.oMof[i] = data.oMi[model.frameParents[i]] * model.framePlacements[i];
+  }
+
+  template<typename Scalar>
+  inline void framesForwardKinematics(const ModelTpl<Scalar> & model,
+                                      DataTpl<Scalar> & data,
+                                      const Eigen::Matrix<Scalar,Eigen::Dynamic,1> & q
+                                      )
+  {
+    forwardKinematics(model, data, q);
+    framesForwardKinematics(model, data);
+  }
+
+  template<typename Scalar>
+  inline void getFrameJacobian(const ModelTpl<Scalar> & model,
+                               const DataTpl<Scalar> & data,
+                               const typename ModelTpl<Scalar>::FrameIndex frame_id,
+                               typename ModelTpl<Scalar>::Matrix6x & J)
+  {
+    typedef typename ModelTpl<Scalar>::JointIndex JointIndex;
+    typedef typename ModelTpl<Scalar>::SE3 SE3;
+    typedef typename ModelTpl<Scalar>::Motion Motion;
+    assert( J.rows() == 6 );
+    assert( J.cols() == model.nv );
+
+    const SE3 & oMframe = data.oMof[frame_id];
+    for(JointIndex i=model.frameParents[frame_id];i>0;i=model.parents[i])
+    {
+      const SE3 fMi (oMframe.actInv(data.oMi[i]));
+      for(int k=0;k<model.nvs[i];++k)
+        J.col(model.idx_vs[i]+k) = fMi.act(Motion(model.S[i].col(k))).toVector();
+    }
+  }
+
 } // namespace se3
 
 #endif // ifndef __se3_operational_frames_hpp__
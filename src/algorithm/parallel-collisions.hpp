@@ -0,0 +1,367 @@
+//
+// Copyright (c) 2016 CNRS
+//
+// This file is part of Pinocchio
+// Pinocchio is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// Pinocchio is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Lesser Public License for more details. You should have
+// received a copy of the GNU Lesser General Public License along with
+// Pinocchio If not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef __se3_parallel_collisions_hpp__
+#define __se3_parallel_collisions_hpp__
+
+#include "pinocchio/algorithm/parallel.hpp"
+#include "pinocchio/algorithm/collisions.hpp"
+
+#include <boost/shared_ptr.hpp>
+#include <boost/atomic.hpp>
+
+namespace se3
+{
+  namespace parallel
+  {
+    ///
+    /// \brief Pool of worker threads, each of them owning its own se3::Data and se3::GeometryData structures.
+    ///
+    class GeometryPool : public DataPool
+    {
+    public:
+      typedef Eigen::Matrix<bool,Eigen::Dynamic,1> VectorXb;
+
+      ///
+      /// \brief Create a pool of nthreads workers. The collision pairs of each worker are copied from geom_data.
+      ///
+      /// \param[in] model The model structure of the rigid body system.
+      /// \param[in] geom The geometry model containing the collision objects.
+      /// \param[in] geom_data A geometry data containing the list of collision pairs to check.
+      /// \param[in] nthreads The number of workers. By default, the number of hardware threads.
+      ///
+      GeometryPool(const Model & model, const GeometryModel & geom, const GeometryData & geom_data,
+                   const int nthreads = ThreadPool::defaultNumThreads())
+        : DataPool(model,nthreads)
+        , geom(geom)
+      {
+        geom_datas.reserve((std::size_t)size());
+        for(int w=0;w<size();++w)
+          geom_datas.push_back(boost::shared_ptr<GeometryData>(new GeometryData(data(w),geom)));
+        setCollisionPairs(geom_data);
+      }
+
+      /// \brief Copy the collision pairs and the collision options of geom_data into the geometry data of each worker.
+      void setCollisionPairs(const GeometryData & geom_data)
+      {
+        for(std::size_t w=0;w<geom_datas.size();++w)
+        {
+          GeometryData & worker_geom_data = *geom_datas[w];
+          worker_geom_data.removeAllCollisionPairs();
+          worker_geom_data.setBooleanOnlyCollisions(geom_data.boolean_only_collisions);
+          worker_geom_data.setBroadPhase(geom_data.broad_phase_enabled);
+          for(std::size_t k=0;k<geom_data.collision_pairs.size();++k)
+            worker_geom_data.addCollisionPair(geom_data.collision_pairs[k]);
+        }
+      }
+
+      /// \brief Geometry data structure owned by the given worker.
+      GeometryData & geometryData(const int worker) { return *geom_datas[(std::size_t)worker]; }
+
+      /// \brief A const reference to the geometry model.
+      const GeometryModel & geom;
+
+      /// \brief Geometry data structure of each worker.
+      std::vector< boost::shared_ptr<GeometryData> > geom_datas;
+
+    }; // class GeometryPool
+
+    ///
+    /// \brief Pool of worker threads sharing the collision pairs of a single se3::GeometryData.
+    ///
+    /// \note Contrary to GeometryPool, which evaluates many configurations, this pool evaluates the FCL queries of the
+    ///       pairs of one configuration concurrently. Each pair writes its own entry of the results of the GeometryData,
+    ///       so that the results are the same, and in the same order, as with the sequential algorithms.
+    ///
+    class NarrowPhasePool : boost::noncopyable
+    {
+    public:
+      ///
+      /// \brief Create a pool of nthreads workers.
+      ///
+      /// \param[in] nthreads The number of workers. By default, the number of hardware threads.
+      ///
+      explicit NarrowPhasePool(const int nthreads = ThreadPool::defaultNumThreads())
+        : threads(nthreads)
+        , collision_result_buffers((std::size_t)threads.size())
+        , pair_status()
+      {}
+
+      /// \brief Number of workers of the pool.
+      int size() const { return threads.size(); }
+
+      /// \brief The worker threads.
+      ThreadPool threads;
+
+      /// \brief FCL result of each worker, used in the boolean only mode of GeometryData.
+      std::vector<fcl::CollisionResult> collision_result_buffers;
+
+      ///
+      /// \brief Collision status of each pair, one byte per pair. GeometryData::collision_status stores one bit per pair,
+      ///        which cannot be written concurrently: it is copied from this vector at the end of the computations.
+      ///
+      std::vector<char> pair_status;
+
+    }; // class NarrowPhasePool
+
+    ///
+    /// \brief Same as se3::computeCollisions, with the collision pairs distributed over the workers of the pool.
+    ///
+    /// \param[in] pool The pool of workers.
+    /// \param[in] data_geom The geometry data containing the placements of the collision objects and the collision pairs.
+    /// \param[in] stopAtFirstCollision If true, the workers stop as soon as the first colliding pair (in the order of
+    ///            collision_pairs) is known. The pairs after this one are reported as not colliding.
+    ///
+    /// \return True if at least one collision pair is in collision.
+    ///
+    inline bool computeCollisions(NarrowPhasePool & pool,
+                                  GeometryData & data_geom,
+                                  const bool stopAtFirstCollision = false);
+
+    ///
+    /// \brief Update the placement of the geometry objects, then call computeCollisions(pool,data_geom,stopAtFirstCollision).
+    ///
+    /// \param[in] pool The pool of workers.
+    /// \param[in] model The model structure of the rigid body system.
+    /// \param[in] data The data structure of the rigid body system.
+    /// \param[in] model_geom The geometry model containing the collision objects.
+    /// \param[in] data_geom The geometry data containing the placements of the collision objects and the collision pairs.
+    /// \param[in] q The joint configuration vector (dim model.nq).
+    /// \param[in] stopAtFirstCollision If true, stop at the first colliding pair.
+    ///
+    /// \return True if at least one collision pair is in collision.
+    ///
+    inline bool computeCollisions(NarrowPhasePool & pool,
+                                  const Model & model,
+                                  Data & data,
+                                  const GeometryModel & model_geom,
+                                  GeometryData & data_geom,
+                                  const Eigen::VectorXd & q,
+                                  const bool stopAtFirstCollision = false);
+
+    ///
+    /// \brief Same as se3::computeDistances, with the collision pairs distributed over the workers of the pool.
+    ///
+    /// \param[in] pool The pool of workers.
+    /// \param[in] data_geom The geometry data containing the placements of the collision objects and the collision pairs.
+    ///
+    inline void computeDistances(NarrowPhasePool & pool,
+                                 GeometryData & data_geom);
+
+    ///
+    /// \brief Update the placement of the geometry objects, then call computeDistances(pool,data_geom).
+    ///
+    /// \param[in] pool The pool of workers.
+    /// \param[in] model The model structure of the rigid body system.
+    /// \param[in] data The data structure of the rigid body system.
+    /// \param[in] model_geom The geometry model containing the collision objects.
+    /// \param[in] data_geom The geometry data containing the placements of the collision objects and the collision pairs.
+    /// \param[in] q The joint configuration vector (dim model.nq).
+    ///
+    inline void computeDistances(NarrowPhasePool & pool,
+                                 const Model & model,
+                                 Data & data,
+                                 const GeometryModel & model_geom,
+                                 GeometryData & data_geom,
+                                 const Eigen::VectorXd & q);
+
+    ///
+    /// \brief Evaluate se3::computeCollisions on each configuration, concurrently.
+    ///
+    /// \param[in] pool The pool of workers.
+    /// \param[in] q The joint configurations, stacked column-wise (dim model.nq x nsamples).
+    /// \param[out] res For each configuration, true if at least one collision pair is in collision.
+    /// \param[in] stopAtFirstCollision If true, the test of a configuration stops at its first collision.
+    ///
+    inline void computeCollisionsBatch(GeometryPool & pool,
+                                       const Eigen::MatrixXd & q,
+                                       GeometryPool::VectorXb & res,
+                                       const bool stopAtFirstCollision = true);
+
+  } // namespace parallel
+} // namespace se3
+
+/* --- Details -------------------------------------------------------------------- */
+namespace se3
+{
+  namespace parallel
+  {
+    struct CollisionsBatchJob : public Job
+    {
+      CollisionsBatchJob(GeometryPool & pool, const Eigen::MatrixXd & q,
+                         GeometryPool::VectorXb & res, const bool stopAtFirstCollision)
+      : pool(pool), q(q), res(res), stopAtFirstCollision(stopAtFirstCollision) {}
+
+      void operator() (const int worker, const int k)
+      {
+        pool.q[(std::size_t)worker] = q.col(k);
+        res[k] = computeCollisions(pool.model,pool.data(worker),pool.geom,pool.geometryData(worker),
+                                   pool.q[(std::size_t)worker],stopAtFirstCollision);
+      }
+
+      GeometryPool & pool;
+      const Eigen::MatrixXd & q;
+      GeometryPool::VectorXb & res;
+      const bool stopAtFirstCollision;
+    };
+
+    inline void computeCollisionsBatch(GeometryPool & pool,
+                                       const Eigen::MatrixXd & q,
+                                       GeometryPool::VectorXb & res,
+                                       const bool stopAtFirstCollision)
+    {
+      assert(q.rows() == pool.model.nq);
+
+      res.resize(q.cols());
+      CollisionsBatchJob job(pool,q,res,stopAtFirstCollision);
+      pool.threads.run(job,(int)q.cols());
+    }
+
+    struct CollisionPairsJob : public Job
+    {
+      ///
+      /// \param[in] candidates Indexes of the pairs to check, or NULL to check all the pairs.
+      ///
+      CollisionPairsJob(NarrowPhasePool & pool, GeometryData & data_geom,
+                        const std::vector<GeometryData::Index> * candidates,
+                        const int npairs, const bool stopAtFirstCollision)
+      : pool(pool), data_geom(data_geom), candidates(candidates)
+      , stopAtFirstCollision(stopAtFirstCollision), first_collision(npairs) {}
+
+      GeometryData::Index pairIndex(const int k) const
+      {
+        return candidates ? (*candidates)[(std::size_t)k] : (GeometryData::Index)k;
+      }
+
+      void operator() (const int worker, const int k)
+      {
+        // The pairs after the first known collision are not needed
+        if(stopAtFirstCollision && k > first_collision.load(boost::memory_order_relaxed))
+          return;
+
+        const GeometryData::Index cpt = pairIndex(k);
+        fcl::CollisionResult & result = data_geom.boolean_only_collisions
+                                      ? pool.collision_result_buffers[(std::size_t)worker]
+                                      : data_geom.collision_results[cpt].fcl_collision_result;
+        const bool pair_in_collision = data_geom.computeCollision(data_geom.collision_pairs[cpt], result);
+        pool.pair_status[cpt] = pair_in_collision;
+
+        if(pair_in_collision)
+        {
+          int first = first_collision.load(boost::memory_order_relaxed);
+          while(k < first && !first_collision.compare_exchange_weak(first,k,boost::memory_order_relaxed));
+        }
+      }
+
+      NarrowPhasePool & pool;
+      GeometryData & data_geom;
+      const std::vector<GeometryData::Index> * candidates;
+      const bool stopAtFirstCollision;
+
+      /// \brief Smallest index k of a colliding pair found so far.
+      boost::atomic<int> first_collision;
+    };
+
+    inline bool computeCollisions(NarrowPhasePool & pool,
+                                  GeometryData & data_geom,
+                                  const bool stopAtFirstCollision)
+    {
+      assert(data_geom.collision_status.size() == data_geom.collision_pairs.size()
+             && "The results are not synchronized with the collision pairs.");
+
+      const std::vector<GeometryData::Index> * candidates = NULL;
+      if(data_geom.broad_phase_enabled)
+      {
+        data_geom.updateBroadPhase();
+        candidates = &data_geom.broad_phase_candidates;
+      }
+      const int npairs = candidates ? (int)candidates->size() : (int)data_geom.collision_pairs.size();
+
+      data_geom.resetCollisionResults();
+      pool.pair_status.resize(data_geom.collision_pairs.size());
+
+      CollisionPairsJob job(pool,data_geom,candidates,npairs,stopAtFirstCollision);
+      pool.threads.run(job,npairs);
+
+      // Gather the status of the pairs, in the order of the sequential algorithm
+      const int first_collision = job.first_collision.load();
+      const int last = stopAtFirstCollision ? std::min(first_collision+1,npairs) : npairs;
+      for(int k=0;k<last;++k)
+      {
+        const GeometryData::Index cpt = job.pairIndex(k);
+        data_geom.collision_status[cpt] = (pool.pair_status[cpt] != 0);
+      }
+      if(!data_geom.boolean_only_collisions)
+      {
+        // Some pairs after the first collision may have been checked concurrently
+        for(int k=last;k<npairs;++k)
+          data_geom.collision_results[job.pairIndex(k)].fcl_collision_result.clear();
+      }
+
+      return first_collision < npairs;
+    }
+
+    inline bool computeCollisions(NarrowPhasePool & pool,
+                                  const Model & model,
+                                  Data & data,
+                                  const GeometryModel & model_geom,
+                                  GeometryData & data_geom,
+                                  const Eigen::VectorXd & q,
+                                  const bool stopAtFirstCollision)
+    {
+      updateGeometryPlacements(model, data, model_geom, data_geom, q);
+      return computeCollisions(pool, data_geom, stopAtFirstCollision);
+    }
+
+    struct DistancePairsJob : public Job
+    {
+      DistancePairsJob(GeometryData & data_geom) : data_geom(data_geom) {}
+
+      void operator() (const int, const int k)
+      {
+        data_geom.computeDistance(data_geom.collision_pairs[(std::size_t)k],
+                                  data_geom.distance_results[(std::size_t)k].fcl_distance_result);
+      }
+
+      GeometryData & data_geom;
+    };
+
+    inline void computeDistances(NarrowPhasePool & pool,
+                                 GeometryData & data_geom)
+    {
+      assert(data_geom.distance_results.size() == data_geom.collision_pairs.size()
+             && "The results are not synchronized with the collision pairs.");
+
+      DistancePairsJob job(data_geom);
+      pool.threads.run(job,(int)data_geom.collision_pairs.size());
+    }
+
+    inline void computeDistances(NarrowPhasePool & pool,
+                                 const Model & model,
+                                 Data & data,
+                                 const GeometryModel & model_geom,
+                                 GeometryData & data_geom,
+                                 const Eigen::VectorXd & q)
+    {
+      updateGeometryPlacements(model, data, model_geom, data_geom, q);
+      computeDistances(pool, data_geom);
+    }
+
+  } // namespace parallel
+} // namespace se3
+
+#endif // ifndef __se3_parallel_collisions_hpp__
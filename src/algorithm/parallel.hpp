@@ -0,0 +1,267 @@
+//
+// Copyright (c) 2016 CNRS
+//
+// This file is part of Pinocchio
+// Pinocchio is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// Pinocchio is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Lesser Public License for more details. You should have
+// received a copy of the GNU Lesser General Public License along with
+// Pinocchio If not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef __se3_parallel_hpp__
+#define __se3_parallel_hpp__
+
+#include "pinocchio/multibody/model.hpp"
+#include "pinocchio/algorithm/rnea.hpp"
+#include "pinocchio/algorithm/aba.hpp"
+#include "pinocchio/algorithm/crba.hpp"
+#include "pinocchio/algorithm/jacobian.hpp"
+#include "pinocchio/tools/thread-pool.hpp"
+
+namespace se3
+{
+  namespace parallel
+  {
+    ///
+    /// \brief Pool of worker threads, each of them owning its own se3::Data structure.
+    ///
+    /// \note The batched algorithms of se3::parallel take the samples (configurations, velocities, ...) stacked column-wise
+    ///       and evaluate them concurrently, each worker using only its own Data.
+    ///
+    class DataPool : boost::noncopyable
+    {
+    public:
+      ///
+      /// \brief Create a pool of nthreads workers for the given model.
+      ///
+      /// \param[in] model The model structure of the rigid body system.
+      /// \param[in] nthreads The number of workers. By default, the number of hardware threads.
+      ///
+      explicit DataPool(const Model & model, const int nthreads = ThreadPool::defaultNumThreads())
+        : model(model)
+        , threads(nthreads)
+        , datas((std::size_t)threads.size(), Data(model))
+        , q((std::size_t)threads.size(), Eigen::VectorXd(model.nq))
+        , v((std::size_t)threads.size(), Eigen::VectorXd(model.nv))
+        , a((std::size_t)threads.size(), Eigen::VectorXd(model.nv))
+      {}
+
+      /// \brief Number of workers of the pool.
+      int size() const { return threads.size(); }
+
+      /// \brief Data structure owned by the given worker.
+      Data & data(const int worker) { return datas[(std::size_t)worker]; }
+      const Data & data(const int worker) const { return datas[(std::size_t)worker]; }
+
+      /// \brief A const reference to the reference model.
+      const Model & model;
+
+      /// \brief The worker threads.
+      ThreadPool threads;
+
+      /// \brief Data structure of each worker. Data holds fixed-size Eigen members, hence the aligned allocator.
+      std::vector<Data, Eigen::aligned_allocator<Data> > datas;
+
+      /// \brief Per worker copies of the sample currently processed (the algorithms take Eigen::VectorXd arguments).
+      std::vector<Eigen::VectorXd> q, v, a;
+
+    }; // class DataPool
+
+    ///
+    /// \brief Evaluate se3::rnea on each sample, concurrently.
+    ///
+    /// \param[in] pool The pool of workers.
+    /// \param[in] q The joint configurations, stacked column-wise (dim model.nq x nsamples).
+    /// \param[in] v The joint velocities, stacked column-wise (dim model.nv x nsamples).
+    /// \param[in] a The joint accelerations, stacked column-wise (dim model.nv x nsamples).
+    /// \param[out] tau The joint torques of each sample, stacked column-wise (dim model.nv x nsamples).
+    ///
+    inline void rneaBatch(DataPool & pool,
+                          const Eigen::MatrixXd & q,
+                          const Eigen::MatrixXd & v,
+                          const Eigen::MatrixXd & a,
+                          Eigen::MatrixXd & tau);
+
+    ///
+    /// \brief Evaluate se3::aba on each sample, concurrently.
+    ///
+    /// \param[in] pool The pool of workers.
+    /// \param[in] q The joint configurations, stacked column-wise (dim model.nq x nsamples).
+    /// \param[in] v The joint velocities, stacked column-wise (dim model.nv x nsamples).
+    /// \param[in] tau The joint torques, stacked column-wise (dim model.nv x nsamples).
+    /// \param[out] ddq The joint accelerations of each sample, stacked column-wise (dim model.nv x nsamples).
+    ///
+    inline void abaBatch(DataPool & pool,
+                         const Eigen::MatrixXd & q,
+                         const Eigen::MatrixXd & v,
+                         const Eigen::MatrixXd & tau,
+                         Eigen::MatrixXd & ddq);
+
+    ///
+    /// \brief Evaluate se3::crba on each sample, concurrently.
+    ///
+    /// \param[in] pool The pool of workers.
+    /// \param[in] q The joint configurations, stacked column-wise (dim model.nq x nsamples).
+    /// \param[out] M The joint space inertia matrices, stacked column-wise (dim model.nv x (model.nv*nsamples)).
+    ///             As for se3::crba, only the upper triangular part of each matrix is filled.
+    ///
+    inline void crbaBatch(DataPool & pool,
+                          const Eigen::MatrixXd & q,
+                          Eigen::MatrixXd & M);
+
+    ///
+    /// \brief Evaluate se3::computeJacobians on each sample, concurrently.
+    ///
+    /// \param[in] pool The pool of workers.
+    /// \param[in] q The joint configurations, stacked column-wise (dim model.nq x nsamples).
+    /// \param[out] J The full model Jacobians expressed in the world frame, stacked column-wise (dim 6 x (model.nv*nsamples)).
+    ///
+    inline void computeJacobiansBatch(DataPool & pool,
+                                      const Eigen::MatrixXd & q,
+                                      Data::Matrix6x & J);
+
+  } // namespace parallel
+} // namespace se3
+
+/* --- Details -------------------------------------------------------------------- */
+namespace se3
+{
+  namespace parallel
+  {
+    struct RneaBatchJob : public Job
+    {
+      RneaBatchJob(DataPool & pool, const Eigen::MatrixXd & q, const Eigen::MatrixXd & v,
+                   const Eigen::MatrixXd & a, Eigen::MatrixXd & tau)
+      : pool(pool), q(q), v(v), a(a), tau(tau) {}
+
+      void operator() (const int worker, const int k)
+      {
+        pool.q[(std::size_t)worker] = q.col(k);
+        pool.v[(std::size_t)worker] = v.col(k);
+        pool.a[(std::size_t)worker] = a.col(k);
+        tau.col(k) = rnea(pool.model,pool.data(worker),
+                          pool.q[(std::size_t)worker],pool.v[(std::size_t)worker],pool.a[(std::size_t)worker]);
+      }
+
+      DataPool & pool;
+      const Eigen::MatrixXd & q, & v, & a;
+      Eigen::MatrixXd & tau;
+    };
+
+    inline void rneaBatch(DataPool & pool,
+                          const Eigen::MatrixXd & q,
+                          const Eigen::MatrixXd & v,
+                          const Eigen::MatrixXd & a,
+                          Eigen::MatrixXd & tau)
+    {
+      assert(q.rows() == pool.model.nq);
+      assert(v.rows() == pool.model.nv && v.cols() == q.cols());
+      assert(a.rows() == pool.model.nv && a.cols() == q.cols());
+
+      tau.resize(pool.model.nv,q.cols());
+      RneaBatchJob job(pool,q,v,a,tau);
+      pool.threads.run(job,(int)q.cols());
+    }
+
+    struct AbaBatchJob : public Job
+    {
+      AbaBatchJob(DataPool & pool, const Eigen::MatrixXd & q, const Eigen::MatrixXd & v,
+                  const Eigen::MatrixXd & tau, Eigen::MatrixXd & ddq)
+      : pool(pool), q(q), v(v), tau(tau), ddq(ddq) {}
+
+      void operator() (const int worker, const int k)
+      {
+        pool.q[(std::size_t)worker] = q.col(k);
+        pool.v[(std::size_t)worker] = v.col(k);
+        pool.a[(std::size_t)worker] = tau.col(k);
+        ddq.col(k) = aba(pool.model,pool.data(worker),
+                         pool.q[(std::size_t)worker],pool.v[(std::size_t)worker],pool.a[(std::size_t)worker]);
+      }
+
+      DataPool & pool;
+      const Eigen::MatrixXd & q, & v, & tau;
+      Eigen::MatrixXd & ddq;
+    };
+
+    inline void abaBatch(DataPool & pool,
+                         const Eigen::MatrixXd & q,
+                         const Eigen::MatrixXd & v,
+                         const Eigen::MatrixXd & tau,
+                         Eigen::MatrixXd & ddq)
+    {
+      assert(q.rows() == pool.model.nq);
+      assert(v.rows() == pool.model.nv && v.cols() == q.cols());
+      assert(tau.rows() == pool.model.nv && tau.cols() == q.cols());
+
+      ddq.resize(pool.model.nv,q.cols());
+      AbaBatchJob job(pool,q,v,tau,ddq);
+      pool.threads.run(job,(int)q.cols());
+    }
+
+    struct CrbaBatchJob : public Job
+    {
+      CrbaBatchJob(DataPool & pool, const Eigen::MatrixXd & q, Eigen::MatrixXd & M)
+      : pool(pool), q(q), M(M) {}
+
+      void operator() (const int worker, const int k)
+      {
+        const int nv = pool.model.nv;
+        pool.q[(std::size_t)worker] = q.col(k);
+        M.middleCols(k*nv,nv) = crba(pool.model,pool.data(worker),pool.q[(std::size_t)worker]);
+      }
+
+      DataPool & pool;
+      const Eigen::MatrixXd & q;
+      Eigen::MatrixXd & M;
+    };
+
+    inline void crbaBatch(DataPool & pool,
+                          const Eigen::MatrixXd & q,
+                          Eigen::MatrixXd & M)
+    {
+      assert(q.rows() == pool.model.nq);
+
+      M.resize(pool.model.nv,pool.model.nv*q.cols());
+      CrbaBatchJob job(pool,q,M);
+      pool.threads.run(job,(int)q.cols());
+    }
+
+    struct JacobiansBatchJob : public Job
+    {
+      JacobiansBatchJob(DataPool & pool, const Eigen::MatrixXd & q, Data::Matrix6x & J)
+      : pool(pool), q(q), J(J) {}
+
+      void operator() (const int worker, const int k)
+      {
+        const int nv = pool.model.nv;
+        pool.q[(std::size_t)worker] = q.col(k);
+        J.middleCols(k*nv,nv) = computeJacobians(pool.model,pool.data(worker),pool.q[(std::size_t)worker]);
+      }
+
+      DataPool & pool;
+      const Eigen::MatrixXd & q;
+      Data::Matrix6x & J;
+    };
+
+    inline void computeJacobiansBatch(DataPool & pool,
+                                      const Eigen::MatrixXd & q,
+                                      Data::Matrix6x & J)
+    {
+      assert(q.rows() == pool.model.nq);
+
+      J.resize(6,pool.model.nv*q.cols());
+      JacobiansBatchJob job(pool,q,J);
+      pool.threads.run(job,(int)q.cols());
+    }
+
+  } // namespace parallel
+} // namespace se3
+
+#endif // ifndef __se3_parallel_hpp__
@@ -0,0 +1,49 @@
+//
+// Copyright (c) 2016 CNRS
+//
+// This file is part of Pinocchio
+// Pinocchio is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// Pinocchio is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Lesser Public License for more details. You should have
+// received a copy of the GNU Lesser General Public License along with
+// Pinocchio If not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef __se3_rnea_batch_hpp__
+#define __se3_rnea_batch_hpp__
+
+#include "pinocchio/multibody/model.hpp"
+#include "pinocchio/multibody/batch-data.hpp"
+
+namespace se3
+{
+  ///
+  /// \brief The Recursive Newton-Euler algorithm evaluated on a batch of samples. The kinematic tree is traversed once,
+  ///        and for each joint the computations of all the samples are carried out together.
+  ///
+  /// \param[in] model The model structure of the rigid body system.
+  /// \param[in] data The batch data structure of the rigid body system.
+  /// \param[in] Q The joint configurations, stacked column-wise (dim model.nq x data.nsamples).
+  /// \param[in] V The joint velocities, stacked column-wise (dim model.nv x data.nsamples).
+  /// \param[in] A The joint accelerations, stacked column-wise (dim model.nv x data.nsamples).
+  ///
+  /// \return The desired joint torques of each sample, stacked column-wise in data.tau.
+  ///
+  inline const Eigen::MatrixXd &
+  rnea(const Model & model, BatchData & data,
+       const Eigen::MatrixXd & Q,
+       const Eigen::MatrixXd & V,
+       const Eigen::MatrixXd & A);
+
+} // namespace se3 
+
+/* --- Details -------------------------------------------------------------------- */
+#include "pinocchio/algorithm/rnea-batch.hxx"
+
+#endif // ifndef __se3_rnea_batch_hpp__
@@ -0,0 +1,139 @@
+//
+// Copyright (c) 2016 CNRS
+//
+// This file is part of Pinocchio
+// Pinocchio is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// Pinocchio is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Lesser Public License for more details. You should have
+// received a copy of the GNU Lesser General Public License along with
+// Pinocchio If not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef __se3_rnea_batch_hxx__
+#define __se3_rnea_batch_hxx__
+
+/// @cond DEV
+
+#include "pinocchio/multibody/visitor.hpp"
+
+namespace se3
+{
+  struct RneaBatchForwardStep : public fusion::JointModelVisitor<RneaBatchForwardStep>
+  {
+    typedef boost::fusion::vector<const se3::Model &,
+                                  se3::BatchData &
+                                  > ArgsType;
+
+    JOINT_MODEL_VISITOR_INIT(RneaBatchForwardStep);
+
+    template<typename JointModel>
+    static void algo(const se3::JointModelBase<JointModel> & jmodel,
+                     const se3::Model & model,
+                     se3::BatchData & data)
+    {
+      typedef typename JointModel::JointData JointData;
+      const Model::JointIndex & i = jmodel.id();
+      const Model::JointIndex & parent = model.parents[i];
+
+      BatchData::Matrix6x & v = data.v[i];
+      BatchData::Matrix6x & a_gf = data.a_gf[i];
+      BatchData::Matrix6x & f = data.f[i];
+      BatchData::Matrix6x & vj = data.tmp;
+
+      // Joint related quantities, which depend on the joint type
+      for(int k=0;k<data.nsamples;++k)
+      {
+        JointDataBase<JointData> & jdata = boost::get<JointData>(data.joints[i][(std::size_t)k]);
+        jmodel.calc(jdata.derived(),data.q[(std::size_t)k],data.v_in[(std::size_t)k]);
+
+        data.liMi[i].set(k,model.jointPlacements[i]*jdata.M());
+        vj.col(k) = Motion(jdata.v()).toVector();
+        a_gf.col(k) = Motion(jdata.S()*jmodel.jointVelocitySelector(data.a_in[(std::size_t)k]) + jdata.c()).toVector();
+      }
+
+      // Spatial quantities, evaluated for all the samples at once
+      v = vj;
+      if(parent>0) batch::motionActionInverse(data.liMi[i],data.v[parent],v);
+
+      batch::motionCross(v,vj,a_gf);
+      batch::motionActionInverse(data.liMi[i],data.a_gf[parent],a_gf);
+
+      vj.setZero(); batch::inertiaAction(model.inertias[i],v,vj);
+      f.setZero(); batch::inertiaAction(model.inertias[i],a_gf,f);
+      batch::forceCross(v,vj,f); // -f_ext
+    }
+
+  };
+
+  struct RneaBatchBackwardStep : public fusion::JointModelVisitor<RneaBatchBackwardStep>
+  {
+    typedef boost::fusion::vector<const Model &,
+                                  BatchData &
+                                  > ArgsType;
+
+    JOINT_MODEL_VISITOR_INIT(RneaBatchBackwardStep);
+
+    template<typename JointModel>
+    static void algo(const JointModelBase<JointModel> & jmodel,
+                     const Model & model,
+                     BatchData & data)
+    {
+      typedef typename JointModel::JointData JointData;
+      const Model::JointIndex & i = jmodel.id();
+      const Model::JointIndex & parent  = model.parents[i];
+
+      for(int k=0;k<data.nsamples;++k)
+      {
+        const JointDataBase<JointData> & jdata = boost::get<JointData>(data.joints[i][(std::size_t)k]);
+        data.tau.block(jmodel.idx_v(),k,jmodel.nv(),1) = jdata.S().transpose()*Force(data.f[i].col(k));
+      }
+      if(parent>0) batch::forceAction(data.liMi[i],data.f[i],data.f[parent]);
+    }
+  };
+
+  inline const Eigen::MatrixXd &
+  rnea(const Model & model, BatchData & data,
+       const Eigen::MatrixXd & Q,
+       const Eigen::MatrixXd & V,
+       const Eigen::MatrixXd & A)
+  {
+    assert(Q.rows() == model.nq && Q.cols() == data.nsamples);
+    assert(V.rows() == model.nv && V.cols() == data.nsamples);
+    assert(A.rows() == model.nv && A.cols() == data.nsamples);
+
+    for(int k=0;k<data.nsamples;++k)
+    {
+      data.q[(std::size_t)k] = Q.col(k);
+      data.v_in[(std::size_t)k] = V.col(k);
+      data.a_in[(std::size_t)k] = A.col(k);
+    }
+
+    data.v[0].setZero();
+    for(int k=0;k<data.nsamples;++k) data.a_gf[0].col(k) = -model.gravity.toVector();
+
+    for( Model::JointIndex i=1;i<(Model::JointIndex)model.nbody;++i )
+    {
+      RneaBatchForwardStep::run(model.joints[i],
+                                RneaBatchForwardStep::ArgsType(model,data));
+    }
+
+    for( Model::JointIndex i=(Model::JointIndex)model.nbody-1;i>0;--i )
+    {
+      RneaBatchBackwardStep::run(model.joints[i],
+                                 RneaBatchBackwardStep::ArgsType(model,data));
+    }
+
+    return data.tau;
+  }
+
+} // namespace se3
+
+/// @endcond
+
+#endif // ifndef __se3_rnea_batch_hxx__
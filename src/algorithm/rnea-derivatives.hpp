@@ -0,0 +1,55 @@
+//
+// Copyright (c) 2016 CNRS
+//
+// This file is part of Pinocchio
+// Pinocchio is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// Pinocchio is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Lesser Public License for more details. You should have
+// received a copy of the GNU Lesser General Public License along with
+// Pinocchio If not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef __se3_rnea_derivatives_hpp__
+#define __se3_rnea_derivatives_hpp__
+
+#include "pinocchio/multibody/model.hpp"
+
+namespace se3
+{
+  ///
+  /// \brief Computes the partial derivatives of the Recursive Newton-Euler algorithm, i.e. of the joint torques
+  ///        \f$ \tau(q,\dot{q},\ddot{q}) \f$ with respect to the joint configuration, velocity and acceleration.
+  ///
+  /// \note The results are stored in data.dtau_dq, data.dtau_dv and data.M (\f$ \frac{\partial \tau}{\partial \ddot{q}} = M(q) \f$,
+  ///       whose both triangular parts are filled). data.tau contains the joint torques, as computed by se3::rnea.
+  ///       The derivative with respect to q is taken along the joint motion subspaces: the variation \f$ \delta q \f$ of the dofs
+  ///       of joint i moves its child body by the spatial velocity \f$ S_i \delta q \f$, so that
+  ///       \f$ \dot{\tau} = \frac{\partial \tau}{\partial q} \dot{q} + \frac{\partial \tau}{\partial \dot{q}} \ddot{q} + \dots \f$.
+  ///       The joints must have a constant motion subspace (all joints but se3::JointModelSphericalZYX): a model containing
+  ///       a se3::JointModelSphericalZYX raises a std::invalid_argument.
+  ///       The complexity is O(nv * d), d being the depth of the kinematic tree.
+  ///
+  /// \param[in] model The model structure of the rigid body system.
+  /// \param[in] data The data structure of the rigid body system.
+  /// \param[in] q The joint configuration vector (dim model.nq).
+  /// \param[in] v The joint velocity vector (dim model.nv).
+  /// \param[in] a The joint acceleration vector (dim model.nv).
+  ///
+  inline void
+  computeRNEADerivatives(const Model & model, Data & data,
+                         const Eigen::VectorXd & q,
+                         const Eigen::VectorXd & v,
+                         const Eigen::VectorXd & a);
+
+} // namespace se3 
+
+/* --- Details -------------------------------------------------------------------- */
+#include "pinocchio/algorithm/rnea-derivatives.hxx"
+
+#endif // ifndef __se3_rnea_derivatives_hpp__
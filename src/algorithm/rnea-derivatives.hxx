@@ -0,0 +1,222 @@
+//
+// Copyright (c) 2016 CNRS
+//
+// This file is part of Pinocchio
+// Pinocchio is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// Pinocchio is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Lesser Public License for more details. You should have
+// received a copy of the GNU Lesser General Public License along with
+// Pinocchio If not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef __se3_rnea_derivatives_hxx__
+#define __se3_rnea_derivatives_hxx__
+
+/// @cond DEV
+
+#include "pinocchio/multibody/visitor.hpp"
+#include "pinocchio/algorithm/rnea.hpp"
+#include "pinocchio/spatial/skew.hpp"
+
+#include <stdexcept>
+
+namespace se3
+{
+  namespace internal
+  {
+    ///
+    /// \brief Matrix of the linear map \f$ x \mapsto Y (x \times v) + x \times^* (Y v) + v \times^* (Y x) \f$, i.e. the
+    ///        variation of the body force \f$ Y a + v \times^* Y v \f$ when the body velocity v varies by x, without the
+    ///        induced variation of the acceleration.
+    ///
+    inline Inertia::Matrix6 inertiaVelocityVariation(const Inertia & Y, const Motion & v)
+    {
+      typedef Inertia::Matrix6 Matrix6;
+      const Matrix6 Ym (Y.matrix());
+      const Force h (Y*v);
+
+      // Motion and force cross product matrices of v.
+      Matrix6 vx (Matrix6::Zero()), vxstar (Matrix6::Zero());
+      vx.topLeftCorner<3,3>() = vx.bottomRightCorner<3,3>() = skew(Motion::Vector3(v.angular()));
+      vx.topRightCorner<3,3>() = skew(Motion::Vector3(v.linear()));
+      vxstar = -vx.transpose();
+
+      // Matrix of x -> x x* h.
+      Matrix6 hx (Matrix6::Zero());
+      hx.topRightCorner<3,3>() = hx.bottomLeftCorner<3,3>() = -skew(Force::Vector3(h.linear()));
+      hx.bottomRightCorner<3,3>() = -skew(Force::Vector3(h.angular()));
+
+      return hx - Ym*vx + vxstar*Ym;
+    }
+  } // namespace internal
+
+  struct ComputeRNEADerivativesForwardStep : public fusion::JointVisitor<ComputeRNEADerivativesForwardStep>
+  {
+    typedef boost::fusion::vector<const se3::Model &,
+                                  se3::Data &,
+                                  const Eigen::VectorXd &,
+                                  const Eigen::VectorXd &,
+                                  const Eigen::VectorXd &
+                                  > ArgsType;
+
+    JOINT_VISITOR_INIT(ComputeRNEADerivativesForwardStep);
+
+    template<typename JointModel>
+    static void algo(const se3::JointModelBase<JointModel> & jmodel,
+                     se3::JointDataBase<typename JointModel::JointData> & jdata,
+                     const se3::Model & model,
+                     se3::Data & data,
+                     const Eigen::VectorXd & q,
+                     const Eigen::VectorXd & v,
+                     const Eigen::VectorXd & a)
+    {
+      const Model::JointIndex & i = jmodel.id();
+      const Model::JointIndex & parent = model.parents[i];
+
+      RneaForwardStep::algo(jmodel,jdata,model,data,q,v,a);
+
+      if(parent>0) data.oMi[i] = data.oMi[parent]*data.liMi[i];
+      else data.oMi[i] = data.liMi[i];
+
+      data.ov[i] = data.oMi[i].act(data.v[i]);
+      data.oa_gf[i] = data.oMi[i].act(data.a_gf[i]);
+      data.Ycrb[i] = data.oMi[i].act(model.inertias[i]);
+      data.of[i] = data.Ycrb[i]*data.oa_gf[i] + data.Ycrb[i].vxiv(data.ov[i]);
+      data.Bcrb[i] = internal::inertiaVelocityVariation(data.Ycrb[i],data.ov[i]);
+
+      jmodel.jointCols(data.J) = data.oMi[i].act(jdata.S());
+
+      const Motion & ov_parent = data.ov[parent];
+      const Motion ov_sum (data.ov[i] + ov_parent);
+      for(int k=jmodel.idx_v();k<jmodel.idx_v()+jmodel.nv();++k)
+      {
+        const Motion Jk (data.J.col(k));
+        const Motion dVdq (ov_parent ^ Jk);
+        data.dVdq.col(k) = dVdq.toVector();
+        data.dAdq.col(k) = ((data.oa_gf[parent] ^ Jk) - (dVdq ^ ov_parent)).toVector();
+        data.dAdv.col(k) = (ov_sum ^ Jk).toVector();
+      }
+    }
+
+  };
+
+  struct ComputeRNEADerivativesBackwardStep : public fusion::JointVisitor<ComputeRNEADerivativesBackwardStep>
+  {
+    typedef boost::fusion::vector<const Model &,
+                                  Data &
+                                  > ArgsType;
+
+    JOINT_VISITOR_INIT(ComputeRNEADerivativesBackwardStep);
+
+    template<typename JointModel>
+    static void algo(const JointModelBase<JointModel> & jmodel,
+                     JointDataBase<typename JointModel::JointData> & jdata,
+                     const Model & model,
+                     Data & data)
+    {
+      /*
+       * For m in joint i and k supporting m (ancestor dofs and dofs of joint i):
+       *   dtau/dq(m,k) = J_m' (Ycrb_i dAdq_k + Bcrb_i dVdq_k)
+       *   dtau/dv(m,k) = J_m' (Ycrb_i dAdv_k + Bcrb_i J_k)
+       *   dtau/da(m,k) = J_m'  Ycrb_i J_k
+       * For k in joint i and r strictly supporting joint i:
+       *   dtau/dq(r,k) = J_r' (J_k x* f_i + Ycrb_i dAdq_k + Bcrb_i dVdq_k), and the same as above for v and a.
+       */
+      typedef Eigen::Matrix<double,6,1> Vector6;
+      const Model::JointIndex & i = jmodel.id();
+      const Model::JointIndex & parent = model.parents[i];
+      const Inertia & Y = data.Ycrb[i];
+      const Inertia::Matrix6 & B = data.Bcrb[i];
+
+      RneaBackwardStep::algo(jmodel,jdata,model,data);
+
+      const int last_dof = jmodel.idx_v()+jmodel.nv()-1;
+      for(int m=jmodel.idx_v();m<=last_dof;++m)
+      {
+        const Motion Jm (data.J.col(m));
+        const Vector6 YJm ((Y*Jm).toVector());
+        const Vector6 BtJm (B.transpose()*data.J.col(m));
+
+        for(int k=last_dof;k>=0;k=data.parents_fromRow[(std::size_t)k])
+        {
+          data.dtau_dq(m,k) = YJm.dot(data.dAdq.col(k)) + BtJm.dot(data.dVdq.col(k));
+          data.dtau_dv(m,k) = YJm.dot(data.dAdv.col(k)) + BtJm.dot(data.J.col(k));
+          data.M(m,k) = YJm.dot(data.J.col(k));
+        }
+      }
+
+      if(parent==0) return;
+
+      for(int k=jmodel.idx_v();k<=last_dof;++k)
+      {
+        const Motion Jk (data.J.col(k));
+        const Vector6 Fq ((Jk.cross(data.of[i]) + Y*Motion(data.dAdq.col(k))).toVector() + B*data.dVdq.col(k));
+        const Vector6 Fv ((Y*Motion(data.dAdv.col(k))).toVector() + B*data.J.col(k));
+        const Vector6 Fa ((Y*Jk).toVector());
+
+        for(int r=data.parents_fromRow[(std::size_t)jmodel.idx_v()];r>=0;r=data.parents_fromRow[(std::size_t)r])
+        {
+          data.dtau_dq(r,k) = data.J.col(r).dot(Fq);
+          data.dtau_dv(r,k) = data.J.col(r).dot(Fv);
+          data.M(r,k) = data.J.col(r).dot(Fa);
+        }
+      }
+
+      data.Ycrb[parent] += Y;
+      data.Bcrb[parent] += B;
+      data.of[parent] += data.of[i];
+    }
+  };
+
+  inline void
+  computeRNEADerivatives(const Model & model, Data & data,
+                         const Eigen::VectorXd & q,
+                         const Eigen::VectorXd & v,
+                         const Eigen::VectorXd & a)
+  {
+    assert(q.size() == model.nq);
+    assert(v.size() == model.nv);
+    assert(a.size() == model.nv);
+
+    // The buffers are only sized by the first call. The entries of the derivatives between dofs which do not support
+    // each other are never written and stay zero.
+    data.dVdq.resize(6,model.nv);
+    data.dAdq.resize(6,model.nv);
+    data.dAdv.resize(6,model.nv);
+    if(data.dtau_dq.rows() != model.nv)
+    {
+      data.dtau_dq.setZero(model.nv,model.nv);
+      data.dtau_dv.setZero(model.nv,model.nv);
+    }
+
+    data.v[0].setZero();
+    data.a_gf[0] = -model.gravity;
+    data.ov[0].setZero();
+    data.oa_gf[0] = -model.gravity;
+
+    for( Model::JointIndex i=1;i<(Model::JointIndex)model.nbody;++i )
+    {
+      if(model.joints[i].which() == JOINT_SPHERICAL_ZYX)
+        throw std::invalid_argument("computeRNEADerivatives: the motion subspace of JointModelSphericalZYX is not constant");
+      ComputeRNEADerivativesForwardStep::run(model.joints[i],data.joints[i],
+                                             ComputeRNEADerivativesForwardStep::ArgsType(model,data,q,v,a));
+    }
+
+    for( Model::JointIndex i=(Model::JointIndex)model.nbody-1;i>0;--i )
+    {
+      ComputeRNEADerivativesBackwardStep::run(model.joints[i],data.joints[i],
+                                              ComputeRNEADerivativesBackwardStep::ArgsType(model,data));
+    }
+  }
+
+} // namespace se3
+
+/// @endcond
+
+#endif // ifndef __se3_rnea_derivatives_hxx__
@@ -19,6 +19,8 @@
 #define __se3_rnea_hpp__
 
 #include "pinocchio/multibody/model.hpp"
+#include "pinocchio/multibody/model-tpl.hpp"
+#include "pinocchio/multibody/data-soa.hpp"
   
 namespace se3
 {
@@ -38,6 +40,23 @@ namespace se3
        const Eigen::VectorXd & q,
        const Eigen::VectorXd & v,
        const Eigen::VectorXd & a);
+
+  ///
+  /// \brief The Recursive Newton-Euler algorithm, working on a data structure with the structure-of-arrays layout.
+  ///
+  /// \param[in] model The model structure of the rigid body system.
+  /// \param[in] data The SoA data structure of the rigid body system.
+  /// \param[in] q The joint configuration vector (dim model.nq).
+  /// \param[in] v The joint velocity vector (dim model.nv).
+  /// \param[in] a The joint acceleration vector (dim model.nv).
+  ///
+  /// \return The desired joint torques stored in data.tau.
+  ///
+  inline const Eigen::VectorXd &
+  rnea(const Model & model, DataSoA & data,
+       const Eigen::VectorXd & q,
+       const Eigen::VectorXd & v,
+       const Eigen::VectorXd & a);
   
   ///
   /// \brief Computes the non-linear effects (Corriolis, centrifual and gravitationnal effects), also called the biais terms \f$ b(q,\dot{q}) \f$ of the Lagrangian dynamics:
@@ -56,6 +75,24 @@ namespace se3
                    const Eigen::VectorXd & q,
                    const Eigen::VectorXd & v);
 
+  ///
+  /// \brief The Recursive Newton-Euler algorithm, with an arbitrary scalar type (e.g. float).
+  ///
+  /// \param[in] model The model structure of the rigid body system, converted to Scalar.
+  /// \param[in] data The data structure of the rigid body system.
+  /// \param[in] q The joint configuration vector (dim model.nq).
+  /// \param[in] v The joint velocity vector (dim model.nv).
+  /// \param[in] a The joint acceleration vector (dim model.nv).
+  ///
+  /// \return The desired joint torques stored in data.tau.
+  ///
+  template<typename Scalar>
+  inline const Eigen::Matrix<Scalar,Eigen::Dynamic,1> &
+  rnea(const ModelTpl<Scalar> & model, DataTpl<Scalar> & data,
+       const Eigen::Matrix<Scalar,Eigen::Dynamic,1> & q,
+       const Eigen::Matrix<Scalar,Eigen::Dynamic,1> & v,
+       const Eigen::Matrix<Scalar,Eigen::Dynamic,1> & a);
+
 } // namespace se3 
 
 /* --- Details -------------------------------------------------------------------- */
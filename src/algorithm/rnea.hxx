@@ -108,6 +108,99 @@ namespace se3
     return data.tau;
   }
   
+  struct RneaSoAForwardStep : public fusion::JointVisitor<RneaSoAForwardStep>
+  {
+    typedef boost::fusion::vector<const se3::Model &,
+                                  se3::DataSoA &,
+                                  const Eigen::VectorXd &,
+                                  const Eigen::VectorXd &,
+                                  const Eigen::VectorXd &
+                                  > ArgsType;
+
+    JOINT_VISITOR_INIT(RneaSoAForwardStep);
+
+    template<typename JointModel>
+    static void algo(const se3::JointModelBase<JointModel> & jmodel,
+                     se3::JointDataBase<typename JointModel::JointData> & jdata,
+                     const se3::Model & model,
+                     se3::DataSoA & data,
+                     const Eigen::VectorXd & q,
+                     const Eigen::VectorXd & v,
+                     const Eigen::VectorXd & a)
+    {
+      const Model::JointIndex & i = jmodel.id();
+      const Model::JointIndex & parent = model.parents[i];
+
+      jmodel.calc(jdata.derived(),q,v);
+
+      const SE3 liMi = model.jointPlacements[i]*jdata.M();
+      data.setLiMi(i,liMi);
+
+      Motion vi(jdata.v());
+      if(parent>0) vi += liMi.actInv(data.v(parent));
+      data.setV(i,vi);
+
+      Motion a_gf = jdata.S()*jmodel.jointVelocitySelector(a) + jdata.c() + (vi ^ jdata.v());
+      a_gf += liMi.actInv(data.a_gf(parent));
+      data.setA_gf(i,a_gf);
+
+      data.setF(i,model.inertias[i]*a_gf + model.inertias[i].vxiv(vi)); // -f_ext
+    }
+
+  };
+
+  struct RneaSoABackwardStep : public fusion::JointVisitor<RneaSoABackwardStep>
+  {
+    typedef boost::fusion::vector<const Model &,
+                                  DataSoA &
+                                  > ArgsType;
+
+    JOINT_VISITOR_INIT(RneaSoABackwardStep);
+
+    template<typename JointModel>
+    static void algo(const JointModelBase<JointModel> & jmodel,
+                     JointDataBase<typename JointModel::JointData> & jdata,
+                     const Model & model,
+                     DataSoA & data)
+    {
+      const Model::JointIndex & i = jmodel.id();
+      const Model::JointIndex & parent  = model.parents[i];
+
+      const Force fi(data.f(i));
+      jmodel.jointVelocitySelector(data.tau) = jdata.S().transpose()*fi;
+      if(parent>0)
+      {
+        const Force fi_parent = data.liMi(i).act(fi);
+        data.f_linear.col((long)parent) += fi_parent.linear();
+        data.f_angular.col((long)parent) += fi_parent.angular();
+      }
+    }
+  };
+
+  inline const Eigen::VectorXd &
+  rnea(const Model & model, DataSoA & data,
+       const Eigen::VectorXd & q,
+       const Eigen::VectorXd & v,
+       const Eigen::VectorXd & a)
+  {
+    data.setV(0,Motion::Zero());
+    data.setA_gf(0,-model.gravity);
+
+    for( Model::JointIndex i=1;i<(Model::JointIndex)model.nbody;++i )
+    {
+      RneaSoAForwardStep::run(model.joints[i],data.joints[i],
+                              RneaSoAForwardStep::ArgsType(model,data,q,v,a));
+    }
+
+    for( Model::JointIndex i=(Model::JointIndex)model.nbody-1;i>0;--i )
+    {
+      RneaSoABackwardStep::run(model.joints[i],data.joints[i],
+                               RneaSoABackwardStep::ArgsType(model,data));
+    }
+
+    return data.tau;
+  }
+
   struct NLEForwardStep : public fusion::JointVisitor<NLEForwardStep>
   {
     typedef boost::fusion::vector< const se3::Model &,
@@ -188,6 +281,50 @@ namespace se3
     
     return data.nle;
   }
+
+  template<typename Scalar>
+  inline const Eigen::Matrix<Scalar,Eigen::Dynamic,1> &
+  rnea(const ModelTpl<Scalar> & model, DataTpl<Scalar> & data,
+       const Eigen::Matrix<Scalar,Eigen::Dynamic,1> & q,
+       const Eigen::Matrix<Scalar,Eigen::Dynamic,1> & v,
+       const Eigen::Matrix<Scalar,Eigen::Dynamic,1> & a)
+  {
+    typedef typename ModelTpl<Scalar>::JointIndex JointIndex;
+    typedef typename DataTpl<Scalar>::Motion Motion;
+    typedef typename DataTpl<Scalar>::Force Force;
+    assert(q.size() == model.nq);
+    assert(v.size() == model.nv);
+    assert(a.size() == model.nv);
+
+    data.v[0].setZero();
+    data.a[0] = -model.gravity;
+
+    for( JointIndex i=1;i<(JointIndex)model.nbody;++i )
+    {
+      const JointIndex & parent = model.parents[i];
+      const int idx_v = model.idx_vs[i], nv = model.nvs[i];
+      const Motion vJ (model.S[i] * v.segment(idx_v,nv));
+
+      data.liMi[i] = model.jointPlacements[i] * jointTransform(model,i,q);
+      data.v[i] = vJ;
+      if(parent>0) data.v[i] += data.liMi[i].actInv(data.v[parent]);
+
+      data.a[i] = Motion(model.S[i] * a.segment(idx_v,nv)) + (data.v[i] ^ vJ);
+      data.a[i] += data.liMi[i].actInv(data.a[parent]);
+
+      data.f[i] = model.inertias[i]*data.a[i] + model.inertias[i].vxiv(data.v[i]);
+    }
+
+    for( JointIndex i=(JointIndex)model.nbody-1;i>0;--i )
+    {
+      const JointIndex & parent = model.parents[i];
+      data.tau.segment(model.idx_vs[i],model.nvs[i]) = model.S[i].transpose() * data.f[i].toVector();
+      if(parent>0) data.f[parent] += data.liMi[i].act(data.f[i]);
+    }
+
+    return data.tau;
+  }
+
 } // namespace se3
 
 /// @endcond
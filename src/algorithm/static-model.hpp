@@ -0,0 +1,170 @@
+//
+// Copyright (c) 2016 CNRS
+//
+// This file is part of Pinocchio
+// Pinocchio is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// Pinocchio is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Lesser Public License for more details. You should have
+// received a copy of the GNU Lesser General Public License along with
+// Pinocchio If not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef __se3_static_model_hpp__
+#define __se3_static_model_hpp__
+
+#include "pinocchio/multibody/model.hpp"
+
+#include <ostream>
+#include <sstream>
+#include <string>
+
+namespace se3
+{
+  ///
+  /// \brief Generate the C++ code of a class specialized for one given kinematic tree.
+  ///
+  /// \note The generated class, named class_name, binds once the joint models and joint datas of the tree to references
+  ///       of their concrete types. Its methods forwardKinematics, rnea, aba and crba then call the steps of the
+  ///       generic algorithms (e.g. se3::RneaForwardStep::algo) joint after joint, with the loops unrolled and
+  ///       without any dispatch through se3::JointModelVariant. The results are stored in the se3::Data given
+  ///       at construction, exactly as with the generic algorithms.
+  ///       The generated code is only valid for a model with the same joint types as model.
+  ///
+  /// \param[in] model The model structure of the rigid body system.
+  /// \param[in] class_name The name of the generated class (defined in the namespace se3::static_model).
+  /// \param[out] os The stream where the code is written.
+  ///
+  inline void generateStaticModel(const Model & model,
+                                  const std::string & class_name,
+                                  std::ostream & os);
+
+} // namespace se3
+
+/* --- Details -------------------------------------------------------------------- */
+namespace se3
+{
+  struct JointTypeNameVisitor : public boost::static_visitor<std::string>
+  {
+    std::string operator()(const JointModelRX &) const { return "se3::JointModelRX"; }
+    std::string operator()(const JointModelRY &) const { return "se3::JointModelRY"; }
+    std::string operator()(const JointModelRZ &) const { return "se3::JointModelRZ"; }
+    std::string operator()(const JointModelRevoluteUnaligned &) const { return "se3::JointModelRevoluteUnaligned"; }
+    std::string operator()(const JointModelSpherical &) const { return "se3::JointModelSpherical"; }
+    std::string operator()(const JointModelSphericalZYX &) const { return "se3::JointModelSphericalZYX"; }
+    std::string operator()(const JointModelPX &) const { return "se3::JointModelPX"; }
+    std::string operator()(const JointModelPY &) const { return "se3::JointModelPY"; }
+    std::string operator()(const JointModelPZ &) const { return "se3::JointModelPZ"; }
+    std::string operator()(const JointModelPrismaticUnaligned &) const { return "se3::JointModelPrismaticUnaligned"; }
+    std::string operator()(const JointModelFreeFlyer &) const { return "se3::JointModelFreeFlyer"; }
+    std::string operator()(const JointModelPlanar &) const { return "se3::JointModelPlanar"; }
+    std::string operator()(const JointModelTranslation &) const { return "se3::JointModelTranslation"; }
+    std::string operator()(const JointModelDense<-1,-1> &) const { return "se3::JointModelDense<-1,-1>"; }
+
+    static std::string run(const JointModelVariant & jmodel)
+    { return boost::apply_visitor(JointTypeNameVisitor(),jmodel); }
+  };
+
+  namespace internal
+  {
+    /// \brief Write one call to Step::algo per joint, in the forward (or backward) order.
+    inline void writeStaticPass(const Model & model, std::ostream & os,
+                                const std::string & step, const std::string & args,
+                                const bool backward)
+    {
+      for(int k=1;k<model.nbody;++k)
+      {
+        const int i = backward ? model.nbody-k : k;
+        os << "        se3::" << step << "::algo<" << JointTypeNameVisitor::run(model.joints[(std::size_t)i])
+           << ">(jmodel_" << i << ",jdata_" << i << "," << args << ");\n";
+      }
+    }
+  } // namespace internal
+
+  inline void generateStaticModel(const Model & model,
+                                  const std::string & class_name,
+                                  std::ostream & os)
+  {
+    std::ostringstream guard;
+    guard << "__se3_static_model_" << class_name << "_hpp__";
+
+    os << "// This file has been generated by se3::generateStaticModel. Do not edit.\n"
+       << "// Model: nbody = " << model.nbody << ", nq = " << model.nq << ", nv = " << model.nv << "\n\n"
+       << "#ifndef " << guard.str() << "\n"
+       << "#define " << guard.str() << "\n\n"
+       << "#include \"pinocchio/multibody/model.hpp\"\n"
+       << "#include \"pinocchio/algorithm/kinematics.hpp\"\n"
+       << "#include \"pinocchio/algorithm/rnea.hpp\"\n"
+       << "#include \"pinocchio/algorithm/aba.hpp\"\n"
+       << "#include \"pinocchio/algorithm/crba.hpp\"\n\n"
+       << "namespace se3\n{\n  namespace static_model\n  {\n"
+       << "    class " << class_name << "\n    {\n    public:\n"
+       << "      enum { nbody = " << model.nbody << ", nq = " << model.nq << ", nv = " << model.nv << " };\n\n";
+
+    // Constructor: bind the joints to their concrete types
+    os << "      " << class_name << "(const se3::Model & model, se3::Data & data)\n"
+       << "      : model(model)\n"
+       << "      , data(data)\n";
+    for(int i=1;i<model.nbody;++i)
+    {
+      const std::string type = JointTypeNameVisitor::run(model.joints[(std::size_t)i]);
+      os << "      , jmodel_" << i << "(boost::get<" << type << " >(model.joints[" << i << "]))\n"
+         << "      , jdata_" << i << "(boost::get<" << type << "::JointData>(data.joints[" << i << "]))\n";
+    }
+    os << "      {\n"
+       << "        assert(model.nbody == nbody && model.nq == nq && model.nv == nv);\n"
+       << "      }\n\n";
+
+    // Forward kinematics
+    os << "      void forwardKinematics(const Eigen::VectorXd & q)\n      {\n"
+       << "        assert(q.size() == nq);\n";
+    internal::writeStaticPass(model,os,"ForwardKinematicZeroStep","model,data,q",false);
+    os << "      }\n\n";
+
+    // RNEA
+    os << "      const Eigen::VectorXd & rnea(const Eigen::VectorXd & q, const Eigen::VectorXd & v, const Eigen::VectorXd & a)\n      {\n"
+       << "        data.v[0].setZero();\n"
+       << "        data.a_gf[0] = -model.gravity;\n";
+    internal::writeStaticPass(model,os,"RneaForwardStep","model,data,q,v,a",false);
+    internal::writeStaticPass(model,os,"RneaBackwardStep","model,data",true);
+    os << "        return data.tau;\n      }\n\n";
+
+    // ABA
+    os << "      const Eigen::VectorXd & aba(const Eigen::VectorXd & q, const Eigen::VectorXd & v, const Eigen::VectorXd & tau)\n      {\n"
+       << "        data.v[0].setZero();\n"
+       << "        data.a[0] = -model.gravity;\n"
+       << "        data.u = tau;\n";
+    internal::writeStaticPass(model,os,"AbaForwardStep1","model,data,q,v",false);
+    internal::writeStaticPass(model,os,"AbaBackwardStep","model,data",true);
+    internal::writeStaticPass(model,os,"AbaForwardStep2","model,data",false);
+    os << "        return data.ddq;\n      }\n\n";
+
+    // CRBA
+    os << "      const Eigen::MatrixXd & crba(const Eigen::VectorXd & q)\n      {\n";
+    internal::writeStaticPass(model,os,"CrbaForwardStep","model,data,q",false);
+    internal::writeStaticPass(model,os,"CrbaBackwardStep","model,data",true);
+    os << "        return data.M;\n      }\n\n";
+
+    // Members
+    os << "    private:\n"
+       << "      const se3::Model & model;\n"
+       << "      se3::Data & data;\n";
+    for(int i=1;i<model.nbody;++i)
+    {
+      const std::string type = JointTypeNameVisitor::run(model.joints[(std::size_t)i]);
+      os << "      const " << type << " & jmodel_" << i << ";\n"
+         << "      " << type << "::JointData & jdata_" << i << ";\n";
+    }
+    os << "    }; // class " << class_name << "\n\n"
+       << "  } // namespace static_model\n} // namespace se3\n\n"
+       << "#endif // ifndef " << guard.str() << "\n";
+  }
+
+} // namespace se3
+
+#endif // ifndef __se3_static_model_hpp__
@@ -0,0 +1,125 @@
+//
+// Copyright (c) 2016 CNRS
+//
+// This file is part of Pinocchio
+// Pinocchio is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// Pinocchio is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Lesser Public License for more details. You should have
+// received a copy of the GNU Lesser General Public License along with
+// Pinocchio If not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef __se3_batch_data_hpp__
+#define __se3_batch_data_hpp__
+
+#include "pinocchio/multibody/model.hpp"
+#include "pinocchio/spatial/act-on-batch.hpp"
+
+namespace se3
+{
+  ///
+  /// \brief Data structure used by the batched algorithms, which evaluate the same
+  ///        quantity on nsamples independent states of the system in a single pass
+  ///        over the kinematic tree.
+  ///
+  /// \note For each joint, the spatial quantities of all the samples are stored
+  ///       contiguously (structure-of-arrays, see se3::batch), so that the joint
+  ///       type is resolved once per joint and not once per joint and per sample.
+  ///
+  class BatchData
+  {
+  public:
+    typedef batch::Matrix6x Matrix6x;
+    typedef batch::SE3Batch SE3Batch;
+
+    /// \brief A const reference to the reference model.
+    const Model & model;
+
+    /// \brief Number of samples processed at once.
+    const int nsamples;
+
+    /// \brief Joint data of each sample: joints[i][k] is the data of joint i for the sample k.
+    std::vector<JointDataVector> joints;
+
+    /// \brief Joint configurations of each sample (copies of the columns of the input matrix).
+    std::vector<Eigen::VectorXd> q;
+
+    /// \brief Joint velocities of each sample (copies of the columns of the input matrix).
+    std::vector<Eigen::VectorXd> v_in;
+
+    /// \brief Joint accelerations of each sample (copies of the columns of the input matrix).
+    std::vector<Eigen::VectorXd> a_in;
+
+    /// \brief Relative joint placements (wrt the body parent) of each sample.
+    std::vector<SE3Batch> liMi;
+
+    /// \brief Joint velocities of each sample.
+    std::vector<Matrix6x> v;
+
+    /// \brief Joint accelerations due to the gravity field of each sample.
+    std::vector<Matrix6x> a_gf;
+
+    /// \brief Body forces of each sample.
+    std::vector<Matrix6x> f;
+
+    /// \brief Joint torques: the column k contains the torques of the sample k (dim model.nv x nsamples).
+    Eigen::MatrixXd tau;
+
+    /// \brief Temporary of size 6 x nsamples.
+    Matrix6x tmp;
+
+    ///
+    /// \brief Default constructor of se3::BatchData from a se3::Model.
+    ///
+    /// \param[in] model The model structure of the rigid body system.
+    /// \param[in] nsamples The number of samples processed by each call to a batched algorithm.
+    ///
+    BatchData(const Model & model, const int nsamples);
+
+  }; // class BatchData
+
+} // namespace se3
+
+/* --- Details -------------------------------------------------------------------- */
+namespace se3
+{
+  inline BatchData::BatchData(const Model & ref, const int nsamples)
+    : model(ref)
+    , nsamples(nsamples)
+    , joints((std::size_t)ref.nbody)
+    , q((std::size_t)nsamples, Eigen::VectorXd(ref.nq))
+    , v_in((std::size_t)nsamples, Eigen::VectorXd(ref.nv))
+    , a_in((std::size_t)nsamples, Eigen::VectorXd(ref.nv))
+    , liMi((std::size_t)ref.nbody, SE3Batch(nsamples))
+    , v((std::size_t)ref.nbody, Matrix6x(6,nsamples))
+    , a_gf((std::size_t)ref.nbody, Matrix6x(6,nsamples))
+    , f((std::size_t)ref.nbody, Matrix6x(6,nsamples))
+    , tau(ref.nv,nsamples)
+    , tmp(6,nsamples)
+  {
+    assert(nsamples > 0 && "The number of samples must be positive");
+
+    /* Create the data structure associated to the joints, one per sample */
+    for(Model::JointIndex i=0;i<(Model::JointIndex)(model.nbody);++i)
+    {
+      joints[i].reserve((std::size_t)nsamples);
+      for(int k=0;k<nsamples;++k)
+        joints[i].push_back(CreateJointData::run(model.joints[i]));
+    }
+
+    /* Init universe states relatively to itself */
+    liMi[0].setIdentity();
+    v[0].setZero();
+    for(int k=0;k<nsamples;++k) a_gf[0].col(k) = -model.gravity.toVector();
+    f[0].setZero();
+  }
+
+} // namespace se3
+
+#endif // ifndef __se3_batch_data_hpp__
@@ -0,0 +1,129 @@
+//
+// Copyright (c) 2016 CNRS
+//
+// This file is part of Pinocchio
+// Pinocchio is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// Pinocchio is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Lesser Public License for more details. You should have
+// received a copy of the GNU Lesser General Public License along with
+// Pinocchio If not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef __se3_branch_sparse_matrix_hpp__
+#define __se3_branch_sparse_matrix_hpp__
+
+#include <Eigen/Core>
+#include <vector>
+#include <cassert>
+
+namespace se3
+{
+  ///
+  /// \brief Symmetric matrix of dim nv whose sparsity pattern is induced by the branches of the kinematic tree,
+  ///        as the joint space inertia matrix or its Cholesky factor.
+  ///
+  /// \note The entry (r,c), r <= c, is structurally non zero only if the dof r belongs to the supporting chain of the dof c.
+  ///       Only these entries are stored: the chain of c gathers contiguously the entries (r,c) for r going from the root
+  ///       down to c, so that (r,c) is stored at values[chainStart[c]+depth[r]], depth[r] being the number of dofs supporting r.
+  ///       The memory is the sum of the chain lengths, instead of nv*nv for a dense matrix.
+  ///
+  class BranchSparseMatrix
+  {
+  public:
+    typedef Eigen::VectorXd::SegmentReturnType ChainXpr;
+    typedef Eigen::VectorXd::ConstSegmentReturnType ConstChainXpr;
+
+    /// \brief The stored entries, chain after chain.
+    Eigen::VectorXd values;
+
+    /// \brief Parent dof of each dof (-1 for the dofs supported by the universe), i.e. Data::parents_fromRow.
+    std::vector<int> parents;
+
+    /// \brief Number of dofs supporting each dof.
+    std::vector<int> depth;
+
+    /// \brief Index in values of the first entry of the chain of each dof (dim nv+1).
+    std::vector<int> chainStart;
+
+    BranchSparseMatrix() : values(), parents(), depth(), chainStart(1,0) {}
+
+    ///
+    /// \brief Build the sparsity pattern from the parent of each dof. All the entries are set to zero.
+    ///
+    /// \param[in] parents_fromRow The parent of each dof, as computed in Data::parents_fromRow.
+    ///
+    explicit BranchSparseMatrix(const std::vector<int> & parents_fromRow)
+    { setStructure(parents_fromRow); }
+
+    /// \brief Build the sparsity pattern from the parent of each dof. All the entries are set to zero.
+    inline void setStructure(const std::vector<int> & parents_fromRow);
+
+    /// \brief Dimension of the matrix.
+    int size() const { return (int)parents.size(); }
+
+    /// \brief Number of stored entries.
+    int nonZeros() const { return chainStart.back(); }
+
+    /// \brief Entries (r,c) of the supporting chain of the dof c, from the root down to r = c.
+    ChainXpr chain(const int c)
+    { return values.segment(chainStart[(std::size_t)c],depth[(std::size_t)c]+1); }
+    ConstChainXpr chain(const int c) const
+    { return values.segment(chainStart[(std::size_t)c],depth[(std::size_t)c]+1); }
+
+    /// \brief Entry (r,c). r must belong to the supporting chain of c.
+    double & operator() (const int r, const int c)
+    {
+      assert(r <= c && depth[(std::size_t)r] <= depth[(std::size_t)c]);
+      return values[chainStart[(std::size_t)c]+depth[(std::size_t)r]];
+    }
+    double operator() (const int r, const int c) const
+    {
+      assert(r <= c && depth[(std::size_t)r] <= depth[(std::size_t)c]);
+      return values[chainStart[(std::size_t)c]+depth[(std::size_t)r]];
+    }
+
+    /// \brief Dense copy of the symmetric matrix (both triangular parts are filled).
+    inline Eigen::MatrixXd dense() const;
+
+  }; // class BranchSparseMatrix
+
+} // namespace se3
+
+/* --- Details -------------------------------------------------------------------- */
+namespace se3
+{
+  inline void BranchSparseMatrix::setStructure(const std::vector<int> & parents_fromRow)
+  {
+    const std::size_t nv = parents_fromRow.size();
+    parents = parents_fromRow;
+    depth.resize(nv);
+    chainStart.resize(nv+1);
+
+    chainStart[0] = 0;
+    for(std::size_t k=0;k<nv;++k)
+    {
+      assert(parents[k] < (int)k && "The parent of a dof must precede it");
+      depth[k] = (parents[k] < 0) ? 0 : depth[(std::size_t)parents[k]]+1;
+      chainStart[k+1] = chainStart[k] + depth[k]+1;
+    }
+    values = Eigen::VectorXd::Zero(chainStart[nv]);
+  }
+
+  inline Eigen::MatrixXd BranchSparseMatrix::dense() const
+  {
+    Eigen::MatrixXd res(Eigen::MatrixXd::Zero(size(),size()));
+    for(int c=0;c<size();++c)
+      for(int r=c;r>=0;r=parents[(std::size_t)r])
+        res(r,c) = res(c,r) = (*this)(r,c);
+    return res;
+  }
+
+} // namespace se3
+
+#endif // ifndef __se3_branch_sparse_matrix_hpp__
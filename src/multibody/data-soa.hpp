@@ -0,0 +1,135 @@
+//
+// Copyright (c) 2016 CNRS
+//
+// This file is part of Pinocchio
+// Pinocchio is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// Pinocchio is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Lesser Public License for more details. You should have
+// received a copy of the GNU Lesser General Public License along with
+// Pinocchio If not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef __se3_data_soa_hpp__
+#define __se3_data_soa_hpp__
+
+#include "pinocchio/multibody/model.hpp"
+
+namespace se3
+{
+  ///
+  /// \brief Data structure storing the kinematic quantities of the bodies as a structure of arrays.
+  ///
+  /// \note Contrary to se3::Data, where each placement, motion or force is an object of its own,
+  ///       the rotations, translations, linear and angular parts of all the bodies are stored in
+  ///       contiguous blocks: the rotation of body i is the 3x3 block oMi_rotations.middleCols<3>(3*i),
+  ///       its translation is oMi_translations.col(i), and so on. The accessors oMi(i), v(i), ... and
+  ///       setOMi(i,M), setV(i,v), ... convert from/to the spatial types, so that an algorithm written
+  ///       for se3::Data can be ported incrementally.
+  ///
+  class DataSoA
+  {
+  public:
+    typedef Eigen::Matrix<double,3,Eigen::Dynamic> Matrix3x;
+
+    /// \brief Vector of se3::JointData associated to the se3::JointModel stored in model.
+    JointDataVector joints;
+
+    /// \brief Rotations of the absolute joint placements (3 x 3*model.nbody).
+    Matrix3x oMi_rotations;
+    /// \brief Translations of the absolute joint placements (3 x model.nbody).
+    Matrix3x oMi_translations;
+
+    /// \brief Rotations of the relative joint placements, wrt the body parent (3 x 3*model.nbody).
+    Matrix3x liMi_rotations;
+    /// \brief Translations of the relative joint placements, wrt the body parent (3 x model.nbody).
+    Matrix3x liMi_translations;
+
+    /// \brief Linear and angular parts of the joint velocities (3 x model.nbody).
+    Matrix3x v_linear, v_angular;
+
+    /// \brief Linear and angular parts of the joint accelerations due to the gravity field (3 x model.nbody).
+    Matrix3x a_gf_linear, a_gf_angular;
+
+    /// \brief Linear and angular parts of the body forces (3 x model.nbody).
+    Matrix3x f_linear, f_angular;
+
+    /// \brief Joint torques (dim model.nv).
+    Eigen::VectorXd tau;
+
+    ///
+    /// \brief Default constructor of se3::DataSoA from a se3::Model.
+    ///
+    /// \param[in] model The model structure of the rigid body system.
+    ///
+    explicit DataSoA(const Model & model);
+
+    /// \brief Absolute placement of joint i.
+    SE3 oMi(const Model::JointIndex i) const
+    { return SE3(oMi_rotations.middleCols<3>(3*(long)i),oMi_translations.col((long)i)); }
+    void setOMi(const Model::JointIndex i, const SE3 & M)
+    { oMi_rotations.middleCols<3>(3*(long)i) = M.rotation(); oMi_translations.col((long)i) = M.translation(); }
+
+    /// \brief Relative placement of joint i wrt the body parent.
+    SE3 liMi(const Model::JointIndex i) const
+    { return SE3(liMi_rotations.middleCols<3>(3*(long)i),liMi_translations.col((long)i)); }
+    void setLiMi(const Model::JointIndex i, const SE3 & M)
+    { liMi_rotations.middleCols<3>(3*(long)i) = M.rotation(); liMi_translations.col((long)i) = M.translation(); }
+
+    /// \brief Velocity of joint i.
+    Motion v(const Model::JointIndex i) const
+    { return Motion(v_linear.col((long)i),v_angular.col((long)i)); }
+    void setV(const Model::JointIndex i, const Motion & m)
+    { v_linear.col((long)i) = m.linear(); v_angular.col((long)i) = m.angular(); }
+
+    /// \brief Acceleration of joint i due to the gravity field.
+    Motion a_gf(const Model::JointIndex i) const
+    { return Motion(a_gf_linear.col((long)i),a_gf_angular.col((long)i)); }
+    void setA_gf(const Model::JointIndex i, const Motion & m)
+    { a_gf_linear.col((long)i) = m.linear(); a_gf_angular.col((long)i) = m.angular(); }
+
+    /// \brief Force of body i.
+    Force f(const Model::JointIndex i) const
+    { return Force(f_linear.col((long)i),f_angular.col((long)i)); }
+    void setF(const Model::JointIndex i, const Force & f)
+    { f_linear.col((long)i) = f.linear(); f_angular.col((long)i) = f.angular(); }
+
+  }; // class DataSoA
+
+} // namespace se3
+
+/* --- Details -------------------------------------------------------------------- */
+namespace se3
+{
+  inline DataSoA::DataSoA(const Model & model)
+    : joints()
+    , oMi_rotations(3,3*model.nbody)
+    , oMi_translations(3,model.nbody)
+    , liMi_rotations(3,3*model.nbody)
+    , liMi_translations(3,model.nbody)
+    , v_linear(3,model.nbody), v_angular(3,model.nbody)
+    , a_gf_linear(3,model.nbody), a_gf_angular(3,model.nbody)
+    , f_linear(3,model.nbody), f_angular(3,model.nbody)
+    , tau(model.nv)
+  {
+    /* Create data strcture associated to the joints */
+    joints.reserve((std::size_t)model.nbody);
+    for(Model::JointIndex i=0;i<(Model::JointIndex)(model.nbody);++i)
+      joints.push_back(CreateJointData::run(model.joints[i]));
+
+    /* Init universe states relatively to itself */
+    setOMi(0,SE3::Identity());
+    setLiMi(0,SE3::Identity());
+    setV(0,Motion::Zero());
+    setA_gf(0,-model.gravity);
+    setF(0,Force::Zero());
+  }
+
+} // namespace se3
+
+#endif // ifndef __se3_data_soa_hpp__
@@ -74,6 +74,22 @@ namespace se3
 		      m.rotation().transpose()*(angular() - skew(m.translation())*linear()) );
       // TODO check if nothing better than explicitely calling skew
     }
+    /// af = aXb.act(bf), written in res (of the same size, distinct from *this) without allocation
+    void se3Action(const SE3 & m, ForceSetTpl & res) const
+    {
+      assert(res.size == size && &res != this);
+      res.m_f.noalias() = m.rotation()*m_f;
+      res.m_n.noalias() = m.rotation()*m_n;
+      for(int k=0;k<size;++k) res.m_n.col(k) += m.translation().cross(res.m_f.col(k));
+    }
+    /// bf = aXb.actInv(af), written in res (of the same size, distinct from *this) without allocation
+    void se3ActionInverse(const SE3 & m, ForceSetTpl & res) const
+    {
+      assert(res.size == size && &res != this);
+      for(int k=0;k<size;++k)
+        res.m_n.col(k).noalias() = m.rotation().transpose()*(m_n.col(k) - m.translation().cross(m_f.col(k)));
+      res.m_f.noalias() = m.rotation().transpose()*m_f;
+    }
 
     friend std::ostream & operator << (std::ostream & os, const ForceSetTpl & phi)
     {
@@ -148,6 +164,22 @@ namespace se3
 			   m.rotation().transpose()*(angular() - skew(m.translation())*linear()) );
 	// TODO check if nothing better than explicitely calling skew
       }
+      /// af = aXb.act(bf), written in res (of size len, not referring to the same set) without allocation
+      void se3Action(const SE3 & m, ForceSetTpl & res) const
+      {
+	assert(res.size == len && &res != &ref);
+	res.m_f.noalias() = m.rotation()*linear();
+	res.m_n.noalias() = m.rotation()*angular();
+	for(int k=0;k<len;++k) res.m_n.col(k) += m.translation().cross(res.m_f.col(k));
+      }
+      /// bf = aXb.actInv(af), written in res (of size len, not referring to the same set) without allocation
+      void se3ActionInverse(const SE3 & m, ForceSetTpl & res) const
+      {
+	assert(res.size == len && &res != &ref);
+	for(int k=0;k<len;++k)
+	  res.m_n.col(k).noalias() = m.rotation().transpose()*(Vector3(angular().col(k)) - m.translation().cross(Vector3(linear().col(k))));
+	res.m_f.noalias() = m.rotation().transpose()*linear();
+      }
 
     };
 
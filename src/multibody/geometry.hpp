@@ -195,6 +195,24 @@ struct GeometryObject
   /// \brief Absolute path to the mesh file
   std::string mesh_path;
 
+  /// \brief Bitmask of the collision groups the object belongs to (default: the first group).
+  unsigned int collision_group;
+
+  /// \brief Bitmask of the collision groups the object may collide with (default: all the groups).
+  ///        Two objects are only paired by GeometryData::addAdmissibleCollisionPairs if the group of each one
+  ///        intersects the mask of the other one.
+  unsigned int collision_mask;
+
+  ///
+  /// \brief Optional cheap geometry enclosing the collision geometry (e.g. the bounding capsule of a mesh, see
+  ///        computeBoundingCapsule). When it is set, the collision tests first check the proxy, and only test the
+  ///        actual geometry if the proxy is in collision.
+  ///
+  boost::shared_ptr<fcl::CollisionGeometry> proxy_geometry;
+
+  /// \brief Placement of the proxy geometry in the frame of the geometry object.
+  SE3 proxy_placement;
+
 
   GeometryObject(const GeometryType type, const std::string & name, const JointIndex parent, const fcl::CollisionObject & collision,
                  const SE3 & placement, const std::string & mesh_path)
@@ -204,6 +222,10 @@ struct GeometryObject
                 , collision_object(collision)
                 , placement(placement)
                 , mesh_path(mesh_path)
+                , collision_group(1u)
+                , collision_mask(~0u)
+                , proxy_geometry()
+                , proxy_placement(SE3::Identity())
   {}
 
   GeometryObject & operator=(const GeometryObject & other)
@@ -214,6 +236,10 @@ struct GeometryObject
     collision_object = other.collision_object;
     placement = other.placement;
     mesh_path = other.mesh_path;
+    collision_group = other.collision_group;
+    collision_mask = other.collision_mask;
+    proxy_geometry = other.proxy_geometry;
+    proxy_placement = other.proxy_placement;
     return *this;
   }
 
@@ -226,6 +252,10 @@ struct GeometryObject
                                && lhs.collision_object == rhs.collision_object
                                && lhs.placement == rhs.placement
                                && lhs.mesh_path ==  rhs.mesh_path
+                               && lhs.collision_group == rhs.collision_group
+                               && lhs.collision_mask == rhs.collision_mask
+                               && lhs.proxy_geometry == rhs.proxy_geometry
+                               && lhs.proxy_placement == rhs.proxy_placement
                                );
   }
 
@@ -394,6 +424,7 @@ struct GeometryObject
     typedef Model::GeomIndex GeomIndex;
     typedef CollisionPair CollisionPair_t;
     typedef std::vector<CollisionPair_t> CollisionPairsVector_t;
+    typedef Eigen::Matrix<double,3,Eigen::Dynamic> Matrix3x;
 
     ///
     /// \brief A const reference to the data associated to the robot model.
@@ -436,14 +467,109 @@ struct GeometryObject
 
     ///
     /// \brief Vector gathering the result of the distance computation for all the collision pairs.
+    ///        It has the same size as collision_pairs, the i-th result corresponding to the i-th pair.
     ///
     std::vector <DistanceResult> distance_results;
     
     ///
     /// \brief Vector gathering the result of the collision computation for all the collision pairs.
+    ///        It has the same size as collision_pairs, or is empty in the boolean only mode (see setBooleanOnlyCollisions).
     ///
     std::vector <CollisionResult> collision_results;
 
+    ///
+    /// \brief Collision status of all the collision pairs, stored as one bit per pair.
+    ///        It is filled by computeCollisions and computeAllCollisions, in both modes.
+    ///
+    std::vector <bool> collision_status;
+
+    ///
+    /// \brief If true, the collision computations only store the collision status of the pairs,
+    ///        and collision_results is left empty.
+    ///
+    bool boolean_only_collisions;
+
+    /// \brief Request used for all the collision computations.
+    fcl::CollisionRequest collision_request;
+
+    /// \brief Request used for all the distance computations.
+    fcl::DistanceRequest distance_request;
+
+    ///
+    /// \brief FCL result used as a workspace by the collision computations in the boolean only mode.
+    ///        Its contact vector keeps its capacity from one call to another.
+    ///
+    fcl::CollisionResult collision_result_buffer;
+
+    ///
+    /// \brief If true, the collision computations first select the collision pairs whose axis-aligned bounding boxes
+    ///        overlap (see updateBroadPhase). Only these pairs are given to the FCL narrow phase.
+    ///
+    bool broad_phase_enabled;
+
+    ///
+    /// \brief If true, the collision tests of the objects having a proxy geometry (see GeometryObject::proxy_geometry)
+    ///        are first performed on the proxies.
+    ///
+    bool collision_proxies_enabled;
+
+    /// \brief Lower corners of the axis-aligned bounding boxes of the collision objects, in the world frame (dim 3 x ncollisions).
+    Matrix3x oAABB_min;
+
+    /// \brief Upper corners of the axis-aligned bounding boxes of the collision objects, in the world frame (dim 3 x ncollisions).
+    Matrix3x oAABB_max;
+
+    ///
+    /// \brief Collision objects sorted by the lower bound of their bounding box along the x axis.
+    ///        The order of the previous call is kept, so that the sort is almost linear when the robot moves continuously.
+    ///
+    std::vector<GeomIndex> broad_phase_order;
+
+    ///
+    /// \brief For each collision object co1, the list of (co2, index in collision_pairs) of the collision pairs (co1,co2), sorted by co2.
+    ///
+    std::vector< std::vector< std::pair<GeomIndex,Index> > > collision_pairs_of_object;
+
+    /// \brief Indexes in collision_pairs of the pairs selected by the last broad phase, in increasing order.
+    std::vector<Index> broad_phase_candidates;
+
+    /// \brief True if collision_pairs_of_object has to be rebuilt since the collision pairs have changed.
+    bool broad_phase_dirty;
+
+    /// \brief For each collision object, a bound of the distance from the origin of its frame to its points (dim ncollisions).
+    Eigen::VectorXd collision_object_radii;
+
+    /// \brief Placements of the collision objects at the last call of computeDistances(data_geom,threshold).
+    std::vector<se3::SE3> oMg_distance_cache;
+
+    ///
+    /// \brief For each collision object, an upper bound of the distance travelled by its points since the distance cache
+    ///        has been reset, accumulated by computeDistances(data_geom,threshold) (dim ncollisions).
+    ///
+    Eigen::VectorXd travelled_distances;
+
+    ///
+    /// \brief For each collision pair, the sum of the travelled distances of its two objects when its distance result
+    ///        has been computed for the last time (dim nCollisionPairs).
+    ///
+    Eigen::VectorXd distance_cache_travels;
+
+    ///
+    /// \brief For each collision pair, its distance when it has been evaluated for the last time by
+    ///        computeDistances(data_geom,threshold) (dim nCollisionPairs). Contrary to distance_results, it is only
+    ///        written by this function, so that the lower bounds derived from it remain valid.
+    ///
+    Eigen::VectorXd distance_cache_distances;
+
+    ///
+    /// \brief For each collision pair, a lower bound of its current distance computed by computeDistances(data_geom,threshold).
+    ///        It is the exact distance for the pairs which have been evaluated by FCL (dim nCollisionPairs).
+    ///
+    Eigen::VectorXd distance_lower_bounds;
+
+    /// \brief True if the distance cache has to be reset, e.g. since the collision pairs have changed.
+    bool distance_cache_dirty;
+
     GeometryData(const Data & data, const GeometryModel & model_geom)
         : data_ref(data)
         , model_geom(model_geom)
@@ -454,11 +580,33 @@ struct GeometryObject
         , nCollisionPairs(0)
         , distance_results()
         , collision_results()
+        , collision_status()
+        , boolean_only_collisions(false)
+        , collision_request(1, false, false, 1, false, true, fcl::GST_INDEP)
+        , distance_request(true, 0, 0, fcl::GST_INDEP)
+        , collision_result_buffer()
+        , broad_phase_enabled(true)
+        , collision_proxies_enabled(true)
+        , oAABB_min(3,model_geom.ncollisions)
+        , oAABB_max(3,model_geom.ncollisions)
+        , broad_phase_order(model_geom.ncollisions)
+        , collision_pairs_of_object(model_geom.ncollisions)
+        , broad_phase_candidates()
+        , broad_phase_dirty(true)
+        , collision_object_radii((long)model_geom.ncollisions)
+        , oMg_distance_cache(model_geom.ncollisions)
+        , travelled_distances(Eigen::VectorXd::Zero((long)model_geom.ncollisions))
+        , distance_cache_travels()
+        , distance_cache_distances()
+        , distance_lower_bounds()
+        , distance_cache_dirty(true)
     {
-      const std::size_t num_max_collision_pairs = (model_geom.ncollisions * (model_geom.ncollisions-1))/2;
-      collision_pairs.reserve(num_max_collision_pairs);
-      distance_results.resize(num_max_collision_pairs, DistanceResult( fcl::DistanceResult(), 0, 0) );
-      collision_results.resize(num_max_collision_pairs, CollisionResult( fcl::CollisionResult(), 0, 0));
+      for (GeomIndex i = 0; i < (GeomIndex)model_geom.ncollisions; ++i)
+      {
+        broad_phase_order[i] = i;
+        const fcl::CollisionGeometry & geometry = *model_geom.collision_objects[i].collision_object.collisionGeometry();
+        collision_object_radii[(long)i] = toVector3d(geometry.aabb_center).norm() + geometry.aabb_radius;
+      }
     }
 
     ~GeometryData() {};
@@ -484,6 +632,25 @@ struct GeometryObject
     /// \brief Add all possible collision pairs.
     ///
     void addAllCollisionPairs();
+
+    ///
+    /// \brief Check whether two collision objects should be paired for collision checking.
+    ///
+    /// \note A pair is rejected if both objects are attached to the same joint, if one joint is the parent of the other
+    ///       one (adjacent bodies), except when the parent is the universe, or if the collision group of one object does
+    ///       not intersect the collision mask of the other one.
+    ///
+    /// \param[in] co1 Index of the first collision object.
+    /// \param[in] co2 Index of the second collision object.
+    ///
+    /// \return True if the pair is admissible.
+    ///
+    bool isCollisionPairAdmissible (const GeomIndex co1, const GeomIndex co2) const;
+
+    ///
+    /// \brief Add all the admissible collision pairs (see isCollisionPairAdmissible) in place of all the possible ones.
+    ///
+    void addAdmissibleCollisionPairs();
    
     ///
     /// \brief Remove if exists the collision pair given by the index of the two colliding geometries from the vector of collision_pairs.
@@ -501,7 +668,7 @@ struct GeometryObject
     void removeCollisionPair (const CollisionPair_t& pair);
     
     ///
-    /// \brief Remove all collision pairs from collision_pairs. Same as collision_pairs.clear().
+    /// \brief Remove all collision pairs from collision_pairs, together with their results.
     void removeAllCollisionPairs ();
    
     ///
@@ -544,6 +711,39 @@ struct GeometryObject
     ///
     Index findCollisionPair (const CollisionPair_t & pair) const;
     
+    ///
+    /// \brief Switch between the full collision results and the boolean only mode.
+    ///        In the boolean only mode, collision_results is released and only collision_status is filled,
+    ///        which is enough for planners that only need to know whether the configuration is in collision.
+    ///
+    /// \param[in] boolean_only True to store only the collision status of the pairs.
+    ///
+    void setBooleanOnlyCollisions(const bool boolean_only);
+
+    ///
+    /// \brief Enable or disable the broad phase of the collision computations.
+    ///        The results are the same in both cases, the broad phase only skips the pairs which cannot be in collision.
+    ///
+    /// \param[in] enable True to enable the broad phase.
+    ///
+    void setBroadPhase(const bool enable);
+
+    ///
+    /// \brief Enable or disable the collision tests on the proxy geometries before the actual geometries.
+    ///        The results are the same in both cases, the proxies only skip the tests of the actual geometries
+    ///        which cannot be in collision.
+    ///
+    /// \param[in] enable True to test the proxies first.
+    ///
+    void setCollisionProxies(const bool enable);
+
+    ///
+    /// \brief Compute the bounding boxes of the collision objects from their current placements oMg_collisions,
+    ///        and select by sweep and prune the collision pairs whose bounding boxes overlap.
+    ///        The selected pairs are stored in broad_phase_candidates.
+    ///
+    void updateBroadPhase();
+
     void desactivateCollisionPairs();
     void initializeListOfCollisionPairs();
     
@@ -575,6 +775,17 @@ struct GeometryObject
     /// \return Return true is the collision objects are colliding.
     ///
     CollisionResult computeCollision(const CollisionPair_t & pair) const;
+
+    ///
+    /// \brief Compute the collision status between two collision objects of a given collision pair,
+    ///         reusing an existing FCL result.
+    ///
+    /// \param[in] pair The collsion pair.
+    /// \param[out] result The FCL result, cleared before the computation.
+    ///
+    /// \return Return true is the collision objects are colliding.
+    ///
+    bool computeCollision(const CollisionPair_t & pair, fcl::CollisionResult & result) const;
     
     ///
     /// \brief Compute the collision result of all the collision pairs according to
@@ -582,6 +793,21 @@ struct GeometryObject
     ///        The results are stored in the vector GeometryData::collision_results.
     ///
     void computeAllCollisions();
+
+    ///
+    /// \brief Compute the collision status of a pair of collision_pairs and store it in collision_status,
+    ///        and in collision_results unless the boolean only mode is active.
+    ///
+    /// \param[in] pair_index Index of the pair in collision_pairs.
+    ///
+    /// \return Return true is the collision objects are colliding.
+    ///
+    bool computeCollisionResult(const Index pair_index);
+
+    ///
+    /// \brief Set all the pairs as not colliding, in collision_status and collision_results.
+    ///
+    void resetCollisionResults();
     
     ///
     /// \brief Check if at least one of the collision pairs has its two collision objects in collision.
@@ -606,6 +832,14 @@ struct GeometryObject
     /// \return An fcl struct containing the distance result.
     ///
     DistanceResult computeDistance(const CollisionPair_t & pair) const;
+
+    ///
+    /// \brief Compute the minimal distance between collision objects of a collison pair, reusing an existing FCL result.
+    ///
+    /// \param[in] pair The collsion pair.
+    /// \param[out] result The FCL result, cleared before the computation.
+    ///
+    void computeDistance(const CollisionPair_t & pair, fcl::DistanceResult & result) const;
     
     ///
     /// \brief Compute the distance result for all collision pairs according to
@@ -616,6 +850,11 @@ struct GeometryObject
     
     void resetDistances();
 
+    ///
+    /// \brief Force computeDistances(data_geom,threshold) to evaluate all the pairs at its next call.
+    ///
+    void resetDistanceCache();
+
     void displayCollisionPairs() const
     {
       for (std::vector<CollisionPair_t>::const_iterator it = collision_pairs.begin(); it != collision_pairs.end(); ++it)
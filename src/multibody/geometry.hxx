@@ -36,6 +36,7 @@
 #include <map>
 #include <list>
 #include <utility>
+#include <algorithm>
 
 /// @cond DEV
 
@@ -185,18 +186,58 @@ namespace se3
     if (!existCollisionPair(pair))
     {
       collision_pairs.push_back(pair);
+      distance_results.push_back(DistanceResult(fcl::DistanceResult(), pair.first, pair.second));
+      if (!boolean_only_collisions)
+        collision_results.push_back(CollisionResult(fcl::CollisionResult(), pair.first, pair.second));
+      collision_status.push_back(false);
       nCollisionPairs++;
+      broad_phase_dirty = true;
+      distance_cache_dirty = true;
     }
   }
   
   inline void GeometryData::addAllCollisionPairs()
   {
     removeAllCollisionPairs();
-    collision_pairs.reserve((model_geom.ncollisions * (model_geom.ncollisions-1))/2);
+    const std::size_t num_max_collision_pairs = (model_geom.ncollisions * (model_geom.ncollisions-1))/2;
+    collision_pairs.reserve(num_max_collision_pairs);
+    distance_results.reserve(num_max_collision_pairs);
+    if (!boolean_only_collisions)
+      collision_results.reserve(num_max_collision_pairs);
+    collision_status.reserve(num_max_collision_pairs);
     for (Index i = 0; i < model_geom.ncollisions; ++i)
       for (Index j = i+1; j < model_geom.ncollisions; ++j)
         addCollisionPair(i,j);
   }
+
+  inline bool GeometryData::isCollisionPairAdmissible (const GeomIndex co1, const GeomIndex co2) const
+  {
+    const GeometryObject & object1 = model_geom.collision_objects[co1];
+    const GeometryObject & object2 = model_geom.collision_objects[co2];
+
+    if (!(object1.collision_group & object2.collision_mask) || !(object2.collision_group & object1.collision_mask))
+      return false;
+
+    // Objects of the same body, or of two bodies linked by a joint, are always in contact
+    const Model::JointIndex joint1 = object1.parent;
+    const Model::JointIndex joint2 = object2.parent;
+    if (joint1 == joint2)
+      return false;
+    const Model & model = model_geom.model;
+    if ((joint1 > 0 && model.parents[joint2] == joint1) || (joint2 > 0 && model.parents[joint1] == joint2))
+      return false;
+
+    return true;
+  }
+
+  inline void GeometryData::addAdmissibleCollisionPairs()
+  {
+    removeAllCollisionPairs();
+    for (Index i = 0; i < model_geom.ncollisions; ++i)
+      for (Index j = i+1; j < model_geom.ncollisions; ++j)
+        if (isCollisionPairAdmissible(i,j))
+          addCollisionPair(i,j);
+  }
   
   inline void GeometryData::removeCollisionPair (const GeomIndex co1, const GeomIndex co2)
   {
@@ -216,15 +257,27 @@ namespace se3
                                                     pair);
     if (it != collision_pairs.end())
     {
+      const std::size_t index = (std::size_t) (it - collision_pairs.begin());
       collision_pairs.erase(it);
+      distance_results.erase(distance_results.begin() + (long)index);
+      if (!boolean_only_collisions)
+        collision_results.erase(collision_results.begin() + (long)index);
+      collision_status.erase(collision_status.begin() + (long)index);
       nCollisionPairs--;
+      broad_phase_dirty = true;
+      distance_cache_dirty = true;
     }
   }
   
   inline void GeometryData::removeAllCollisionPairs ()
   {
     collision_pairs.clear();
+    distance_results.clear();
+    collision_results.clear();
+    collision_status.clear();
     nCollisionPairs = 0;
+    broad_phase_dirty = true;
+    distance_cache_dirty = true;
   }
 
   inline bool GeometryData::existCollisionPair (const GeomIndex co1, const GeomIndex co2) const
@@ -263,6 +316,101 @@ namespace se3
 ////    }
 //  }
 
+  inline void GeometryData::setBooleanOnlyCollisions(const bool boolean_only)
+  {
+    boolean_only_collisions = boolean_only;
+    if (boolean_only)
+    {
+      // Release the memory of the full results
+      std::vector<CollisionResult>().swap(collision_results);
+    }
+    else
+    {
+      collision_results.clear();
+      collision_results.reserve(collision_pairs.size());
+      for (CollisionPairsVector_t::const_iterator it = collision_pairs.begin(); it != collision_pairs.end(); ++it)
+        collision_results.push_back(CollisionResult(fcl::CollisionResult(), it->first, it->second));
+    }
+  }
+
+  inline void GeometryData::setBroadPhase(const bool enable)
+  {
+    broad_phase_enabled = enable;
+  }
+
+  inline void GeometryData::setCollisionProxies(const bool enable)
+  {
+    collision_proxies_enabled = enable;
+  }
+
+  inline void GeometryData::updateBroadPhase()
+  {
+    typedef std::pair<GeomIndex,Index> PairEntry;
+    typedef std::vector<PairEntry> PairEntryVector;
+
+    if (broad_phase_dirty)
+    {
+      for (std::size_t i = 0; i < collision_pairs_of_object.size(); ++i)
+        collision_pairs_of_object[i].clear();
+      for (Index k = 0; k < collision_pairs.size(); ++k)
+        collision_pairs_of_object[collision_pairs[k].first].push_back(PairEntry(collision_pairs[k].second,k));
+      for (std::size_t i = 0; i < collision_pairs_of_object.size(); ++i)
+        std::sort(collision_pairs_of_object[i].begin(), collision_pairs_of_object[i].end());
+      broad_phase_candidates.reserve(collision_pairs.size());
+      broad_phase_dirty = false;
+    }
+
+    // Bounding boxes in the world frame, from the local bounding boxes of the geometries
+    for (GeomIndex i = 0; i < (GeomIndex)model_geom.ncollisions; ++i)
+    {
+      const fcl::AABB & aabb = model_geom.collision_objects[i].collision_object.collisionGeometry()->aabb_local;
+      const Eigen::Vector3d center (0.5 * (toVector3d(aabb.max_) + toVector3d(aabb.min_)));
+      const Eigen::Vector3d half_extent (0.5 * (toVector3d(aabb.max_) - toVector3d(aabb.min_)));
+
+      const SE3 & oMg = oMg_collisions[i];
+      const Eigen::Vector3d ocenter (oMg.rotation() * center + oMg.translation());
+      const Eigen::Vector3d ohalf_extent (oMg.rotation().cwiseAbs() * half_extent);
+      oAABB_min.col((long)i) = ocenter - ohalf_extent;
+      oAABB_max.col((long)i) = ocenter + ohalf_extent;
+    }
+
+    // Insertion sort along the x axis, almost linear since the order of the previous call is kept
+    for (std::size_t k = 1; k < broad_phase_order.size(); ++k)
+    {
+      const GeomIndex i = broad_phase_order[k];
+      const double xmin = oAABB_min(0,(long)i);
+      std::size_t l = k;
+      while (l > 0 && oAABB_min(0,(long)broad_phase_order[l-1]) > xmin)
+      {
+        broad_phase_order[l] = broad_phase_order[l-1];
+        --l;
+      }
+      broad_phase_order[l] = i;
+    }
+
+    // Sweep along the x axis and prune along the y and z axes
+    broad_phase_candidates.clear();
+    for (std::size_t k = 0; k < broad_phase_order.size(); ++k)
+    {
+      const long i = (long)broad_phase_order[k];
+      for (std::size_t l = k+1; l < broad_phase_order.size(); ++l)
+      {
+        const long j = (long)broad_phase_order[l];
+        if (oAABB_min(0,j) > oAABB_max(0,i)) break;
+        if (oAABB_min(1,j) > oAABB_max(1,i) || oAABB_max(1,j) < oAABB_min(1,i)
+            || oAABB_min(2,j) > oAABB_max(2,i) || oAABB_max(2,j) < oAABB_min(2,i))
+          continue;
+
+        const PairEntryVector & pairs = collision_pairs_of_object[(std::size_t)std::min(i,j)];
+        const PairEntryVector::const_iterator it = std::lower_bound(pairs.begin(), pairs.end(),
+                                                                    PairEntry((GeomIndex)std::max(i,j),0));
+        if (it != pairs.end() && it->first == (GeomIndex)std::max(i,j))
+          broad_phase_candidates.push_back(it->second);
+      }
+    }
+    std::sort(broad_phase_candidates.begin(), broad_phase_candidates.end());
+  }
+
   // TODO :  give a srdf file as argument, read it, and remove corresponding
   // pairs from list collision_pairs
   inline void GeometryData::desactivateCollisionPairs()
@@ -283,34 +431,90 @@ namespace se3
   }
   
   inline CollisionResult GeometryData::computeCollision(const CollisionPair_t & pair) const
+  {
+    fcl::CollisionResult collisionResult;
+    computeCollision(pair, collisionResult);
+
+    return CollisionResult (collisionResult, pair.first, pair.second);
+  }
+
+  inline bool GeometryData::computeCollision(const CollisionPair_t & pair, fcl::CollisionResult & result) const
   {
     const Index & co1 = pair.first;
     const Index & co2 = pair.second;
-    
-    fcl::CollisionRequest collisionRequest (1, false, false, 1, false, true, fcl::GST_INDEP);
-    fcl::CollisionResult collisionResult;
 
-    fcl::collide (model_geom.collision_objects[co1].collision_object.collisionGeometry().get(), oMg_fcl_collisions[co1],
-                  model_geom.collision_objects[co2].collision_object.collisionGeometry().get(), oMg_fcl_collisions[co2],
-                  collisionRequest, collisionResult);
+    const GeometryObject & object1 = model_geom.collision_objects[co1];
+    const GeometryObject & object2 = model_geom.collision_objects[co2];
 
-    return CollisionResult (collisionResult, co1, co2);
+    result.clear();
+    if (collision_proxies_enabled && (object1.proxy_geometry || object2.proxy_geometry))
+    {
+      // The proxies enclose the actual geometries: if they do not collide, neither do the actual geometries
+      if (object1.proxy_geometry && object2.proxy_geometry)
+        fcl::collide (object1.proxy_geometry.get(), toFclTransform3f(oMg_collisions[co1] * object1.proxy_placement),
+                      object2.proxy_geometry.get(), toFclTransform3f(oMg_collisions[co2] * object2.proxy_placement),
+                      collision_request, result);
+      else if (object1.proxy_geometry)
+        fcl::collide (object1.proxy_geometry.get(), toFclTransform3f(oMg_collisions[co1] * object1.proxy_placement),
+                      object2.collision_object.collisionGeometry().get(), oMg_fcl_collisions[co2],
+                      collision_request, result);
+      else
+        fcl::collide (object1.collision_object.collisionGeometry().get(), oMg_fcl_collisions[co1],
+                      object2.proxy_geometry.get(), toFclTransform3f(oMg_collisions[co2] * object2.proxy_placement),
+                      collision_request, result);
+
+      if (!result.isCollision())
+        return false;
+      result.clear();
+    }
+
+    fcl::collide (object1.collision_object.collisionGeometry().get(), oMg_fcl_collisions[co1],
+                  object2.collision_object.collisionGeometry().get(), oMg_fcl_collisions[co2],
+                  collision_request, result);
+
+    return result.isCollision();
   }
   
   inline void GeometryData::computeAllCollisions()
   {
-    for(size_t i = 0; i<nCollisionPairs; ++i)
+    assert(collision_status.size() == collision_pairs.size() && "The results are not synchronized with the collision pairs.");
+    if (broad_phase_enabled)
     {
-      const CollisionPair_t & pair = collision_pairs[i];
-      collision_results[i] = computeCollision(pair.first, pair.second);
+      updateBroadPhase();
+      resetCollisionResults();
+      for(std::size_t k = 0; k < broad_phase_candidates.size(); ++k)
+        computeCollisionResult(broad_phase_candidates[k]);
     }
+    else
+    {
+      for(size_t i = 0; i<nCollisionPairs; ++i)
+        computeCollisionResult(i);
+    }
+  }
+
+  inline bool GeometryData::computeCollisionResult(const Index pair_index)
+  {
+    fcl::CollisionResult & result = boolean_only_collisions
+                                  ? collision_result_buffer
+                                  : collision_results[pair_index].fcl_collision_result;
+    const bool pair_in_collision = computeCollision(collision_pairs[pair_index], result);
+    collision_status[pair_index] = pair_in_collision;
+    return pair_in_collision;
+  }
+
+  inline void GeometryData::resetCollisionResults()
+  {
+    std::fill(collision_status.begin(), collision_status.end(), false);
+    for(std::vector<CollisionResult>::iterator it = collision_results.begin(); it != collision_results.end(); ++it)
+      it->fcl_collision_result.clear();
   }
   
   inline bool GeometryData::isColliding() const
   {
+    fcl::CollisionResult result;
     for(CollisionPairsVector_t::const_iterator it = collision_pairs.begin(); it != collision_pairs.end(); ++it)
     {
-      if (computeCollision(it->first, it->second).fcl_collision_result.isCollision())
+      if (computeCollision(*it, result))
         return true;
     }
     return false;
@@ -322,31 +526,41 @@ namespace se3
   }
   
   inline DistanceResult GeometryData::computeDistance(const CollisionPair_t & pair) const
+  {
+    fcl::DistanceResult result;
+    computeDistance(pair, result);
+    
+    return DistanceResult (result, pair.first, pair.second);
+  }
+
+  inline void GeometryData::computeDistance(const CollisionPair_t & pair, fcl::DistanceResult & result) const
   {
     const Index & co1 = pair.first;
     const Index & co2 = pair.second;
-    
-    fcl::DistanceRequest distanceRequest (true, 0, 0, fcl::GST_INDEP);
-    fcl::DistanceResult result;
+
+    result.clear();
     fcl::distance ( model_geom.collision_objects[co1].collision_object.collisionGeometry().get(), oMg_fcl_collisions[co1],
                     model_geom.collision_objects[co2].collision_object.collisionGeometry().get(), oMg_fcl_collisions[co2],
-                    distanceRequest, result);
-    
-    return DistanceResult (result, co1, co2);
+                    distance_request, result);
   }
   
   inline void GeometryData::computeAllDistances ()
   {
+    assert(distance_results.size() == collision_pairs.size() && "The results are not synchronized with the collision pairs.");
     for(size_t i = 0; i<nCollisionPairs; ++i)
-    {
-      const CollisionPair_t & pair = collision_pairs[i];
-      distance_results[i] = computeDistance(pair.first, pair.second);
-    }
+      computeDistance(collision_pairs[i], distance_results[i].fcl_distance_result);
   }
 
   inline void GeometryData::resetDistances()
   {
-    std::fill(distance_results.begin(), distance_results.end(), DistanceResult( fcl::DistanceResult(), 0, 0) );
+    for(std::vector<DistanceResult>::iterator it = distance_results.begin(); it != distance_results.end(); ++it)
+      it->fcl_distance_result.clear();
+    distance_cache_dirty = true;
+  }
+
+  inline void GeometryData::resetDistanceCache()
+  {
+    distance_cache_dirty = true;
   }
   
   void GeometryData::addCollisionPairsFromSrdf(const std::string & filename,
@@ -21,12 +21,39 @@
 #include "pinocchio/multibody/joint.hpp"
 #include <Eigen/StdVector>
 #include <boost/variant.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/mpl/size.hpp>
 
 namespace se3
 {
   typedef boost::variant< JointModelRX, JointModelRY, JointModelRZ, JointModelRevoluteUnaligned, JointModelSpherical, JointModelSphericalZYX, JointModelPX, JointModelPY, JointModelPZ, JointModelPrismaticUnaligned, JointModelFreeFlyer, JointModelPlanar, JointModelTranslation, JointModelDense<-1,-1> > JointModelVariant;
   typedef boost::variant< JointDataRX, JointDataRY, JointDataRZ, JointDataRevoluteUnaligned, JointDataSpherical, JointDataSphericalZYX, JointDataPX, JointDataPY, JointDataPZ, JointDataPrismaticUnaligned, JointDataFreeFlyer, JointDataPlanar, JointDataTranslation, JointDataDense<-1,-1> > JointDataVariant;
 
+  ///
+  /// \brief Type tag of a joint, i.e. the index of its type in se3::JointModelVariant (and se3::JointDataVariant),
+  ///        as returned by jmodel.which().
+  ///
+  enum JointTypeTag
+  {
+    JOINT_RX = 0,
+    JOINT_RY,
+    JOINT_RZ,
+    JOINT_REVOLUTE_UNALIGNED,
+    JOINT_SPHERICAL,
+    JOINT_SPHERICAL_ZYX,
+    JOINT_PX,
+    JOINT_PY,
+    JOINT_PZ,
+    JOINT_PRISMATIC_UNALIGNED,
+    JOINT_FREE_FLYER,
+    JOINT_PLANAR,
+    JOINT_TRANSLATION,
+    JOINT_DENSE,
+    NB_JOINT_TYPES
+  };
+  BOOST_STATIC_ASSERT(boost::mpl::size<JointModelVariant::types>::value == NB_JOINT_TYPES);
+  BOOST_STATIC_ASSERT(boost::mpl::size<JointDataVariant::types>::value == NB_JOINT_TYPES);
+
   typedef std::vector<JointModelVariant> JointModelVector;
   typedef std::vector<JointDataVariant> JointDataVector;
 
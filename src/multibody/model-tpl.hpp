@@ -0,0 +1,410 @@
+//
+// Copyright (c) 2016 CNRS
+//
+// This file is part of Pinocchio
+// Pinocchio is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// Pinocchio is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Lesser Public License for more details. You should have
+// received a copy of the GNU Lesser General Public License along with
+// Pinocchio If not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef __se3_model_tpl_hpp__
+#define __se3_model_tpl_hpp__
+
+#include "pinocchio/multibody/model.hpp"
+#include "pinocchio/exception.hpp"
+#include <Eigen/LU>
+
+namespace se3
+{
+  ///
+  /// \brief Copy of the kinematic tree of a se3::Model with an arbitrary scalar type (e.g. float).
+  ///
+  /// \note se3::Model stores its joints as variants of double-precision joint models. ModelTpl instead
+  ///       describes each joint by its type tag (se3::JointTypeTag), its axis and its constant motion
+  ///       subspace, which is enough for the joint types whose motion subspace does not depend on the
+  ///       configuration, i.e. all of them but se3::JointModelSphericalZYX and se3::JointModelDense.
+  ///       The algorithms templated on ModelTpl/DataTpl (forwardKinematics, framesForwardKinematics, rnea, aba,
+  ///       crba, centerOfMass, kineticEnergy and potentialEnergy) use Scalar everywhere, so that ModelTpl<float>
+  ///       halves the memory traffic of ModelTpl<double>, and an automatic differentiation scalar type (e.g.
+  ///       Eigen::AutoDiffScalar) gives the exact derivatives of any composition of these algorithms.
+  ///
+  /// \note With Eigen::AutoDiffScalar and dynamic derivatives, the derivatives of the constants stored in the model
+  ///       are resized to the number of seeded variables at the first evaluation: use one model per number of seeds.
+  ///
+  template<typename _Scalar>
+  class ModelTpl
+  {
+  public:
+    typedef _Scalar Scalar;
+    typedef SE3Tpl<Scalar> SE3;
+    typedef MotionTpl<Scalar> Motion;
+    typedef ForceTpl<Scalar> Force;
+    typedef InertiaTpl<Scalar> Inertia;
+    typedef Eigen::Matrix<Scalar,3,1> Vector3;
+    typedef Eigen::Matrix<Scalar,Eigen::Dynamic,1> VectorXs;
+    typedef Eigen::Matrix<Scalar,6,Eigen::Dynamic> Matrix6x;
+    typedef se3::JointIndex JointIndex;
+    typedef se3::FrameIndex FrameIndex;
+
+    /// \brief Dimension of the configuration vector representation.
+    int nq;
+
+    /// \brief Dimension of the velocity vector space.
+    int nv;
+
+    /// \brief Number of bodies (= number of joints + 1).
+    int nbody;
+
+    /// \brief Joint parent of joint i, denoted li (li==parents[i]).
+    std::vector<JointIndex> parents;
+
+    /// \brief Type tag of each joint (see se3::JointTypeTag).
+    std::vector<int> joint_types;
+
+    /// \brief Index of the first configuration (resp. velocity) component of each joint, and their number.
+    std::vector<int> idx_qs, idx_vs, nqs, nvs;
+
+    /// \brief Dimension of the subtree motion space of each joint (the joint itself and its descendants).
+    std::vector<int> nvSubtree;
+
+    /// \brief Axis of the revolute and prismatic joints, expressed in the joint frame (unused for the other joints).
+    std::vector<Vector3> axes;
+
+    /// \brief Motion subspace of each joint, expressed in the joint frame (dim 6 x nvs[i]).
+    std::vector<Matrix6x> S;
+
+    /// \brief Placement (SE3) of the input of joint i regarding to the parent joint output li.
+    std::vector<SE3, Eigen::aligned_allocator<SE3> > jointPlacements;
+
+    /// \brief Spatial inertias of the body i expressed in the supporting joint frame i.
+    std::vector<Inertia, Eigen::aligned_allocator<Inertia> > inertias;
+
+    /// \brief Spatial gravity of the model.
+    Motion gravity;
+
+    /// \brief Number of operational frames.
+    int nOperationalFrames;
+
+    /// \brief Supporting joint of each operational frame.
+    std::vector<JointIndex> frameParents;
+
+    /// \brief Placement of each operational frame wrt its supporting joint.
+    std::vector<SE3, Eigen::aligned_allocator<SE3> > framePlacements;
+
+    ///
+    /// \brief Copy the kinematic tree of model, converting all its quantities to Scalar.
+    ///
+    /// \param[in] model The model structure of the rigid body system.
+    ///
+    explicit ModelTpl(const Model & model);
+
+    ///
+    /// \brief Copy of the model with another scalar type.
+    ///
+    template<typename NewScalar>
+    ModelTpl<NewScalar> cast() const;
+
+  private:
+    template<typename> friend class ModelTpl;
+    ModelTpl() {}
+
+  }; // class ModelTpl
+
+  ///
+  /// \brief Data structure associated to a se3::ModelTpl, holding the results of the templated algorithms.
+  ///
+  template<typename _Scalar>
+  class DataTpl
+  {
+  public:
+    typedef _Scalar Scalar;
+    typedef ModelTpl<Scalar> Model;
+    typedef typename Model::SE3 SE3;
+    typedef typename Model::Motion Motion;
+    typedef typename Model::Force Force;
+    typedef typename Model::Inertia Inertia;
+    typedef typename Model::VectorXs VectorXs;
+    typedef typename Model::Matrix6x Matrix6x;
+    typedef Eigen::Matrix<Scalar,6,6> Matrix6;
+    typedef Eigen::Matrix<Scalar,Eigen::Dynamic,Eigen::Dynamic> MatrixXs;
+
+    /// \brief Placement of the joints, relatively to their parent (liMi) and to the world (oMi).
+    std::vector<SE3, Eigen::aligned_allocator<SE3> > liMi, oMi;
+
+    /// \brief Joint velocities, accelerations and velocity product terms, expressed in the joint frames.
+    std::vector<Motion, Eigen::aligned_allocator<Motion> > v, a, c;
+
+    /// \brief Body forces (rnea) and articulated-body bias forces (aba).
+    std::vector<Force, Eigen::aligned_allocator<Force> > f;
+
+    /// \brief Composite rigid body inertias.
+    std::vector<Inertia, Eigen::aligned_allocator<Inertia> > Ycrb;
+
+    /// \brief Articulated body inertias.
+    std::vector<Matrix6, Eigen::aligned_allocator<Matrix6> > Yaba;
+
+    /// \brief Articulated-body quantities U = Yaba S, D^{-1} = (S^T U)^{-1} and u = tau - S^T f of each joint.
+    std::vector<Matrix6x> U;
+    std::vector<MatrixXs> Dinv;
+    std::vector<VectorXs> u;
+
+    /// \brief Temporary of size 6 x nv, used by crba.
+    Matrix6x Fcrb;
+
+    /// \brief Joint torques (rnea).
+    VectorXs tau;
+
+    /// \brief Joint accelerations (aba).
+    VectorXs ddq;
+
+    /// \brief Joint space inertia matrix, upper triangular part (crba).
+    MatrixXs M;
+
+    /// \brief Absolute placements of the operational frames (framesForwardKinematics).
+    std::vector<SE3, Eigen::aligned_allocator<SE3> > oMof;
+
+    /// \brief Center of mass of the system, expressed in the world frame (centerOfMass).
+    Eigen::Matrix<Scalar,3,1> com;
+
+    /// \brief Total mass of the system (centerOfMass).
+    Scalar mass;
+
+    /// \brief Kinetic and potential energies of the system (kineticEnergy, potentialEnergy).
+    Scalar kinetic_energy, potential_energy;
+
+    ///
+    /// \brief Default constructor of se3::DataTpl from a se3::ModelTpl.
+    ///
+    /// \param[in] model The model structure of the rigid body system.
+    ///
+    explicit DataTpl(const Model & model);
+
+  }; // class DataTpl
+
+  ///
+  /// \brief Placement of joint i of model for the configuration q (the joint part of liMi, without the joint placement).
+  ///
+  template<typename Scalar>
+  inline SE3Tpl<Scalar> jointTransform(const ModelTpl<Scalar> & model,
+                                       const typename ModelTpl<Scalar>::JointIndex i,
+                                       const Eigen::Matrix<Scalar,Eigen::Dynamic,1> & q);
+
+} // namespace se3
+
+/* --- Details -------------------------------------------------------------------- */
+namespace se3
+{
+  namespace internal
+  {
+    template<typename NewScalar, typename Scalar>
+    inline SE3Tpl<NewScalar> castSE3(const SE3Tpl<Scalar> & M)
+    {
+      return SE3Tpl<NewScalar>(M.rotation().template cast<NewScalar>(),M.translation().template cast<NewScalar>());
+    }
+
+    template<typename NewScalar, typename Scalar>
+    inline InertiaTpl<NewScalar> castInertia(const InertiaTpl<Scalar> & Y)
+    {
+      return InertiaTpl<NewScalar>((NewScalar)Y.mass(),Y.lever().template cast<NewScalar>(),
+                                   Y.inertia().matrix().template cast<NewScalar>());
+    }
+
+    template<typename NewScalar, typename Scalar>
+    inline MotionTpl<NewScalar> castMotion(const MotionTpl<Scalar> & m)
+    {
+      return MotionTpl<NewScalar>(m.toVector().template cast<NewScalar>());
+    }
+  } // namespace internal
+
+  template<typename Scalar>
+  inline ModelTpl<Scalar>::ModelTpl(const se3::Model & model)
+    : nq(model.nq)
+    , nv(model.nv)
+    , nbody(model.nbody)
+    , parents(model.parents)
+    , joint_types((std::size_t)model.nbody,-1)
+    , idx_qs((std::size_t)model.nbody,0)
+    , idx_vs((std::size_t)model.nbody,0)
+    , nqs((std::size_t)model.nbody,0)
+    , nvs((std::size_t)model.nbody,0)
+    , nvSubtree((std::size_t)model.nbody,0)
+    , axes((std::size_t)model.nbody,Vector3::Zero())
+    , S((std::size_t)model.nbody)
+    , jointPlacements((std::size_t)model.nbody)
+    , inertias((std::size_t)model.nbody)
+    , gravity(internal::castMotion<Scalar>(model.gravity))
+    , nOperationalFrames(model.nOperationalFrames)
+    , frameParents((std::size_t)model.nOperationalFrames)
+    , framePlacements((std::size_t)model.nOperationalFrames)
+  {
+    typedef Eigen::Matrix<double,6,Eigen::Dynamic> Matrix6xd;
+    for(JointIndex i=1;i<(JointIndex)model.nbody;++i)
+    {
+      const JointModelVariant & jmodel = model.joints[i];
+      const int nv_i = se3::nv(jmodel);
+      joint_types[i] = jmodel.which();
+      idx_qs[i] = se3::idx_q(jmodel); idx_vs[i] = se3::idx_v(jmodel);
+      nqs[i] = se3::nq(jmodel); nvs[i] = nv_i;
+
+      /* The motion subspace of the supported joints does not depend on the joint data */
+      const Matrix6xd S_i (constraint_xd(createData(jmodel)).matrix());
+      Eigen::Vector3d axis (Eigen::Vector3d::Zero());
+      switch(joint_types[i])
+      {
+        case JOINT_RX: case JOINT_RY: case JOINT_RZ: case JOINT_REVOLUTE_UNALIGNED:
+          axis = S_i.col(0).tail<3>();
+          break;
+        case JOINT_PX: case JOINT_PY: case JOINT_PZ: case JOINT_PRISMATIC_UNALIGNED:
+          axis = S_i.col(0).head<3>();
+          break;
+        case JOINT_SPHERICAL: case JOINT_FREE_FLYER: case JOINT_PLANAR: case JOINT_TRANSLATION:
+          break;
+        default:
+          throw se3::Exception("ModelTpl: the motion subspace of joint " + model.names[i] + " depends on the configuration, which is not supported.");
+      }
+      axes[i] = axis.cast<Scalar>();
+      S[i] = S_i.cast<Scalar>();
+    }
+    for(JointIndex i=(JointIndex)model.nbody-1;i>0;--i)
+    {
+      nvSubtree[i] += nvs[i];
+      if(parents[i]>0) nvSubtree[parents[i]] += nvSubtree[i];
+    }
+    for(std::size_t k=0;k<(std::size_t)model.nOperationalFrames;++k)
+    {
+      frameParents[k] = model.operational_frames[k].parent;
+      framePlacements[k] = internal::castSE3<Scalar>(model.operational_frames[k].placement);
+    }
+
+    /* The placement and inertia of the universe are left uninitialized in se3::Model */
+    jointPlacements[0].setIdentity();
+    inertias[0] = Inertia::Zero();
+    for(JointIndex i=1;i<(JointIndex)model.nbody;++i)
+    {
+      jointPlacements[i] = internal::castSE3<Scalar>(model.jointPlacements[i]);
+      inertias[i] = internal::castInertia<Scalar>(model.inertias[i]);
+    }
+  }
+
+  template<typename Scalar>
+  template<typename NewScalar>
+  inline ModelTpl<NewScalar> ModelTpl<Scalar>::cast() const
+  {
+    ModelTpl<NewScalar> res;
+    res.nq = nq; res.nv = nv; res.nbody = nbody;
+    res.parents = parents; res.joint_types = joint_types;
+    res.idx_qs = idx_qs; res.idx_vs = idx_vs; res.nqs = nqs; res.nvs = nvs; res.nvSubtree = nvSubtree;
+    res.axes.resize(axes.size()); res.S.resize(S.size());
+    res.jointPlacements.resize(jointPlacements.size()); res.inertias.resize(inertias.size());
+    for(std::size_t i=0;i<(std::size_t)nbody;++i)
+    {
+      res.axes[i] = axes[i].template cast<NewScalar>();
+      res.S[i] = S[i].template cast<NewScalar>();
+      res.jointPlacements[i] = internal::castSE3<NewScalar>(jointPlacements[i]);
+      res.inertias[i] = internal::castInertia<NewScalar>(inertias[i]);
+    }
+    res.gravity = internal::castMotion<NewScalar>(gravity);
+    res.nOperationalFrames = nOperationalFrames;
+    res.frameParents = frameParents;
+    res.framePlacements.resize(framePlacements.size());
+    for(std::size_t k=0;k<framePlacements.size();++k)
+      res.framePlacements[k] = internal::castSE3<NewScalar>(framePlacements[k]);
+    return res;
+  }
+
+  template<typename Scalar>
+  inline DataTpl<Scalar>::DataTpl(const Model & model)
+    : liMi((std::size_t)model.nbody)
+    , oMi((std::size_t)model.nbody)
+    , v((std::size_t)model.nbody)
+    , a((std::size_t)model.nbody)
+    , c((std::size_t)model.nbody)
+    , f((std::size_t)model.nbody)
+    , Ycrb((std::size_t)model.nbody)
+    , Yaba((std::size_t)model.nbody)
+    , U((std::size_t)model.nbody)
+    , Dinv((std::size_t)model.nbody)
+    , u((std::size_t)model.nbody)
+    , Fcrb(Matrix6x::Zero(6,model.nv))
+    , tau(VectorXs::Zero(model.nv))
+    , ddq(VectorXs::Zero(model.nv))
+    , M(MatrixXs::Zero(model.nv,model.nv))
+    , oMof((std::size_t)model.nOperationalFrames)
+    , com(Eigen::Matrix<Scalar,3,1>::Zero())
+    , mass(0)
+    , kinetic_energy(0)
+    , potential_energy(0)
+  {
+    for(std::size_t i=0;i<(std::size_t)model.nbody;++i)
+    {
+      U[i].resize(6,model.nvs[i]);
+      Dinv[i].resize(model.nvs[i],model.nvs[i]);
+      u[i].resize(model.nvs[i]);
+    }
+    liMi[0].setIdentity(); oMi[0].setIdentity();
+    v[0].setZero(); a[0].setZero(); c[0].setZero(); f[0].setZero();
+  }
+
+  template<typename Scalar>
+  inline SE3Tpl<Scalar> jointTransform(const ModelTpl<Scalar> & model,
+                                       const typename ModelTpl<Scalar>::JointIndex i,
+                                       const Eigen::Matrix<Scalar,Eigen::Dynamic,1> & q)
+  {
+    typedef SE3Tpl<Scalar> SE3;
+    typedef typename SE3::Matrix3 Matrix3;
+    typedef typename SE3::Vector3 Vector3;
+    using std::cos; using std::sin;
+
+    const int idx_q = model.idx_qs[i];
+    const Vector3 & axis = model.axes[i];
+    switch(model.joint_types[i])
+    {
+      case JOINT_RX: case JOINT_RY: case JOINT_RZ: case JOINT_REVOLUTE_UNALIGNED:
+      {
+        /* Rodrigues formula: R = cos(q) I + sin(q) [axis]_x + (1-cos(q)) axis axis^T */
+        const Scalar ca = cos(q[idx_q]), sa = sin(q[idx_q]);
+        Matrix3 R ((Scalar(1)-ca)*axis*axis.transpose());
+        R(0,0) += ca; R(1,1) += ca; R(2,2) += ca;
+        R(1,2) -= sa*axis[0]; R(2,1) += sa*axis[0];
+        R(2,0) -= sa*axis[1]; R(0,2) += sa*axis[1];
+        R(0,1) -= sa*axis[2]; R(1,0) += sa*axis[2];
+        return SE3(R,Vector3::Zero());
+      }
+      case JOINT_PX: case JOINT_PY: case JOINT_PZ: case JOINT_PRISMATIC_UNALIGNED:
+        return SE3(Matrix3::Identity(),Vector3(axis*q[idx_q]));
+      case JOINT_SPHERICAL:
+      {
+        const Eigen::Quaternion<Scalar> quat (q[idx_q+3],q[idx_q],q[idx_q+1],q[idx_q+2]);
+        return SE3(quat.matrix(),Vector3::Zero());
+      }
+      case JOINT_FREE_FLYER:
+      {
+        const Eigen::Quaternion<Scalar> quat (q[idx_q+6],q[idx_q+3],q[idx_q+4],q[idx_q+5]);
+        return SE3(quat.matrix(),q.template segment<3>(idx_q));
+      }
+      case JOINT_PLANAR:
+      {
+        const Scalar ca = cos(q[idx_q+2]), sa = sin(q[idx_q+2]);
+        Matrix3 R (Matrix3::Identity());
+        R(0,0) = ca; R(0,1) = -sa; R(1,0) = sa; R(1,1) = ca;
+        return SE3(R,Vector3(q[idx_q],q[idx_q+1],Scalar(0)));
+      }
+      case JOINT_TRANSLATION:
+        return SE3(Matrix3::Identity(),q.template segment<3>(idx_q));
+      default:
+        assert(false && "Unsupported joint type");
+        return SE3(Matrix3::Identity(),Vector3::Zero());
+    }
+  }
+
+} // namespace se3
+
+#endif // ifndef __se3_model_tpl_hpp__
@@ -27,6 +27,7 @@
 #include "pinocchio/spatial/frame.hpp"
 #include "pinocchio/multibody/fwd.hpp"
 #include "pinocchio/multibody/joint/joint-variant.hpp"
+#include "pinocchio/multibody/branch-sparse-matrix.hpp"
 #include "pinocchio/tools/string-generator.hpp"
 #include <iostream>
 #include <Eigen/Cholesky>
@@ -445,6 +446,16 @@ namespace se3
     
     /// \brief Subtree of the current row index (used in Cholesky Decomposition).
     std::vector<int> nvSubtree_fromRow;
+
+    /// \brief The joint space inertia matrix stored in the branch-induced sparse format (computed by se3::crbaSparse).
+    BranchSparseMatrix Msparse;
+
+    /// \brief Cholesky factor of Msparse (computed by se3::cholesky::decomposeSparse): the entries (r,c), r < c, are those of U
+    ///        and the diagonal entries are those of D.
+    BranchSparseMatrix Usparse;
+
+    /// \brief Spatial forces Ycrb*J[:,c] of the columns of the joint Jacobian (temporary used by se3::crbaSparse).
+    Matrix6x Fsparse;
     
     /// \brief Jacobian of joint placements.
     /// \note The columns of J corresponds to the basis of the spatial velocities of each joint and expressed at the origin of the inertial frame. In other words, if \f$ v_{J_{i}} = S_{i} \dot{q}_{i}\f$ is the relative velocity of the joint i regarding to its parent, then \f$J = \begin{bmatrix} ^{0}X_{1} S_{1} & \cdots & ^{0}X_{i} S_{i} & \cdots & ^{0}X_{\text{nj}} S_{\text{nj}} \end{bmatrix} \f$. This Jacobian has no special meaning. To get the jacobian of a precise joint, you need to call se3::getJacobian
@@ -499,6 +510,83 @@ namespace se3
     /// \brief Lagrange Multipliers corresponding to the contact impulses in se3::impulseDynamics.
     Eigen::VectorXd impulse_c;
     
+    /// \brief Deepest dof of the kinematic chain supporting each constraint (row of J) given to se3::computeJMinvJt,
+    ///        or -1 if the constraint is not supported by a single chain.
+    std::vector<int> constraint_chainEnd;
+    
+    /// \brief For each pair of constraints given to se3::computeJMinvJt, the deepest dof common to their supporting chains
+    ///        (-1 if none, -2 if none of the two constraints is supported by a single chain).
+    Eigen::MatrixXi constraint_chainCommon;
+    
+    /// \brief Whether each constraint given to se3::computeJMinvJt is active (see se3::updateActiveConstraint).
+    std::vector<bool> constraint_active;
+    
+    /// \brief Joint accelerations due to unit contact forces after the backward passes of se3::forwardDynamicsRecursive:
+    ///        only the rows of the dofs supporting each contact are nonzero (dim model.nv x 6*nb_contacts).
+    Eigen::MatrixXd contact_ddq;
+    
+    /// \brief Vector of joint accelerations due to the contact forces in se3::forwardDynamicsRecursive, expressed in the world frame.
+    std::vector<Motion> oa_contact;
+    
+    /// \brief Joint accelerations due to the contact forces in se3::forwardDynamicsRecursive (dim model.nv).
+    Eigen::VectorXd contact_ddq_lambda;
+    
+    /// \brief Temporary holding the joints supporting a contact in se3::forwardDynamicsRecursive (capacity model.nbody).
+    std::vector<Model::JointIndex> contact_chain;
+    
+    /// \brief Articulated-body quantities U and U D^{-1} of the joints, expressed in the world frame (used in se3::forwardDynamicsRecursive).
+    Matrix6x contact_oU, contact_oUDinv;
+
+    /// \brief Joint configuration used by the last call to se3::forwardKinematicsIncremental (NaN if none).
+    Eigen::VectorXd q_fk;
+    
+    /// \brief For each joint, true if its placement oMi has been recomputed by the last call to se3::forwardKinematicsIncremental.
+    std::vector<bool> oMi_updated;
+
+    // Temporary variables used in se3::computeRNEADerivatives
+    
+    /// \brief Vector of joint velocities expressed in the world frame.
+    std::vector<Motion> ov;
+    
+    /// \brief Vector of joint accelerations due to the gravity field, expressed in the world frame.
+    std::vector<Motion> oa_gf;
+    
+    /// \brief Vector of subtree body forces expressed in the world frame.
+    std::vector<Force> of;
+    
+    /// \brief Vector of subtree sums of the variation of the body forces \f$ Y a + v \times^* Y v \f$ with respect to the body velocity, expressed in the world frame.
+    std::vector<Inertia::Matrix6, Eigen::aligned_allocator<Inertia::Matrix6> > Bcrb;
+    
+    /// \brief Variation of the joint velocities with respect to each dof of q, up to the rigid motion of the subtree (world frame).
+    Matrix6x dVdq;
+    
+    /// \brief Variation of the joint accelerations with respect to each dof of q, up to the rigid motion of the subtree (world frame).
+    Matrix6x dAdq;
+    
+    /// \brief Variation of the joint accelerations with respect to each dof of v, up to the term depending on the body velocity (world frame).
+    Matrix6x dAdv;
+    
+    /// \brief Partial derivative of the joint torques with respect to the joint configuration (sized by the first call to se3::computeRNEADerivatives).
+    Eigen::MatrixXd dtau_dq;
+    
+    /// \brief Partial derivative of the joint torques with respect to the joint velocity.
+    Eigen::MatrixXd dtau_dv;
+    
+    /// \brief Inverse of the joint space inertia matrix (both triangular parts are filled, sized by the first call to se3::computeMinverse).
+    Eigen::MatrixXd Minv;
+    
+    /// \brief Force set propagated in the backward pass of se3::computeMinverse, expressed in the world frame (6 x nv).
+    Matrix6x Fminv;
+    
+    /// \brief Acceleration sets of each joint propagated in the forward pass of se3::computeMinverse, expressed in the world frame (6 x nv each).
+    std::vector<Matrix6x> Aminv;
+    
+    /// \brief Partial derivative of the joint accelerations with respect to the joint configuration (sized by the first call to se3::computeABADerivatives).
+    Eigen::MatrixXd ddq_dq;
+    
+    /// \brief Partial derivative of the joint accelerations with respect to the joint velocity.
+    Eigen::MatrixXd ddq_dv;
+    
     ///
     /// \brief Default constructor of se3::Data from a se3::Model.
     ///
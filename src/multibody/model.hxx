@@ -278,6 +278,7 @@ namespace se3
     ,tmp(ref.nv)
     ,parents_fromRow((std::size_t)ref.nv)
     ,nvSubtree_fromRow((std::size_t)ref.nv)
+    ,Fsparse(6,ref.nv)
     ,J(6,ref.nv)
     ,iMf((std::size_t)ref.nbody)
     ,com((std::size_t)ref.nbody)
@@ -292,6 +293,31 @@ namespace se3
     ,torque_residual(ref.nv)
     ,dq_after(model.nv)
     ,impulse_c()
+    ,constraint_chainEnd()
+    ,constraint_chainCommon()
+    ,constraint_active()
+    ,contact_ddq()
+    ,oa_contact((std::size_t)ref.nbody)
+    ,contact_ddq_lambda(ref.nv)
+    ,contact_chain()
+    ,contact_oU(6,ref.nv)
+    ,contact_oUDinv(6,ref.nv)
+    ,q_fk(Eigen::VectorXd::Constant(ref.nq,std::numeric_limits<double>::quiet_NaN()))
+    ,oMi_updated((std::size_t)ref.nbody,true)
+    ,ov((std::size_t)ref.nbody)
+    ,oa_gf((std::size_t)ref.nbody)
+    ,of((std::size_t)ref.nbody)
+    ,Bcrb((std::size_t)ref.nbody)
+    ,dVdq()
+    ,dAdq()
+    ,dAdv()
+    ,dtau_dq()
+    ,dtau_dv()
+    ,Minv()
+    ,Fminv()
+    ,Aminv()
+    ,ddq_dq()
+    ,ddq_dv()
   {
     /* Create data strcture associated to the joints */
     for(Model::Index i=0;i<(Model::JointIndex)(model.nbody);++i) 
@@ -305,9 +331,14 @@ namespace se3
     /* Init for Cholesky */
     U.setIdentity();
     computeParents_fromRow(ref);
+    Msparse.setStructure(parents_fromRow);
+    Usparse.setStructure(parents_fromRow);
 
     /* Init Jacobian */
     J.fill(0);
+
+    /* Init for the contact dynamics */
+    contact_chain.reserve((std::size_t)ref.nbody);
     
     /* Init universe states relatively to itself */
     
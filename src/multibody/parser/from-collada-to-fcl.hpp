@@ -34,7 +34,12 @@
 
 #include <hpp/fcl/BV/OBBRSS.h>
 #include <hpp/fcl/BVH/BVH_model.h>
+#include <hpp/fcl/shape/geometric_shapes.h>
 
+#include <Eigen/Eigenvalues>
+
+#include "pinocchio/spatial/se3.hpp"
+#include "pinocchio/spatial/fcl-pinocchio-conversions.hpp"
 #include "pinocchio/tools/file-explorer.hpp"
 #include <boost/filesystem.hpp>
 
@@ -140,14 +145,14 @@ namespace se3
    * @param[in]  scale  Scale to apply when reading the ressource
    * @param[in]  scene  Pointer to the assimp scene
    * @param[out] mesh  The mesh that must be built
+   * @param[out] tv     Triangles and Vertices of the mesh
    */
   inline void meshFromAssimpScene (const std::string & name,
                                    const ::urdf::Vector3 & scale,
                                    const aiScene* scene,
-                                   const Polyhedron_ptr & mesh) throw (std::invalid_argument)
+                                   const Polyhedron_ptr & mesh,
+                                   TriangleAndVertices & tv) throw (std::invalid_argument)
   {
-    TriangleAndVertices tv;
-    
     if (!scene->HasMeshes())
       throw std::invalid_argument (std::string ("No meshes found in file ")+name);
     
@@ -168,6 +173,23 @@ namespace se3
       
     mesh->endModel ();
   }
+  
+  /**
+   * @brief      Convert an assimp scene to a mesh
+   *
+   * @param[in]  name   File (ressource) transformed into an assimp scene in loa
+   * @param[in]  scale  Scale to apply when reading the ressource
+   * @param[in]  scene  Pointer to the assimp scene
+   * @param[out] mesh  The mesh that must be built
+   */
+  inline void meshFromAssimpScene (const std::string & name,
+                                   const ::urdf::Vector3 & scale,
+                                   const aiScene* scene,
+                                   const Polyhedron_ptr & mesh) throw (std::invalid_argument)
+  {
+    TriangleAndVertices tv;
+    meshFromAssimpScene (name, scale, scene, mesh, tv);
+  }
       
       
       
@@ -177,10 +199,12 @@ namespace se3
    * @param[in]  resource_path  Path to the ressource mesh file to be read
    * @param[in]  scale          Scale to apply when reading the ressource
    * @param[out] polyhedron     The resulted polyhedron
+   * @param[out] tv             Triangles and Vertices of the polyhedron
    */
   inline void loadPolyhedronFromResource (const std::string & resource_path,
                                           const ::urdf::Vector3 & scale,
-                                          const Polyhedron_ptr & polyhedron) throw (std::invalid_argument)
+                                          const Polyhedron_ptr & polyhedron,
+                                          TriangleAndVertices & tv) throw (std::invalid_argument)
   {
     Assimp::Importer importer;
     const aiScene* scene = importer.ReadFile(resource_path.c_str(), aiProcess_SortByPType| aiProcess_GenNormals|
@@ -194,7 +218,81 @@ namespace se3
       throw std::invalid_argument(exception_message);
     }
     
-    meshFromAssimpScene (resource_path, scale, scene, polyhedron);
+    meshFromAssimpScene (resource_path, scale, scene, polyhedron, tv);
+  }
+  
+  /**
+   * @brief      Read a mesh file and convert it to a polyhedral mesh
+   *
+   * @param[in]  resource_path  Path to the ressource mesh file to be read
+   * @param[in]  scale          Scale to apply when reading the ressource
+   * @param[out] polyhedron     The resulted polyhedron
+   */
+  inline void loadPolyhedronFromResource (const std::string & resource_path,
+                                          const ::urdf::Vector3 & scale,
+                                          const Polyhedron_ptr & polyhedron) throw (std::invalid_argument)
+  {
+    TriangleAndVertices tv;
+    loadPolyhedronFromResource (resource_path, scale, polyhedron, tv);
+  }
+  
+  /**
+   * @brief      Compute a capsule enclosing a set of vertices, whose axis is the principal axis of the vertices.
+   *             It is meant to be used as a cheap conservative proxy of a mesh (see GeometryObject::proxy_geometry).
+   *
+   * @param[in]  vertices   The vertices to enclose (for instance TriangleAndVertices::vertices_)
+   * @param[out] placement  The placement of the capsule, whose axis is z, in the frame of the vertices
+   *
+   * @return     The enclosing capsule
+   */
+  inline boost::shared_ptr<fcl::Capsule> computeBoundingCapsule (const std::vector <fcl::Vec3f> & vertices,
+                                                                 SE3 & placement)
+  {
+    assert(!vertices.empty() && "The capsule of an empty set of vertices is undefined.");
+    
+    // Principal axis of the vertices
+    Eigen::Vector3d mean (Eigen::Vector3d::Zero());
+    for (std::size_t i = 0; i < vertices.size(); ++i)
+      mean += toVector3d(vertices[i]);
+    mean /= (double)vertices.size();
+    
+    Eigen::Matrix3d covariance (Eigen::Matrix3d::Zero());
+    for (std::size_t i = 0; i < vertices.size(); ++i)
+    {
+      const Eigen::Vector3d p (toVector3d(vertices[i]) - mean);
+      covariance.noalias() += p * p.transpose();
+    }
+    
+    // The eigenvalues are sorted in increasing order: the last eigenvector is the principal axis
+    const Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> solver (covariance);
+    Eigen::Matrix3d R;
+    R.col(0) = solver.eigenvectors().col(0);
+    R.col(1) = solver.eigenvectors().col(1);
+    R.col(2) = R.col(0).cross(R.col(1));
+    
+    // The radius is the largest distance to the axis
+    double radius2 = 0.;
+    for (std::size_t i = 0; i < vertices.size(); ++i)
+    {
+      const Eigen::Vector3d p (R.transpose() * (toVector3d(vertices[i]) - mean));
+      radius2 = std::max(radius2, p.head<2>().squaredNorm());
+    }
+    
+    // Shortest segment [zmin,zmax] such that each vertex lies in the spherical caps if it is beyond the segment
+    double zmin = std::numeric_limits<double>::infinity();
+    double zmax = -std::numeric_limits<double>::infinity();
+    for (std::size_t i = 0; i < vertices.size(); ++i)
+    {
+      const Eigen::Vector3d p (R.transpose() * (toVector3d(vertices[i]) - mean));
+      const double cap_height = std::sqrt(std::max(radius2 - p.head<2>().squaredNorm(), 0.));
+      zmin = std::min(zmin, p[2] + cap_height);
+      zmax = std::max(zmax, p[2] - cap_height);
+    }
+    if (zmin > zmax)
+      zmin = zmax = 0.5 * (zmin + zmax);
+    
+    placement = SE3(R, mean + 0.5 * (zmin + zmax) * R.col(2));
+    return boost::shared_ptr<fcl::Capsule> (new fcl::Capsule (std::sqrt(radius2), zmax - zmin));
   }
   
   
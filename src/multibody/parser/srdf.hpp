@@ -25,6 +25,8 @@
 #include <boost/property_tree/xml_parser.hpp>
 #include <boost/property_tree/ptree.hpp>
 #include <fstream>
+#include <vector>
+#include <utility>
 #include <boost/foreach.hpp>
 
 
@@ -33,6 +35,57 @@ namespace se3
   namespace srdf
   {
     
+    typedef std::pair<Model::JointIndex, Model::JointIndex> BodyPair;
+    typedef std::vector<BodyPair> BodyPairsVector;
+    
+    ///
+    /// \brief Write a SRDF file disabling the collisions between the given pairs of bodies.
+    ///        It throws if the file cannot be opened.
+    ///
+    /// \param[in] model The model containing the bodies.
+    /// \param[in] robot_name The name of the robot written in the SRDF file.
+    /// \param[in] body_pairs The pairs of bodies whose collisions are disabled.
+    /// \param[in] filename The complete path to the SRDF file.
+    /// \param[in] reason The reason written for each disabled pair.
+    ///
+    inline void writeDisabledCollisionsToSrdf(const Model & model,
+                                              const std::string & robot_name,
+                                              const BodyPairsVector & body_pairs,
+                                              const std::string & filename,
+                                              const std::string & reason = "Never") throw (std::invalid_argument)
+    {
+      // Check extension
+      const std::string extension = filename.substr(filename.find_last_of('.')+1);
+      if (extension != "srdf")
+      {
+        const std::string exception_message (filename + " does not have the right extension.");
+        throw std::invalid_argument(exception_message);
+      }
+      
+      // Fill the xml tree
+      using boost::property_tree::ptree;
+      ptree pt;
+      ptree & robot = pt.add("robot", "");
+      robot.put("<xmlattr>.name", robot_name);
+      for (BodyPairsVector::const_iterator it = body_pairs.begin(); it != body_pairs.end(); ++it)
+      {
+        ptree & disabled = robot.add("disable_collisions", "");
+        disabled.put("<xmlattr>.link1", model.bodyNames[it->first]);
+        disabled.put("<xmlattr>.link2", model.bodyNames[it->second]);
+        disabled.put("<xmlattr>.reason", reason);
+      }
+      
+      // Open file
+      std::ofstream srdf_stream(filename.c_str());
+      if (! srdf_stream.is_open())
+      {
+        const std::string exception_message (filename + " cannot be opened for writing.");
+        throw std::invalid_argument(exception_message);
+      }
+      
+      write_xml(srdf_stream, pt);
+    }
+    
 #ifdef WITH_HPP_FCL
     ///
     /// \brief Deactive all possible collision pairs mentioned in the SRDF file.
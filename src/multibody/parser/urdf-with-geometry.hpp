@@ -48,6 +48,25 @@ namespace se3
                                                           const std::vector < std::string > & package_dirs,
                                                           std::string & mesh_path);
 
+    /**
+     * @brief      Get a fcl::CollisionObject from an urdf geometry, searching
+     *             for it in specified package directories. For a mesh, also compute
+     *             its bounding capsule, to be used as a proxy of the mesh (see GeometryObject::proxy_geometry)
+     *
+     * @param[in]  urdf_geometry    The input urdf geometry
+     * @param[in]  package_dirs     A vector containing the different directories where to search for packages
+     * @param[out] mesh_path        The Absolute path of the mesh currently read
+     * @param[out] proxy_geometry   The bounding capsule of the mesh, or a null pointer for the other geometries
+     * @param[out] proxy_placement  The placement of the proxy in the frame of the geometry
+     *
+     * @return     The geometry converted as a fcl::CollisionObject
+     */
+    inline fcl::CollisionObject retrieveCollisionGeometry(const boost::shared_ptr < ::urdf::Geometry > urdf_geometry,
+                                                          const std::vector < std::string > & package_dirs,
+                                                          std::string & mesh_path,
+                                                          boost::shared_ptr < fcl::CollisionGeometry > & proxy_geometry,
+                                                          SE3 & proxy_placement);
+
     
     /**
      * @brief      Recursive procedure for reading the URDF tree, looking for geometries
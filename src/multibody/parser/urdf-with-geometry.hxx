@@ -34,8 +34,21 @@ namespace se3
     inline fcl::CollisionObject retrieveCollisionGeometry(const boost::shared_ptr < ::urdf::Geometry> urdf_geometry,
                                                           const std::vector < std::string > & package_dirs,
                                                           std::string & mesh_path)
+    {
+      boost::shared_ptr < fcl::CollisionGeometry > proxy_geometry;
+      SE3 proxy_placement;
+      return retrieveCollisionGeometry(urdf_geometry, package_dirs, mesh_path, proxy_geometry, proxy_placement);
+    }
+
+    inline fcl::CollisionObject retrieveCollisionGeometry(const boost::shared_ptr < ::urdf::Geometry> urdf_geometry,
+                                                          const std::vector < std::string > & package_dirs,
+                                                          std::string & mesh_path,
+                                                          boost::shared_ptr < fcl::CollisionGeometry > & proxy_geometry,
+                                                          SE3 & proxy_placement)
     {
       boost::shared_ptr < fcl::CollisionGeometry > geometry;
+      proxy_geometry.reset();
+      proxy_placement.setIdentity();
 
       // Handle the case where collision geometry is a mesh
       if (urdf_geometry->type == ::urdf::Geometry::MESH)
@@ -50,8 +63,13 @@ namespace se3
         // Create FCL mesh by parsing Collada file.
         Polyhedron_ptr polyhedron (new PolyhedronType);
 
-        loadPolyhedronFromResource (mesh_path, scale, polyhedron);
+        TriangleAndVertices tv;
+        loadPolyhedronFromResource (mesh_path, scale, polyhedron, tv);
         geometry = polyhedron;
+
+        // The bounding capsule is a cheap proxy of the mesh
+        if (!tv.vertices_.empty())
+          proxy_geometry = computeBoundingCapsule(tv.vertices_, proxy_placement);
       }
 
       // Handle the case where collision geometry is a cylinder
@@ -122,10 +140,15 @@ namespace se3
         
         for (std::vector< boost::shared_ptr< ::urdf::Collision> >::const_iterator i = link->collision_array.begin();i != link->collision_array.end(); ++i)
         {
-          fcl::CollisionObject collision_object = retrieveCollisionGeometry((*i)->geometry, package_dirs, mesh_path);
+          boost::shared_ptr < fcl::CollisionGeometry > proxy_geometry;
+          SE3 proxy_placement;
+          fcl::CollisionObject collision_object = retrieveCollisionGeometry((*i)->geometry, package_dirs, mesh_path,
+                                                                            proxy_geometry, proxy_placement);
           SE3 geomPlacement = convertFromUrdf((*i)->origin);
           std::string collision_object_name = (*i)->name ;
-          geom_model.addCollisionObject(model.parents[model.getBodyId(link_name)], collision_object, geomPlacement, collision_object_name, mesh_path); 
+          const GeometryModel::GeomIndex idx = geom_model.addCollisionObject(model.parents[model.getBodyId(link_name)], collision_object, geomPlacement, collision_object_name, mesh_path); 
+          geom_model.collision_objects[idx].proxy_geometry = proxy_geometry;
+          geom_model.collision_objects[idx].proxy_placement = proxy_placement;
           
         }
       } // if(link->collision)
@@ -44,6 +44,35 @@ namespace se3
   {
     namespace bf = boost::fusion;
   
+    ///
+    /// \brief Call visitor(jmodel) with jmodel casted to its concrete type.
+    ///
+    /// \note The concrete type is selected by a switch on the type tag of the joint (see se3::JointTypeTag),
+    ///       which the compiler turns into a jump table.
+    ///
+    template<typename Visitor>
+    inline void dispatch(const Visitor & visitor, const JointModelVariant & jmodel)
+    {
+      switch((JointTypeTag)jmodel.which())
+      {
+        case JOINT_RX: visitor(*boost::get<JointModelRX>(&jmodel)); break;
+        case JOINT_RY: visitor(*boost::get<JointModelRY>(&jmodel)); break;
+        case JOINT_RZ: visitor(*boost::get<JointModelRZ>(&jmodel)); break;
+        case JOINT_REVOLUTE_UNALIGNED: visitor(*boost::get<JointModelRevoluteUnaligned>(&jmodel)); break;
+        case JOINT_SPHERICAL: visitor(*boost::get<JointModelSpherical>(&jmodel)); break;
+        case JOINT_SPHERICAL_ZYX: visitor(*boost::get<JointModelSphericalZYX>(&jmodel)); break;
+        case JOINT_PX: visitor(*boost::get<JointModelPX>(&jmodel)); break;
+        case JOINT_PY: visitor(*boost::get<JointModelPY>(&jmodel)); break;
+        case JOINT_PZ: visitor(*boost::get<JointModelPZ>(&jmodel)); break;
+        case JOINT_PRISMATIC_UNALIGNED: visitor(*boost::get<JointModelPrismaticUnaligned>(&jmodel)); break;
+        case JOINT_FREE_FLYER: visitor(*boost::get<JointModelFreeFlyer>(&jmodel)); break;
+        case JOINT_PLANAR: visitor(*boost::get<JointModelPlanar>(&jmodel)); break;
+        case JOINT_TRANSLATION: visitor(*boost::get<JointModelTranslation>(&jmodel)); break;
+        case JOINT_DENSE: visitor(*boost::get< JointModelDense<-1,-1> >(&jmodel)); break;
+        default: assert(false && "Unknown joint type");
+      }
+    }
+  
     template<typename Visitor>
     struct JointVisitor : public boost::static_visitor<>
     {
@@ -51,10 +80,12 @@ namespace se3
       void operator() (const JointModelBase<D> & jmodel) const
       {
 	JointDataVariant& jdataSpec = static_cast<const Visitor*>(this)->jdata;
+	typename D::JointData * jdata = boost::get<typename D::JointData>(&jdataSpec);
+	assert(jdata != NULL && "The joint data does not match the joint model");
 
 	bf::invoke(&Visitor::template algo<D>,
 		   bf::append2(jmodel,
-			       boost::ref(boost::get<typename D::JointData>(jdataSpec)),
+			       boost::ref(*jdata),
 			       static_cast<const Visitor*>(this)->args));
       }
 
@@ -63,7 +94,7 @@ namespace se3
 		      JointDataVariant & jdata,
 		      ArgsTmp args)
       {
-	return boost::apply_visitor( Visitor(jdata,args),jmodel );
+	dispatch(Visitor(jdata,args),jmodel);
       }
     };
 
@@ -84,7 +115,7 @@ namespace se3
       static void run(const JointModelVariant & jmodel,
           ArgsTmp args)
       {
-  return boost::apply_visitor( Visitor(args),jmodel );
+  dispatch(Visitor(args),jmodel);
       }
     };
   
@@ -120,6 +120,8 @@ namespace se3
              " Remark: co1 < co2")
         .def("addAllCollisionPairs",&GeometryDataPythonVisitor::addAllCollisionPairs,
              "Add all collision pairs.")
+        .def("addAdmissibleCollisionPairs",&GeometryDataPythonVisitor::addAdmissibleCollisionPairs,
+             "Add the collision pairs which are not on the same or adjacent joints, and whose collision groups and masks match.")
         .def("addCollisionPairsFromSrdf",&GeometryDataPythonVisitor::addCollisionPairsFromSrdf,
               bp::args("filename (string)","verbose (bool)"),
               "Activate collision pairs contained in an SRDF file.")
@@ -149,6 +151,15 @@ namespace se3
              "The results are stored in collision_results.")
         .def("isColliding",&GeometryDataPythonVisitor::isColliding,
              "Check if at least one of the collision pairs is in collision.")
+        .def("setBooleanOnlyCollisions",&GeometryDataPythonVisitor::setBooleanOnlyCollisions,
+             bp::args("boolean_only (bool)"),
+             "If true, computeAllCollisions only stores the collision status of the pairs and collision_results is left empty.")
+        .def("setBroadPhase",&GeometryDataPythonVisitor::setBroadPhase,
+             bp::args("enable (bool)"),
+             "Enable or disable the selection of the collision pairs by their bounding boxes before the narrow phase.")
+        .def("setCollisionProxies",&GeometryDataPythonVisitor::setCollisionProxies,
+             bp::args("enable (bool)"),
+             "Enable or disable the collision tests on the proxy geometries (e.g. bounding capsules of the meshes) before the actual geometries.")
         
         .def("computeDistance",&GeometryDataPythonVisitor::computeDistance,
              bp::args("co1 (index)","co2 (index)"),
@@ -183,6 +194,10 @@ namespace se3
       {
         m->addAllCollisionPairs();
       }
+      static void addAdmissibleCollisionPairs (GeometryDataHandler & m)
+      {
+        m->addAdmissibleCollisionPairs();
+      }
       
       static void removeCollisionPair (GeometryDataHandler & m, const GeomIndex co1, const GeomIndex co2)
       {
@@ -208,6 +223,9 @@ namespace se3
       }
       static bool isColliding(const GeometryDataHandler & m) { return m->isColliding(); }
       static void computeAllCollisions(GeometryDataHandler & m) { m->computeAllCollisions(); }
+      static void setBooleanOnlyCollisions(GeometryDataHandler & m, const bool boolean_only) { m->setBooleanOnlyCollisions(boolean_only); }
+      static void setBroadPhase(GeometryDataHandler & m, const bool enable) { m->setBroadPhase(enable); }
+      static void setCollisionProxies(GeometryDataHandler & m, const bool enable) { m->setCollisionProxies(enable); }
       
       static DistanceResult computeDistance(const GeometryDataHandler & m, const GeomIndex co1, const GeomIndex co2)
       {
@@ -0,0 +1,435 @@
+//
+// Copyright (c) 2016 CNRS
+//
+// This file is part of Pinocchio
+// Pinocchio is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// Pinocchio is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Lesser Public License for more details. You should have
+// received a copy of the GNU Lesser General Public License along with
+// Pinocchio If not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef __se3_act_on_batch_hpp__
+#define __se3_act_on_batch_hpp__
+
+#include <Eigen/Core>
+#include "pinocchio/spatial/fwd.hpp"
+#include "pinocchio/spatial/se3.hpp"
+#include "pinocchio/spatial/inertia.hpp"
+
+namespace se3
+{
+  namespace batch
+  {
+    /* A batch stores the same spatial quantity for N independent samples
+     * (structure-of-arrays). Each row corresponds to one component and each
+     * column to one sample. The storage is row major, so that a given component
+     * is contiguous in memory along the sample dimension and the kernels below
+     * can be vectorized over the samples. */
+    typedef Eigen::Matrix<double,6,Eigen::Dynamic,Eigen::RowMajor> Matrix6x;
+    typedef Eigen::Matrix<double,9,Eigen::Dynamic,Eigen::RowMajor> Matrix9x;
+    typedef Eigen::Matrix<double,3,Eigen::Dynamic,Eigen::RowMajor> Matrix3x;
+
+    ///
+    /// \brief Batch of rigid placements. The rotation of sample k is stored
+    ///        row-wise in rotation.col(k), i.e. R(r,c) = rotation(3*r+c,k).
+    ///
+    struct SE3Batch
+    {
+      Matrix9x rotation;
+      Matrix3x translation;
+
+      SE3Batch() : rotation(), translation() {}
+      explicit SE3Batch(const int n) : rotation(9,n), translation(3,n) {}
+
+      int size() const { return (int)rotation.cols(); }
+
+      void resize(const int n) { rotation.resize(9,n); translation.resize(3,n); }
+
+      void setIdentity()
+      {
+        rotation.setZero();
+        rotation.row(0).setOnes(); rotation.row(4).setOnes(); rotation.row(8).setOnes();
+        translation.setZero();
+      }
+
+      /// \brief Store M as the placement of sample k.
+      void set(const int k, const SE3 & M)
+      {
+        const SE3::Matrix3 & R = M.rotation();
+        for(int r=0;r<3;++r)
+          for(int c=0;c<3;++c)
+            rotation(3*r+c,k) = R(r,c);
+        translation.col(k) = M.translation();
+      }
+
+      /// \brief Return the placement of sample k.
+      SE3 get(const int k) const
+      {
+        SE3::Matrix3 R;
+        for(int r=0;r<3;++r)
+          for(int c=0;c<3;++c)
+            R(r,c) = rotation(3*r+c,k);
+        return SE3(R,translation.col(k));
+      }
+    }; // struct SE3Batch
+
+    /* A pack is a fixed number N of samples loaded in registers: each component
+     * of the spatial quantity is an Eigen::Array of N lanes, so that a single
+     * kernel call performs the same operation on the N samples with packet
+     * (SSE/AVX) instructions. N = 4 (resp. 8) fills one AVX (resp. one AVX-512)
+     * double register per component. */
+
+    ///
+    /// \brief Pack of N rigid placements. R(r,c) of lane l is rotation[3*r+c][l].
+    ///
+    template<int N>
+    struct SE3Pack
+    {
+      EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+      typedef Eigen::Array<double,N,1> Lanes;
+      enum { Size = N };
+
+      Lanes rotation[9];
+      Lanes translation[3];
+
+      /// \brief Load the samples k, ..., k+N-1 of M.
+      void load(const SE3Batch & M, const long k)
+      {
+        for(int c=0;c<9;++c) rotation[c] = M.rotation.row(c).template segment<N>(k).transpose();
+        for(int c=0;c<3;++c) translation[c] = M.translation.row(c).template segment<N>(k).transpose();
+      }
+
+      /// \brief Store the pack as the samples k, ..., k+N-1 of M.
+      void store(SE3Batch & M, const long k) const
+      {
+        for(int c=0;c<9;++c) M.rotation.row(c).template segment<N>(k) = rotation[c].transpose();
+        for(int c=0;c<3;++c) M.translation.row(c).template segment<N>(k) = translation[c].transpose();
+      }
+
+      /// \brief Store M in the lane l.
+      void set(const int l, const SE3 & M)
+      {
+        for(int r=0;r<3;++r)
+          for(int c=0;c<3;++c)
+            rotation[3*r+c][l] = M.rotation()(r,c);
+        for(int c=0;c<3;++c) translation[c][l] = M.translation()[c];
+      }
+
+      /// \brief Return the placement of the lane l.
+      SE3 get(const int l) const
+      {
+        SE3::Matrix3 R; SE3::Vector3 p;
+        for(int r=0;r<3;++r)
+          for(int c=0;c<3;++c)
+            R(r,c) = rotation[3*r+c][l];
+        for(int c=0;c<3;++c) p[c] = translation[c][l];
+        return SE3(R,p);
+      }
+    }; // struct SE3Pack
+
+    ///
+    /// \brief Pack of N motions or forces, with the same (linear, angular) layout as the rows of se3::batch::Matrix6x.
+    ///
+    template<int N>
+    struct Vector6Pack
+    {
+      EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+      typedef Eigen::Array<double,N,1> Lanes;
+      enum { Size = N };
+
+      Lanes linear[3];
+      Lanes angular[3];
+
+      /// \brief Load the samples k, ..., k+N-1 of V.
+      void load(const Matrix6x & V, const long k)
+      {
+        for(int c=0;c<3;++c)
+        {
+          linear[c] = V.row(c).template segment<N>(k).transpose();
+          angular[c] = V.row(c+3).template segment<N>(k).transpose();
+        }
+      }
+
+      /// \brief Add the pack to the samples k, ..., k+N-1 of V.
+      void addTo(Matrix6x & V, const long k) const
+      {
+        for(int c=0;c<3;++c)
+        {
+          V.row(c).template segment<N>(k) += linear[c].matrix().transpose();
+          V.row(c+3).template segment<N>(k) += angular[c].matrix().transpose();
+        }
+      }
+    }; // struct Vector6Pack
+
+    typedef SE3Pack<4> SE3x4;
+    typedef SE3Pack<8> SE3x8;
+    typedef Vector6Pack<4> Vector6x4;
+    typedef Vector6Pack<8> Vector6x8;
+
+    namespace internal
+    {
+      /* y = R x (resp. R^T x) and z = x ^ y, lane-wise. The outputs must not alias the inputs. */
+      template<typename Lanes>
+      inline void rotate(const Lanes * R, const Lanes * x, Lanes * y)
+      {
+        y[0] = R[0]*x[0] + R[1]*x[1] + R[2]*x[2];
+        y[1] = R[3]*x[0] + R[4]*x[1] + R[5]*x[2];
+        y[2] = R[6]*x[0] + R[7]*x[1] + R[8]*x[2];
+      }
+
+      template<typename Lanes>
+      inline void rotateTranspose(const Lanes * R, const Lanes * x, Lanes * y)
+      {
+        y[0] = R[0]*x[0] + R[3]*x[1] + R[6]*x[2];
+        y[1] = R[1]*x[0] + R[4]*x[1] + R[7]*x[2];
+        y[2] = R[2]*x[0] + R[5]*x[1] + R[8]*x[2];
+      }
+
+      template<typename Lanes>
+      inline void cross(const Lanes * x, const Lanes * y, Lanes * z)
+      {
+        z[0] = x[1]*y[2] - x[2]*y[1];
+        z[1] = x[2]*y[0] - x[0]*y[2];
+        z[2] = x[0]*y[1] - x[1]*y[0];
+      }
+    } // namespace internal
+
+    /* The pack kernels below overwrite their output, which must not alias any input. */
+
+    ///
+    /// \brief res = M1 * M2, lane-wise.
+    ///
+    template<int N>
+    inline void compose(const SE3Pack<N> & M1, const SE3Pack<N> & M2, SE3Pack<N> & res)
+    {
+      const typename SE3Pack<N>::Lanes * R1 = M1.rotation, * R2 = M2.rotation;
+      for(int r=0;r<3;++r)
+        for(int c=0;c<3;++c)
+          res.rotation[3*r+c] = R1[3*r]*R2[c] + R1[3*r+1]*R2[3+c] + R1[3*r+2]*R2[6+c];
+      internal::rotate(R1,M2.translation,res.translation);
+      for(int c=0;c<3;++c) res.translation[c] += M1.translation[c];
+    }
+
+    ///
+    /// \brief res = M v, lane-wise, with v a pack of motions.
+    ///
+    template<int N>
+    inline void motionAction(const SE3Pack<N> & M, const Vector6Pack<N> & v, Vector6Pack<N> & res)
+    {
+      typename SE3Pack<N>::Lanes pxw[3];
+      /* ( R v + p x R w, R w ) */
+      internal::rotate(M.rotation,v.angular,res.angular);
+      internal::rotate(M.rotation,v.linear,res.linear);
+      internal::cross(M.translation,res.angular,pxw);
+      for(int c=0;c<3;++c) res.linear[c] += pxw[c];
+    }
+
+    ///
+    /// \brief res = M^{-1} v, lane-wise, with v a pack of motions.
+    ///
+    template<int N>
+    inline void motionActionInverse(const SE3Pack<N> & M, const Vector6Pack<N> & v, Vector6Pack<N> & res)
+    {
+      typename SE3Pack<N>::Lanes d[3];
+      /* ( R^T (v - p x w), R^T w ) */
+      internal::cross(M.translation,v.angular,d);
+      for(int c=0;c<3;++c) d[c] = v.linear[c] - d[c];
+      internal::rotateTranspose(M.rotation,d,res.linear);
+      internal::rotateTranspose(M.rotation,v.angular,res.angular);
+    }
+
+    ///
+    /// \brief res = M f, lane-wise, with f a pack of forces.
+    ///
+    template<int N>
+    inline void forceAction(const SE3Pack<N> & M, const Vector6Pack<N> & f, Vector6Pack<N> & res)
+    {
+      typename SE3Pack<N>::Lanes pxf[3];
+      /* ( R f, p x R f + R n ) */
+      internal::rotate(M.rotation,f.linear,res.linear);
+      internal::rotate(M.rotation,f.angular,res.angular);
+      internal::cross(M.translation,res.linear,pxf);
+      for(int c=0;c<3;++c) res.angular[c] += pxf[c];
+    }
+
+    ///
+    /// \brief res = M^{-1} f, lane-wise, with f a pack of forces.
+    ///
+    template<int N>
+    inline void forceActionInverse(const SE3Pack<N> & M, const Vector6Pack<N> & f, Vector6Pack<N> & res)
+    {
+      typename SE3Pack<N>::Lanes d[3];
+      /* ( R^T f, R^T (n - p x f) ) */
+      internal::cross(M.translation,f.linear,d);
+      for(int c=0;c<3;++c) d[c] = f.angular[c] - d[c];
+      internal::rotateTranspose(M.rotation,f.linear,res.linear);
+      internal::rotateTranspose(M.rotation,d,res.angular);
+    }
+
+    /// \brief Number of samples processed per pack by the batch kernels below.
+    enum { PACK_SIZE = 4 };
+
+    /* All the kernels below accumulate their result in the output batch (+=).
+     * The output must not alias any input. */
+
+    ///
+    /// \brief jV += M^{-1} iV, for each sample, with iV and jV batches of motions.
+    ///
+    inline void motionActionInverse(const SE3Batch & M, const Matrix6x & iV, Matrix6x & jV)
+    {
+      const Matrix9x & R = M.rotation;
+      const Matrix3x & p = M.translation;
+      long k = 0;
+      for(;k+PACK_SIZE<=iV.cols();k+=PACK_SIZE)
+      {
+        SE3Pack<PACK_SIZE> Mk; Vector6Pack<PACK_SIZE> iVk, jVk;
+        Mk.load(M,k); iVk.load(iV,k);
+        motionActionInverse(Mk,iVk,jVk);
+        jVk.addTo(jV,k);
+      }
+      for(;k<iV.cols();++k)
+      {
+        const double wx = iV(3,k), wy = iV(4,k), wz = iV(5,k);
+        /* d = v - p x w */
+        const double dx = iV(0,k) - (p(1,k)*wz - p(2,k)*wy);
+        const double dy = iV(1,k) - (p(2,k)*wx - p(0,k)*wz);
+        const double dz = iV(2,k) - (p(0,k)*wy - p(1,k)*wx);
+        /* ( R' d, R' w ) */
+        jV(0,k) += R(0,k)*dx + R(3,k)*dy + R(6,k)*dz;
+        jV(1,k) += R(1,k)*dx + R(4,k)*dy + R(7,k)*dz;
+        jV(2,k) += R(2,k)*dx + R(5,k)*dy + R(8,k)*dz;
+        jV(3,k) += R(0,k)*wx + R(3,k)*wy + R(6,k)*wz;
+        jV(4,k) += R(1,k)*wx + R(4,k)*wy + R(7,k)*wz;
+        jV(5,k) += R(2,k)*wx + R(5,k)*wy + R(8,k)*wz;
+      }
+    }
+
+    ///
+    /// \brief jF += M iF, for each sample, with iF and jF batches of forces.
+    ///
+    inline void forceAction(const SE3Batch & M, const Matrix6x & iF, Matrix6x & jF)
+    {
+      const Matrix9x & R = M.rotation;
+      const Matrix3x & p = M.translation;
+      long k = 0;
+      for(;k+PACK_SIZE<=iF.cols();k+=PACK_SIZE)
+      {
+        SE3Pack<PACK_SIZE> Mk; Vector6Pack<PACK_SIZE> iFk, jFk;
+        Mk.load(M,k); iFk.load(iF,k);
+        forceAction(Mk,iFk,jFk);
+        jFk.addTo(jF,k);
+      }
+      for(;k<iF.cols();++k)
+      {
+        const double fx = iF(0,k), fy = iF(1,k), fz = iF(2,k);
+        const double nx = iF(3,k), ny = iF(4,k), nz = iF(5,k);
+        /* ( R f, p x R f + R n ) */
+        const double Rfx = R(0,k)*fx + R(1,k)*fy + R(2,k)*fz;
+        const double Rfy = R(3,k)*fx + R(4,k)*fy + R(5,k)*fz;
+        const double Rfz = R(6,k)*fx + R(7,k)*fy + R(8,k)*fz;
+        jF(0,k) += Rfx;
+        jF(1,k) += Rfy;
+        jF(2,k) += Rfz;
+        jF(3,k) += R(0,k)*nx + R(1,k)*ny + R(2,k)*nz + p(1,k)*Rfz - p(2,k)*Rfy;
+        jF(4,k) += R(3,k)*nx + R(4,k)*ny + R(5,k)*nz + p(2,k)*Rfx - p(0,k)*Rfz;
+        jF(5,k) += R(6,k)*nx + R(7,k)*ny + R(8,k)*nz + p(0,k)*Rfy - p(1,k)*Rfx;
+      }
+    }
+
+    ///
+    /// \brief res = M1 * M2, for each sample. Contrary to the other batch kernels, res is overwritten.
+    ///
+    inline void compose(const SE3Batch & M1, const SE3Batch & M2, SE3Batch & res)
+    {
+      long k = 0;
+      for(;k+PACK_SIZE<=M1.size();k+=PACK_SIZE)
+      {
+        SE3Pack<PACK_SIZE> M1k, M2k, Mk;
+        M1k.load(M1,k); M2k.load(M2,k);
+        compose(M1k,M2k,Mk);
+        Mk.store(res,k);
+      }
+      for(;k<M1.size();++k)
+        res.set((int)k,M1.get((int)k)*M2.get((int)k));
+    }
+
+    ///
+    /// \brief res += v1 x v2 (motion cross product), for each sample.
+    ///
+    inline void motionCross(const Matrix6x & v1, const Matrix6x & v2, Matrix6x & res)
+    {
+      for(long k=0;k<v1.cols();++k)
+      {
+        const double vx = v1(0,k), vy = v1(1,k), vz = v1(2,k);
+        const double wx = v1(3,k), wy = v1(4,k), wz = v1(5,k);
+        const double ux = v2(0,k), uy = v2(1,k), uz = v2(2,k);
+        const double ox = v2(3,k), oy = v2(4,k), oz = v2(5,k);
+        /* ( v x o + w x u, w x o ) */
+        res(0,k) += vy*oz - vz*oy + wy*uz - wz*uy;
+        res(1,k) += vz*ox - vx*oz + wz*ux - wx*uz;
+        res(2,k) += vx*oy - vy*ox + wx*uy - wy*ux;
+        res(3,k) += wy*oz - wz*oy;
+        res(4,k) += wz*ox - wx*oz;
+        res(5,k) += wx*oy - wy*ox;
+      }
+    }
+
+    ///
+    /// \brief res += v x* f (dual cross product of a motion and a force), for each sample.
+    ///
+    inline void forceCross(const Matrix6x & v, const Matrix6x & f, Matrix6x & res)
+    {
+      for(long k=0;k<v.cols();++k)
+      {
+        const double vx = v(0,k), vy = v(1,k), vz = v(2,k);
+        const double wx = v(3,k), wy = v(4,k), wz = v(5,k);
+        const double fx = f(0,k), fy = f(1,k), fz = f(2,k);
+        const double nx = f(3,k), ny = f(4,k), nz = f(5,k);
+        /* ( w x f, w x n + v x f ) */
+        res(0,k) += wy*fz - wz*fy;
+        res(1,k) += wz*fx - wx*fz;
+        res(2,k) += wx*fy - wy*fx;
+        res(3,k) += wy*nz - wz*ny + vy*fz - vz*fy;
+        res(4,k) += wz*nx - wx*nz + vz*fx - vx*fz;
+        res(5,k) += wx*ny - wy*nx + vx*fy - vy*fx;
+      }
+    }
+
+    ///
+    /// \brief f += Y v, for each sample, where the inertia Y is shared by all the samples.
+    ///
+    inline void inertiaAction(const Inertia & Y, const Matrix6x & v, Matrix6x & f)
+    {
+      const double m = Y.mass();
+      const double cx = Y.lever()[0], cy = Y.lever()[1], cz = Y.lever()[2];
+      const Inertia::Symmetric3 & I = Y.inertia();
+      const double I00 = I(0,0), I01 = I(0,1), I02 = I(0,2);
+      const double I11 = I(1,1), I12 = I(1,2), I22 = I(2,2);
+      for(long k=0;k<v.cols();++k)
+      {
+        const double wx = v(3,k), wy = v(4,k), wz = v(5,k);
+        /* f = m (v - c x w) */
+        const double fx = m*(v(0,k) - (cy*wz - cz*wy));
+        const double fy = m*(v(1,k) - (cz*wx - cx*wz));
+        const double fz = m*(v(2,k) - (cx*wy - cy*wx));
+        /* n = c x f + I w */
+        f(0,k) += fx;
+        f(1,k) += fy;
+        f(2,k) += fz;
+        f(3,k) += cy*fz - cz*fy + I00*wx + I01*wy + I02*wz;
+        f(4,k) += cz*fx - cx*fz + I01*wx + I11*wy + I12*wz;
+        f(5,k) += cx*fy - cy*fx + I02*wx + I12*wy + I22*wz;
+      }
+    }
+
+  } // namespace batch
+} // namespace se3
+
+#endif // ifndef __se3_act_on_batch_hpp__
@@ -0,0 +1,207 @@
+//
+// Copyright (c) 2016 CNRS
+//
+// This file is part of Pinocchio
+// Pinocchio is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// Pinocchio is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Lesser Public License for more details. You should have
+// received a copy of the GNU Lesser General Public License along with
+// Pinocchio If not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef __se3_thread_pool_hpp__
+#define __se3_thread_pool_hpp__
+
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/scoped_array.hpp>
+#include <boost/bind.hpp>
+#include <boost/noncopyable.hpp>
+#include <algorithm>
+#include <cassert>
+
+namespace se3
+{
+  namespace parallel
+  {
+    ///
+    /// \brief Task executed by a ThreadPool: operator() is called once for each index k in [0,n),
+    ///        by the worker of index worker in [0,pool.size()).
+    ///
+    struct Job
+    {
+      virtual ~Job() {}
+      virtual void operator() (const int worker, const int k) = 0;
+    };
+
+    ///
+    /// \brief Pool of persistent worker threads, executing the indexes of a Job with work stealing.
+    ///
+    /// \note The index range is first split in pool.size() contiguous blocks, one per worker. Each worker
+    ///       processes its own block from the front; once it is empty, it steals the back half of the
+    ///       remaining block of another worker. This balances calls of heterogeneous cost (e.g. collision checks).
+    ///       The calling thread takes part in the computations as the worker 0.
+    ///
+    class ThreadPool : boost::noncopyable
+    {
+    public:
+      ///
+      /// \brief Create a pool of nthreads workers (the calling thread included).
+      ///
+      /// \param[in] nthreads The number of workers. By default, the number of hardware threads.
+      ///
+      explicit ThreadPool(const int nthreads = defaultNumThreads())
+        : nworkers(std::max(nthreads,1))
+        , ranges(new Range[(std::size_t)nworkers])
+        , job(NULL)
+        , generation(0)
+        , active(0)
+        , stop(false)
+      {
+        for(int w=1;w<nworkers;++w)
+          threads.create_thread(boost::bind(&ThreadPool::workerLoop,this,w));
+      }
+
+      ~ThreadPool()
+      {
+        {
+          boost::mutex::scoped_lock lock(mutex);
+          stop = true;
+        }
+        start_cond.notify_all();
+        threads.join_all();
+      }
+
+      /// \brief Number of workers of the pool.
+      int size() const { return nworkers; }
+
+      /// \brief Number of threads supported by the hardware (at least 1).
+      static int defaultNumThreads()
+      {
+        return std::max((int)boost::thread::hardware_concurrency(),1);
+      }
+
+      ///
+      /// \brief Execute job(worker,k) for all k in [0,n). The call returns once all the indexes have been processed.
+      ///
+      /// \param[in] job The job to execute.
+      /// \param[in] n The number of indexes.
+      ///
+      void run(Job & job_, const int n)
+      {
+        assert(n >= 0);
+        for(int w=0;w<nworkers;++w)
+        {
+          ranges[w].begin = (int)(((long)n*w)/nworkers);
+          ranges[w].end = (int)(((long)n*(w+1))/nworkers);
+        }
+
+        {
+          boost::mutex::scoped_lock lock(mutex);
+          job = &job_;
+          active = nworkers-1;
+          ++generation;
+        }
+        start_cond.notify_all();
+
+        process(0);
+
+        boost::mutex::scoped_lock lock(mutex);
+        while(active > 0) done_cond.wait(lock);
+        job = NULL;
+      }
+
+    private:
+      struct Range
+      {
+        boost::mutex mutex;
+        int begin, end;
+        Range() : begin(0), end(0) {}
+      };
+
+      void workerLoop(const int worker)
+      {
+        unsigned long last_generation = 0;
+        while(true)
+        {
+          {
+            boost::mutex::scoped_lock lock(mutex);
+            while(generation == last_generation && !stop) start_cond.wait(lock);
+            if(stop) return;
+            last_generation = generation;
+          }
+
+          process(worker);
+
+          boost::mutex::scoped_lock lock(mutex);
+          if(--active == 0) done_cond.notify_one();
+        }
+      }
+
+      void process(const int worker)
+      {
+        int k;
+        while(pop(worker,k) || steal(worker,k))
+          (*job)(worker,k);
+      }
+
+      /// \brief Take the next index of the block of worker.
+      bool pop(const int worker, int & k)
+      {
+        Range & range = ranges[worker];
+        boost::mutex::scoped_lock lock(range.mutex);
+        if(range.begin >= range.end) return false;
+        k = range.begin++;
+        return true;
+      }
+
+      /// \brief Take the back half of the block of another worker: k is its first index, the rest becomes the block of worker.
+      bool steal(const int worker, int & k)
+      {
+        for(int offset=1;offset<nworkers;++offset)
+        {
+          Range & victim = ranges[(worker+offset)%nworkers];
+          int begin, end;
+          {
+            boost::mutex::scoped_lock lock(victim.mutex);
+            const int remaining = victim.end - victim.begin;
+            if(remaining <= 0) continue;
+            end = victim.end;
+            begin = victim.end - (remaining+1)/2;
+            victim.end = begin;
+          }
+
+          k = begin;
+          Range & range = ranges[worker];
+          boost::mutex::scoped_lock lock(range.mutex);
+          range.begin = begin+1;
+          range.end = end;
+          return true;
+        }
+        return false;
+      }
+
+      const int nworkers;
+      boost::scoped_array<Range> ranges;
+      boost::thread_group threads;
+
+      boost::mutex mutex;
+      boost::condition_variable start_cond;
+      boost::condition_variable done_cond;
+      Job * job;
+      unsigned long generation;
+      int active;
+      bool stop;
+    }; // class ThreadPool
+
+  } // namespace parallel
+} // namespace se3
+
+#endif // ifndef __se3_thread_pool_hpp__
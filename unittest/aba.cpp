@@ -94,4 +94,66 @@ BOOST_AUTO_TEST_CASE ( test_aba_vs_rnea )
   BOOST_CHECK(data.ddq.isApprox(a, 1e-12));
   
 }
+
+BOOST_AUTO_TEST_CASE ( test_aba_spherical_translation )
+{
+  using namespace Eigen;
+  using namespace se3;
+  
+  // The update of the articulated inertia by calc_aba must read the inertia blocks before clearing them.
+  se3::Model model;
+  JointIndex i = 0;
+  i = model.addBody(i,JointModelSpherical(),SE3::Random(),Inertia::Random(),"sph_joint","sph_body");
+  i = model.addBody(i,JointModelTranslation(),SE3::Random(),Inertia::Random(),"trans_joint","trans_body");
+  i = model.addBody(i,JointModelRX(),SE3::Random(),Inertia::Random(),"rx_joint","rx_body");
+  i = model.addBody(i,JointModelSpherical(),SE3::Random(),Inertia::Random(),"sph2_joint","sph2_body");
+  model.addBody(i,JointModelTranslation(),SE3::Random(),Inertia::Random(),"trans2_joint","trans2_body");
+  
+  se3::Data data(model);
+  se3::Data data_ref(model);
+  
+  VectorXd q = VectorXd::Random(model.nq);
+  q.segment<4>(idx_q(model.joints[1])).normalize();
+  q.segment<4>(idx_q(model.joints[4])).normalize();
+  const VectorXd v = VectorXd::Random(model.nv);
+  const VectorXd tau = VectorXd::Random(model.nv);
+  
+  crba(model, data_ref, q);
+  nonLinearEffects(model, data_ref, q, v);
+  data_ref.M.triangularView<Eigen::StrictlyLower>()
+  = data_ref.M.transpose().triangularView<Eigen::StrictlyLower>();
+  
+  aba(model, data, q, v, tau);
+  BOOST_CHECK(data.ddq.isApprox(data_ref.M.inverse() * (tau - data_ref.nle), 1e-10));
+}
+
+BOOST_AUTO_TEST_CASE ( test_computeMinverse )
+{
+  using namespace Eigen;
+  using namespace se3;
+  
+  for(int usingFF=0;usingFF<2;++usingFF)
+  {
+    se3::Model model; buildModels::humanoidSimple(model,usingFF==1);
+    
+    se3::Data data(model);
+    se3::Data data_ref(model);
+    
+    VectorXd q = VectorXd::Random(model.nq);
+    if(usingFF==1) q.segment<4>(3).normalize();
+    
+    crba(model, data_ref, q);
+    data_ref.M.triangularView<Eigen::StrictlyLower>()
+    = data_ref.M.transpose().triangularView<Eigen::StrictlyLower>();
+    
+    computeMinverse(model, data, q);
+    BOOST_CHECK(data.Minv.isApprox(data_ref.M.inverse(), 1e-12));
+    
+    // Minv is the map from the joint torques to the joint accelerations, without velocity nor gravity.
+    model.gravity.setZero();
+    const VectorXd tau = VectorXd::Random(model.nv);
+    aba(model, data_ref, q, VectorXd::Zero(model.nv), tau);
+    BOOST_CHECK(data_ref.ddq.isApprox(data.Minv*tau, 1e-12));
+  }
+}
 BOOST_AUTO_TEST_SUITE_END ()
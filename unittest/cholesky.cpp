@@ -225,4 +225,56 @@ BOOST_AUTO_TEST_CASE ( test_timings )
 
 }
 
+BOOST_AUTO_TEST_CASE ( test_cholesky_sparse )
+{
+  using namespace Eigen;
+  using namespace se3;
+
+  se3::Model model;
+  se3::buildModels::humanoidSimple(model,true);
+  se3::Data data(model), data_ref(model);
+
+  VectorXd q = VectorXd::Random(model.nq);
+  q.segment <4> (3).normalize();
+  crba(model,data_ref,q);
+  se3::cholesky::decompose(model,data_ref);
+  data_ref.M.triangularView<Eigen::StrictlyLower>() =
+  data_ref.M.triangularView<Eigen::StrictlyUpper>().transpose();
+  const Eigen::MatrixXd & M = data_ref.M;
+  const Eigen::MatrixXd & U = data_ref.U;
+
+  crbaSparse(model,data,q);
+  se3::cholesky::decomposeSparse(model,data);
+  BOOST_CHECK(data.D.isApprox(data_ref.D, 1e-12));
+  Eigen::MatrixXd U_sparse (data.Usparse.dense().triangularView<Eigen::StrictlyUpper>());
+  U_sparse.diagonal().setOnes();
+  BOOST_CHECK(U_sparse.isApprox(U, 1e-12));
+
+  Eigen::VectorXd v = Eigen::VectorXd::Random(model.nv);
+
+  Eigen::VectorXd Uv = v; se3::cholesky::UvSparse(model,data,Uv);
+  BOOST_CHECK(Uv.isApprox(U*v, 1e-12));
+
+  Eigen::VectorXd Utv = v; se3::cholesky::UtvSparse(model,data,Utv);
+  BOOST_CHECK(Utv.isApprox(U.transpose()*v, 1e-12));
+
+  Eigen::VectorXd Uiv = v; se3::cholesky::UivSparse(model,data,Uiv);
+  BOOST_CHECK(Uiv.isApprox(U.inverse()*v, 1e-12));
+
+  Eigen::VectorXd Utiv = v; se3::cholesky::UtivSparse(model,data,Utiv);
+  BOOST_CHECK(Utiv.isApprox(U.transpose().inverse()*v, 1e-12));
+
+  Eigen::VectorXd Miv = v; se3::cholesky::solveSparse(model,data,Miv);
+  BOOST_CHECK(Miv.isApprox(M.inverse()*v, 1e-12));
+
+  Eigen::MatrixXd Mi (Eigen::MatrixXd::Identity(model.nv,model.nv));
+  se3::cholesky::solveSparse(model,data,Mi);
+  BOOST_CHECK(Mi.isApprox(M.inverse(), 1e-12));
+
+  Eigen::VectorXd Mv = v; se3::cholesky::MvSparse(model,data,Mv,true);
+  BOOST_CHECK(Mv.isApprox(M*v, 1e-12));
+  Mv = v;                 se3::cholesky::MvSparse(model,data,Mv,false);
+  BOOST_CHECK(Mv.isApprox(M*v, 1e-12));
+}
+
 BOOST_AUTO_TEST_SUITE_END ()
@@ -0,0 +1,77 @@
+//
+// Copyright (c) 2016 CNRS
+//
+// This file is part of Pinocchio
+// Pinocchio is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// Pinocchio is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Lesser Public License for more details. You should have
+// received a copy of the GNU Lesser General Public License along with
+// Pinocchio If not, see
+// <http://www.gnu.org/licenses/>.
+
+#include "pinocchio/multibody/model.hpp"
+#include "pinocchio/algorithm/kinematics.hpp"
+#include "pinocchio/algorithm/rnea.hpp"
+#include "pinocchio/algorithm/aba.hpp"
+#include "pinocchio/multibody/parser/sample-models.hpp"
+
+// Generated at build time by pinocchio_generate_c_kernels -f HS codegen_humanoid_simple
+#include "codegen_humanoid_simple.h"
+
+#include <iostream>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE CodegenKernelsTest
+#include <boost/test/unit_test.hpp>
+#include <boost/utility/binary.hpp>
+
+BOOST_AUTO_TEST_SUITE ( CodegenKernelsTest )
+
+BOOST_AUTO_TEST_CASE ( test_generated_kernels )
+{
+  using namespace Eigen;
+  using namespace se3;
+
+  // Same model as the one given to the generator.
+  se3::Model model;
+  se3::buildModels::humanoidSimple(model,true);
+  BOOST_CHECK(model.nq == CODEGEN_HUMANOID_SIMPLE_NQ);
+  BOOST_CHECK(model.nv == CODEGEN_HUMANOID_SIMPLE_NV);
+  BOOST_CHECK(model.nbody == CODEGEN_HUMANOID_SIMPLE_NBODY);
+  se3::Data data(model);
+
+  VectorXd tau (model.nv), ddq (model.nv);
+  std::vector<double> oMi (12*(std::size_t)model.nbody);
+  for(int k=0;k<10;++k)
+  {
+    VectorXd q (VectorXd::Random(model.nq));
+    q.segment<4>(3).normalize();
+    const VectorXd v (VectorXd::Random(model.nv));
+    const VectorXd a (VectorXd::Random(model.nv));
+
+    codegen_humanoid_simple_forward_kinematics(q.data(),oMi.data());
+    forwardKinematics(model,data,q);
+    for(Model::JointIndex i=0;i<(Model::JointIndex)model.nbody;++i)
+    {
+      const Map<const Matrix3d> R (&oMi[12*i]);
+      const Map<const Vector3d> p (&oMi[12*i+9]);
+      BOOST_CHECK(R.isApprox(data.oMi[i].rotation(), 1e-12));
+      BOOST_CHECK((p - data.oMi[i].translation()).norm() <= 1e-12);
+    }
+
+    codegen_humanoid_simple_rnea(q.data(),v.data(),a.data(),tau.data());
+    BOOST_CHECK(tau.isApprox(rnea(model,data,q,v,a), 1e-12));
+
+    codegen_humanoid_simple_aba(q.data(),v.data(),tau.data(),ddq.data());
+    BOOST_CHECK(ddq.isApprox(aba(model,data,q,v,tau), 1e-12));
+    BOOST_CHECK(ddq.isApprox(a, 1e-10));
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
@@ -0,0 +1,169 @@
+//
+// Copyright (c) 2016 CNRS
+//
+// This file is part of Pinocchio
+// Pinocchio is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// Pinocchio is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Lesser Public License for more details. You should have
+// received a copy of the GNU Lesser General Public License along with
+// Pinocchio If not, see
+// <http://www.gnu.org/licenses/>.
+
+#include "pinocchio/multibody/model.hpp"
+#include "pinocchio/algorithm/kinematics.hpp"
+#include "pinocchio/algorithm/rnea.hpp"
+#include "pinocchio/algorithm/aba.hpp"
+#include "pinocchio/algorithm/jacobian.hpp"
+#include "pinocchio/algorithm/operational-frames.hpp"
+#include "pinocchio/algorithm/codegen.hpp"
+#include "pinocchio/multibody/parser/sample-models.hpp"
+
+#include <iostream>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE CodegenTest
+#include <boost/test/unit_test.hpp>
+#include <boost/utility/binary.hpp>
+
+namespace
+{
+  Eigen::VectorXd randomConfiguration(const se3::Model & model)
+  {
+    Eigen::VectorXd q (Eigen::VectorXd::Random(model.nq));
+    for(se3::JointIndex i=1;i<(se3::JointIndex)model.nbody;++i)
+    {
+      const int idx_q = se3::idx_q(model.joints[i]);
+      if(model.joints[i].which() == se3::JOINT_FREE_FLYER) q.segment<4>(idx_q+3).normalize();
+      if(model.joints[i].which() == se3::JOINT_SPHERICAL) q.segment<4>(idx_q).normalize();
+    }
+    return q;
+  }
+
+  std::vector<double> concatenate(const Eigen::VectorXd & x, const Eigen::VectorXd & y = Eigen::VectorXd(),
+                                  const Eigen::VectorXd & z = Eigen::VectorXd())
+  {
+    std::vector<double> res (x.data(),x.data()+x.size());
+    res.insert(res.end(),y.data(),y.data()+y.size());
+    res.insert(res.end(),z.data(),z.data()+z.size());
+    return res;
+  }
+
+  Eigen::VectorXd outputs(const se3::codegen::Kernel & kernel)
+  {
+    Eigen::VectorXd res ((int)kernel.outputs.size());
+    for(std::size_t k=0;k<kernel.outputs.size();++k) res[(int)k] = kernel.tape.value(kernel.outputs[k]);
+    return res;
+  }
+}
+
+BOOST_AUTO_TEST_SUITE ( BOOST_TEST_MODULE )
+
+BOOST_AUTO_TEST_CASE ( test_trace_scalar )
+{
+  using namespace se3::codegen;
+
+  Tape tape;
+  tape.activate();
+  const TraceScalar x (tape.input("x[0]",2.)), y (tape.input("x[1]",3.));
+
+  // Constants are folded, and the neutral and absorbing elements simplified.
+  BOOST_CHECK((TraceScalar(2.) * TraceScalar(3.)).isConstant(6.));
+  BOOST_CHECK((x * TraceScalar(0.)).isConstant(0.));
+  BOOST_CHECK((x * TraceScalar(1.) + TraceScalar(0.)).id == x.id);
+  BOOST_CHECK((-(-x)).id == x.id);
+  BOOST_CHECK(tape.size() == 3);
+
+  // Identical operations are recorded once.
+  const TraceScalar xy (x*y), yx (y*x);
+  BOOST_CHECK(xy.id == yx.id);
+  BOOST_CHECK_EQUAL(xy.value, 6.);
+
+  const TraceScalar z (sin(xy) / (x + TraceScalar(1.)));
+  BOOST_CHECK_CLOSE(z.value, std::sin(6.)/3., 1e-12);
+  tape.deactivate();
+
+  std::vector<double> inputs (2); inputs[0] = -1.5; inputs[1] = 0.5;
+  tape.replay(inputs);
+  BOOST_CHECK_CLOSE(tape.value(z), std::sin(-0.75)/(-0.5), 1e-12);
+}
+
+BOOST_AUTO_TEST_CASE ( test_replay )
+{
+  using namespace Eigen;
+  using namespace se3;
+
+  se3::Model model;
+  buildModels::humanoidSimple(model,true);
+  model.addFrame("rh_tool",(JointIndex)(model.nbody-1),SE3::Random());
+  model.addFrame("ff_tool",1,SE3::Random());
+  se3::Data data(model);
+
+  const ModelTpl<codegen::TraceScalar> model_trace (ModelTpl<double>(model).cast<codegen::TraceScalar>());
+  codegen::Kernel fk, id, fd, jac;
+  codegen::traceForwardKinematics(model_trace,fk);
+  codegen::traceRnea(model_trace,id);
+  codegen::traceAba(model_trace,fd);
+  codegen::traceFrameJacobians(model_trace,jac);
+  BOOST_CHECK(codegen::Tape::active() == NULL);
+
+  // The traced kernels are evaluated for other inputs than the ones of the trace.
+  const VectorXd q = randomConfiguration(model);
+  const VectorXd v = VectorXd::Random(model.nv);
+  const VectorXd a = VectorXd::Random(model.nv);
+
+  fk.tape.replay(concatenate(q));
+  forwardKinematics(model,data,q);
+  const VectorXd oMi (outputs(fk));
+  BOOST_CHECK((int)oMi.size() == 12*model.nbody);
+  for(int i=0;i<model.nbody;++i)
+  {
+    BOOST_CHECK(Map<const Matrix3d>(oMi.data()+12*i).isApprox(data.oMi[(std::size_t)i].rotation(), 1e-12));
+    BOOST_CHECK(oMi.segment<3>(12*i+9).isApprox(data.oMi[(std::size_t)i].translation(), 1e-12));
+  }
+
+  id.tape.replay(concatenate(q,v,a));
+  rnea(model,data,q,v,a);
+  BOOST_CHECK(outputs(id).isApprox(data.tau, 1e-12));
+
+  fd.tape.replay(concatenate(q,v,data.tau));
+  BOOST_CHECK(outputs(fd).isApprox(a, 1e-10));
+
+  jac.tape.replay(concatenate(q));
+  computeJacobians(model,data,q);
+  framesForwardKinematics(model,data);
+  const VectorXd J (outputs(jac));
+  BOOST_CHECK((int)J.size() == 6*model.nv*model.nOperationalFrames);
+  for(int f=0;f<model.nOperationalFrames;++f)
+  {
+    Data::Matrix6x J_ref (Data::Matrix6x::Zero(6,model.nv));
+    getFrameJacobian<true>(model,data,(Model::FrameIndex)f,J_ref);
+    BOOST_CHECK(Map<const Data::Matrix6x>(J.data()+6*model.nv*f,6,model.nv).isApprox(J_ref, 1e-12));
+  }
+}
+
+BOOST_AUTO_TEST_CASE ( test_generated_code )
+{
+  using namespace se3;
+
+  se3::Model model;
+  buildModels::humanoidSimple(model,true);
+  std::ostringstream header, source;
+  generateCode(model,"humanoid",header,source);
+
+  BOOST_CHECK(header.str().find("void humanoid_rnea(const double * q, const double * v, const double * a, double * tau);") != std::string::npos);
+  BOOST_CHECK(header.str().find("#define HUMANOID_NV 32") != std::string::npos);
+  BOOST_CHECK(source.str().find("#include \"humanoid.h\"") != std::string::npos);
+  BOOST_CHECK(source.str().find("void humanoid_aba(const double * q, const double * v, const double * tau, double * ddq)\n{") != std::string::npos);
+
+  // Straight-line code only.
+  BOOST_CHECK(source.str().find("for(") == std::string::npos);
+  BOOST_CHECK(source.str().find("if(") == std::string::npos);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
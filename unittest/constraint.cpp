@@ -67,6 +67,18 @@ BOOST_AUTO_TEST_CASE ( test_ForceSet )
   ForceSet F36full(12); F36full.block(3,6) = amb.act(F3.block(3,6)); 
   BOOST_CHECK((aXb.transpose().inverse()*F3.matrix().block(0,3,6,6)).isApprox(F36full.matrix().block(0,3,6,6),
                                                             1e-12));
+
+  // Output-parameter versions, without allocation
+  ForceSet F5(12);
+  F3.se3Action(amb,F5);
+  BOOST_CHECK(F5.matrix().isApprox(F4.matrix(), 1e-12));
+  F5.se3ActionInverse(amb,bF);
+  BOOST_CHECK(bF.matrix().isApprox(F3.matrix(), 1e-12));
+  ForceSet F6(6);
+  F3.block(3,6).se3Action(amb,F6);
+  BOOST_CHECK(F6.matrix().isApprox(F36.matrix(), 1e-12));
+  F5.block(3,6).se3ActionInverse(amb,F6);
+  BOOST_CHECK(F6.matrix().isApprox(F3.matrix().block(0,3,6,6), 1e-12));
 }
 
 BOOST_AUTO_TEST_CASE ( test_ConstraintRX )
@@ -130,5 +130,25 @@ BOOST_AUTO_TEST_CASE (test_ccrb)
   BOOST_CHECK(data.Ag.isApprox(Ag_ref,1e-12));
 }
 
+BOOST_AUTO_TEST_CASE (test_crba_sparse)
+{
+  for(int usingFF=0;usingFF<2;++usingFF)
+  {
+    se3::Model model;
+    se3::buildModels::humanoidSimple(model,usingFF==1);
+    se3::Data data(model), data_ref(model);
+    
+    Eigen::VectorXd q = Eigen::VectorXd::Random(model.nq);
+    if(usingFF==1) q.segment <4> (3).normalize();
+    
+    crba(model,data_ref,q);
+    data_ref.M.triangularView<Eigen::StrictlyLower>() = data_ref.M.transpose().triangularView<Eigen::StrictlyLower>();
+    
+    const se3::BranchSparseMatrix & M = crbaSparse(model,data,q);
+    BOOST_CHECK(M.nonZeros() < model.nv*model.nv);
+    BOOST_CHECK(M.dense().isApprox(data_ref.M,1e-12));
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END ()
 
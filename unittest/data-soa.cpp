@@ -0,0 +1,97 @@
+//
+// Copyright (c) 2016 CNRS
+//
+// This file is part of Pinocchio
+// Pinocchio is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// Pinocchio is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Lesser Public License for more details. You should have
+// received a copy of the GNU Lesser General Public License along with
+// Pinocchio If not, see
+// <http://www.gnu.org/licenses/>.
+
+#include "pinocchio/multibody/model.hpp"
+#include "pinocchio/multibody/data-soa.hpp"
+#include "pinocchio/algorithm/kinematics.hpp"
+#include "pinocchio/algorithm/rnea.hpp"
+#include "pinocchio/multibody/parser/sample-models.hpp"
+
+#include <iostream>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE DataSoATest
+#include <boost/test/unit_test.hpp>
+#include <boost/utility/binary.hpp>
+
+BOOST_AUTO_TEST_SUITE ( DataSoATest )
+
+BOOST_AUTO_TEST_CASE ( test_accessors )
+{
+  using namespace se3;
+
+  se3::Model model; buildModels::humanoidSimple(model);
+  se3::DataSoA data(model);
+
+  BOOST_CHECK(data.oMi(0).isApprox(SE3::Identity()));
+  BOOST_CHECK(data.a_gf(0).toVector().isApprox((-model.gravity).toVector()));
+
+  for(Model::JointIndex i=1;i<(Model::JointIndex)model.nbody;++i)
+  {
+    const SE3 M = SE3::Random();
+    const Motion v = Motion::Random();
+    const Force f = Force::Random();
+
+    data.setOMi(i,M); data.setLiMi(i,M.inverse());
+    data.setV(i,v); data.setA_gf(i,-v);
+    data.setF(i,f);
+
+    BOOST_CHECK(data.oMi(i).isApprox(M));
+    BOOST_CHECK(data.liMi(i).isApprox(M.inverse()));
+    BOOST_CHECK(data.v(i).toVector().isApprox(v.toVector()));
+    BOOST_CHECK(data.a_gf(i).toVector().isApprox(-v.toVector()));
+    BOOST_CHECK(data.f(i).toVector().isApprox(f.toVector()));
+    BOOST_CHECK(data.v_angular.col((long)i).isApprox(v.angular()));
+  }
+}
+
+BOOST_AUTO_TEST_CASE ( test_fk_rnea_vs_data )
+{
+  using namespace Eigen;
+  using namespace se3;
+
+  for(int usingFF=0;usingFF<2;++usingFF)
+  {
+    se3::Model model; buildModels::humanoidSimple(model,usingFF==1);
+    se3::Data data(model);
+    se3::DataSoA data_soa(model);
+
+    VectorXd q (VectorXd::Random(model.nq));
+    VectorXd v (VectorXd::Random(model.nv));
+    VectorXd a (VectorXd::Random(model.nv));
+    if(usingFF==1) q.segment<4>(3).normalize();
+
+    forwardKinematics(model,data,q);
+    forwardKinematics(model,data_soa,q);
+    for(Model::JointIndex i=1;i<(Model::JointIndex)model.nbody;++i)
+    {
+      BOOST_CHECK(data_soa.oMi(i).isApprox(data.oMi[i], 1e-12));
+      BOOST_CHECK(data_soa.liMi(i).isApprox(data.liMi[i], 1e-12));
+    }
+
+    rnea(model,data,q,v,a);
+    rnea(model,data_soa,q,v,a);
+    BOOST_CHECK(data_soa.tau.isApprox(data.tau, 1e-12));
+    for(Model::JointIndex i=1;i<(Model::JointIndex)model.nbody;++i)
+    {
+      BOOST_CHECK(data_soa.v(i).toVector().isApprox(data.v[i].toVector(), 1e-12));
+      BOOST_CHECK(data_soa.f(i).toVector().isApprox(data.f[i].toVector(), 1e-12));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
@@ -19,6 +19,7 @@
 #include "pinocchio/multibody/model.hpp"
 #include "pinocchio/algorithm/jacobian.hpp"
 #include "pinocchio/algorithm/dynamics.hpp"
+#include "pinocchio/algorithm/joint-configuration.hpp"
 #include "pinocchio/multibody/parser/sample-models.hpp"
 #include "pinocchio/tools/timer.hpp"
 
@@ -154,6 +155,211 @@ BOOST_AUTO_TEST_CASE ( test_ID )
   BOOST_CHECK(dynamics_residual.norm() <= 1e-12);
 }
 
+BOOST_AUTO_TEST_CASE ( test_JMinvJt_sparse )
+{
+  using namespace Eigen;
+  using namespace se3;
+  
+  se3::Model model;
+  se3::buildModels::humanoidSimple(model,true);
+  se3::Data data(model);
+  
+  VectorXd q = VectorXd::Random(model.nq);
+  q.segment <4> (3).normalize();
+  
+  se3::computeJacobians(model, data, q);
+  
+  Data::Matrix6x J_RF (6, model.nv);
+  J_RF.setZero();
+  getJacobian <true> (model, data, model.getBodyId("rleg6_body"), J_RF);
+  Data::Matrix6x J_LA (6, model.nv);
+  J_LA.setZero();
+  getJacobian <true> (model, data, model.getBodyId("larm6_body"), J_LA);
+  
+  // Two contacts on single chains, a constraint coupling two chains and an empty one.
+  Eigen::MatrixXd J (14, model.nv);
+  J.topRows<6> () = J_RF;
+  J.middleRows<6> (6) = J_LA;
+  J.row(12) = J_RF.row(0) + J_LA.row(1);
+  J.row(13).setZero();
+  
+  crba(model, data, q);
+  cholesky::decompose(model, data);
+  data.M.triangularView<Eigen::StrictlyLower>() = data.M.transpose().triangularView<Eigen::StrictlyLower>();
+  const MatrixXd Minv (data.M.inverse());
+  
+  computeJMinvJt(model, data, J);
+  BOOST_CHECK(data.JMinvJt.isApprox(J * Minv * J.transpose(), 1e-12));
+  BOOST_CHECK(data.constraint_chainEnd[0] >= 0);
+  BOOST_CHECK(data.constraint_chainEnd[12] == -1);
+  BOOST_CHECK(data.constraint_chainEnd[13] == -1);
+  
+  // Same contacts, new values: the pattern is reused.
+  J.topRows<12> () *= 2.;
+  computeJMinvJt(model, data, J);
+  BOOST_CHECK(data.JMinvJt.isApprox(J * Minv * J.transpose(), 1e-12));
+  
+  // New set of contacts.
+  const Eigen::MatrixXd J_contacts (J.topRows<12> ());
+  computeJMinvJt(model, data, J_contacts);
+  BOOST_CHECK(data.JMinvJt.isApprox(J_contacts * Minv * J_contacts.transpose(), 1e-12));
+  BOOST_CHECK(data.constraint_chainCommon(0,6) == 5); // the free flyer supports both contacts
+}
+
+BOOST_AUTO_TEST_CASE ( test_FD_recursive )
+{
+  using namespace Eigen;
+  using namespace se3;
+  
+  se3::Model model;
+  se3::buildModels::humanoidSimple(model,true);
+  se3::Data data(model), data_ref(model);
+  
+  VectorXd q = VectorXd::Random(model.nq);
+  q.segment <4> (3).normalize();
+  VectorXd v = VectorXd::Random(model.nv);
+  VectorXd tau = VectorXd::Random(model.nv);
+  
+  std::vector<Model::JointIndex> contacts;
+  contacts.push_back(model.getBodyId("rleg6_body"));
+  contacts.push_back(model.getBodyId("lleg6_body"));
+  contacts.push_back(model.getBodyId("rarm6_body"));
+  
+  se3::computeJacobians(model, data_ref, q);
+  Eigen::MatrixXd J (6*contacts.size(), model.nv);
+  for(std::size_t c=0;c<contacts.size();++c)
+  {
+    Data::Matrix6x J_c (6, model.nv);
+    J_c.setZero();
+    getJacobian <true> (model, data_ref, contacts[c], J_c);
+    J.middleRows<6> (6*(int)c) = J_c;
+  }
+  Eigen::VectorXd gamma (VectorXd::Random(J.rows()));
+  
+  se3::forwardDynamics(model, data_ref, q, v, tau, J, gamma, true);
+  se3::forwardDynamicsRecursive(model, data, q, v, tau, contacts, gamma);
+  
+  BOOST_CHECK(data.JMinvJt.isApprox(data_ref.JMinvJt, 1e-12));
+  BOOST_CHECK(data.lambda_c.isApprox(data_ref.lambda_c, 1e-10));
+  BOOST_CHECK(data.ddq.isApprox(data_ref.ddq, 1e-10));
+}
+
+BOOST_AUTO_TEST_CASE ( test_FD_moving_contacts )
+{
+  using namespace Eigen;
+  using namespace se3;
+  
+  se3::Model model;
+  se3::buildModels::humanoidSimple(model,true);
+  se3::Data data(model);
+  
+  VectorXd q = VectorXd::Random(model.nq);
+  q.segment <4> (3).normalize();
+  const VectorXd v = VectorXd::Random(model.nv);
+  const VectorXd tau = VectorXd::Random(model.nv);
+  
+  // Along a trajectory, the active sets are kept, added, removed, reordered or partial.
+  // The constraint pattern cached in data must not change the results of a fresh data.
+  const char * bodies[] = { "rleg6_body", "lleg6_body", "rarm6_body", "larm6_body" };
+  int sets[6][4] = { {0,1,-1,-1}, {0,1,-1,-1}, {0,1,2,-1}, {1,2,-1,-1}, {3,2,1,0}, {3,0,-1,-1} };
+  for(int s=0;s<6;++s)
+  {
+    q = integrate(model,q,1e-2*v);
+    se3::Data data_ref(model);
+    
+    std::vector<Data::Matrix6x> J_c (4, Data::Matrix6x::Zero(6, model.nv));
+    se3::computeJacobians(model, data_ref, q);
+    for(std::size_t c=0;c<4;++c)
+      getJacobian <true> (model, data_ref, model.getBodyId(bodies[c]), J_c[c]);
+    
+    std::vector<int> rows;
+    for(int c=0;c<4 && sets[s][c]>=0;++c)
+      for(int k=0;k<6;++k)
+        if(s!=5 || c!=1 || k<3) rows.push_back(6*sets[s][c]+k);
+    
+    Eigen::MatrixXd J ((int)rows.size(), model.nv);
+    for(std::size_t r=0;r<rows.size();++r)
+      J.row((int)r) = J_c[(std::size_t)rows[r]/6].row(rows[r]%6);
+    Eigen::VectorXd gamma (VectorXd::Random(J.rows()));
+    
+    se3::forwardDynamics(model, data_ref, q, v, tau, J, gamma, true);
+    se3::forwardDynamics(model, data, q, v, tau, J, gamma, true);
+    
+    BOOST_CHECK(data.lambda_c.isApprox(data_ref.lambda_c, 1e-10));
+    BOOST_CHECK(data.ddq.isApprox(data_ref.ddq, 1e-10));
+    
+    Eigen::VectorXd constraint_residual (J * data.ddq + gamma);
+    BOOST_CHECK(constraint_residual.norm() <= 1e-10);
+  }
+}
+
+BOOST_AUTO_TEST_CASE ( test_FD_active_constraints )
+{
+  using namespace Eigen;
+  using namespace se3;
+  
+  se3::Model model;
+  se3::buildModels::humanoidSimple(model,true);
+  se3::Data data(model);
+  
+  VectorXd q = VectorXd::Random(model.nq);
+  q.segment <4> (3).normalize();
+  const VectorXd v = VectorXd::Random(model.nv);
+  const VectorXd tau = VectorXd::Random(model.nv);
+  
+  const char * bodies[] = { "rleg6_body", "lleg6_body", "rarm6_body" };
+  Eigen::MatrixXd J (18, model.nv);
+  J.setZero();
+  se3::computeJacobians(model, data, q);
+  for(int c=0;c<3;++c)
+  {
+    Data::Matrix6x J_c (Data::Matrix6x::Zero(6, model.nv));
+    getJacobian <true> (model, data, model.getBodyId(bodies[c]), J_c);
+    J.middleRows<6>(6*c) = J_c;
+  }
+  const VectorXd gamma (VectorXd::Random(18));
+  
+  se3::forwardDynamics(model, data, q, v, tau, J, gamma, true);
+  
+  // Within the step, the constraints are deactivated and activated again by rank updates of the factorization.
+  // Each active set must give the results of forwardDynamics with the active rows of J only.
+  bool sets[4][18];
+  for(int r=0;r<18;++r)
+  {
+    sets[0][r] = (r < 12);
+    sets[1][r] = (r >= 6 && r < 15);
+    sets[2][r] = (r % 2 == 0);
+    sets[3][r] = true;
+  }
+  for(int s=0;s<4;++s)
+  {
+    std::vector<int> rows;
+    for(int r=0;r<18;++r)
+    {
+      updateActiveConstraint(model, data, r, sets[s][r]);
+      if(sets[s][r]) rows.push_back(r);
+    }
+    se3::solveContactDynamics(model, data, J, gamma);
+    
+    Eigen::MatrixXd J_active ((int)rows.size(), model.nv);
+    Eigen::VectorXd gamma_active ((int)rows.size());
+    for(std::size_t r=0;r<rows.size();++r)
+    {
+      J_active.row((int)r) = J.row(rows[r]);
+      gamma_active[(int)r] = gamma[rows[r]];
+    }
+    se3::Data data_ref(model);
+    se3::forwardDynamics(model, data_ref, q, v, tau, J_active, gamma_active, true);
+    
+    BOOST_CHECK(data.ddq.isApprox(data_ref.ddq, 1e-10));
+    for(std::size_t r=0;r<rows.size();++r)
+      BOOST_CHECK_SMALL(data.lambda_c[rows[r]] - data_ref.lambda_c[(int)r], 1e-8);
+    
+    Eigen::MatrixXd L (data.llt_JMinvJt.matrixL());
+    BOOST_CHECK((L*L.transpose()).isApprox(data.JMinvJt, 1e-10));
+  }
+}
+
 BOOST_AUTO_TEST_CASE (timings_fd_llt)
 {
   using namespace Eigen;
@@ -209,4 +415,35 @@ BOOST_AUTO_TEST_CASE (timings_fd_llt)
   
 }
 
+BOOST_AUTO_TEST_CASE ( test_FD_sparse )
+{
+  using namespace Eigen;
+  using namespace se3;
+  
+  se3::Model model;
+  se3::buildModels::humanoidSimple(model,true);
+  se3::Data data(model), data_ref(model);
+  
+  VectorXd q = VectorXd::Random(model.nq);
+  q.segment <4> (3).normalize();
+  VectorXd v = VectorXd::Random(model.nv);
+  VectorXd tau = VectorXd::Random(model.nv);
+  
+  se3::computeJacobians(model, data_ref, q);
+  Eigen::MatrixXd J (12, model.nv);
+  J.setZero();
+  Data::Matrix6x J_foot (6, model.nv);
+  J_foot.setZero(); getJacobian <true> (model, data_ref, model.getBodyId("rleg6_body"), J_foot);
+  J.topRows<6> () = J_foot;
+  J_foot.setZero(); getJacobian <true> (model, data_ref, model.getBodyId("lleg6_body"), J_foot);
+  J.bottomRows<6> () = J_foot;
+  Eigen::VectorXd gamma (VectorXd::Random(12));
+  
+  se3::forwardDynamics(model, data_ref, q, v, tau, J, gamma, true);
+  se3::forwardDynamicsSparse(model, data, q, v, tau, J, gamma, true);
+  
+  BOOST_CHECK(data.ddq.isApprox(data_ref.ddq, 1e-12));
+  BOOST_CHECK(data.lambda_c.isApprox(data_ref.lambda_c, 1e-12));
+}
+
 BOOST_AUTO_TEST_SUITE_END ()
@@ -35,6 +35,9 @@
 #include "pinocchio/multibody/parser/sample-models.hpp"
 #include "pinocchio/algorithm/kinematics.hpp"
 #include "pinocchio/algorithm/collisions.hpp"
+#include "pinocchio/algorithm/continuous-collisions.hpp"
+#include "pinocchio/algorithm/never-colliding-pairs.hpp"
+#include "pinocchio/algorithm/parallel-collisions.hpp"
 #include "pinocchio/multibody/parser/urdf.hpp"
 #include "pinocchio/spatial/explog.hpp"
 
@@ -196,6 +199,518 @@ BOOST_AUTO_TEST_CASE ( simple_boxes )
   BOOST_CHECK(data_geom.computeCollision(0,1).fcl_collision_result.isCollision() == false);
 }
 
+BOOST_AUTO_TEST_CASE ( collision_results )
+{
+  se3::Model model;
+  se3::GeometryModel model_geom(model);
+  
+  using namespace se3;
+
+  model.addBody(model.getBodyId("universe"),JointModelPlanar(),SE3::Identity(),Inertia::Random(),
+                "planar1_joint", "planar1_body");
+  model.addBody(model.getBodyId("universe"),JointModelPlanar(),SE3::Identity(),Inertia::Random(),
+                "planar2_joint", "planar2_body");
+  
+  boost::shared_ptr<fcl::Box> Sample(new fcl::Box(1));
+  fcl::CollisionObject box(Sample, fcl::Transform3f());
+  model_geom.addCollisionObject(model.getJointId("planar1_joint"),box, SE3::Identity(),  "box1", "");
+  model_geom.addCollisionObject(model.getJointId("planar2_joint"),box, SE3::Identity(),  "box2", "");
+  model_geom.addCollisionObject(model.getJointId("planar2_joint"),box, SE3(Eigen::Matrix3d::Identity(),Eigen::Vector3d(0,3,0)),  "box3", "");
+
+  se3::Data data(model);
+  se3::GeometryData data_geom(data, model_geom);
+
+  // The results are sized to the collision pairs
+  BOOST_CHECK(data_geom.distance_results.empty());
+  BOOST_CHECK(data_geom.collision_results.empty());
+  data_geom.addAllCollisionPairs();
+  BOOST_CHECK(data_geom.distance_results.size() == 3);
+  BOOST_CHECK(data_geom.collision_results.size() == 3);
+  BOOST_CHECK(data_geom.collision_status.size() == 3);
+  data_geom.removeCollisionPair(0,2);
+  BOOST_CHECK(data_geom.collision_results.size() == 2);
+  BOOST_CHECK(data_geom.distance_results[1].object1 == 1 && data_geom.distance_results[1].object2 == 2);
+  BOOST_CHECK(data_geom.collision_results[1].object1 == 1 && data_geom.collision_results[1].object2 == 2);
+
+  Eigen::VectorXd q(model.nq);
+  q <<  0.99, 0, 0,
+        0, 0, 0 ;
+
+  BOOST_CHECK(se3::computeCollisions(model, data, model_geom, data_geom, q));
+  BOOST_CHECK(data_geom.collision_status[0] && !data_geom.collision_status[1]);
+  BOOST_CHECK(data_geom.collision_results[0].fcl_collision_result.isCollision());
+  BOOST_CHECK(!data_geom.collision_results[1].fcl_collision_result.isCollision());
+
+  se3::computeDistances(data_geom);
+  BOOST_CHECK(data_geom.distance_results[0] == data_geom.computeDistance(0,1));
+  BOOST_CHECK(data_geom.distance_results[1] == data_geom.computeDistance(1,2));
+
+  // Boolean only mode
+  data_geom.setBooleanOnlyCollisions(true);
+  BOOST_CHECK(data_geom.collision_results.empty());
+  q <<  1.01, 0, 0,
+        0, 0, 0 ;
+  BOOST_CHECK(!se3::computeCollisions(model, data, model_geom, data_geom, q));
+  BOOST_CHECK(!data_geom.collision_status[0] && !data_geom.collision_status[1]);
+  data_geom.addCollisionPair(0,2);
+  BOOST_CHECK(data_geom.collision_results.empty());
+  BOOST_CHECK(data_geom.collision_status.size() == 3);
+
+  data_geom.setBooleanOnlyCollisions(false);
+  BOOST_CHECK(data_geom.collision_results.size() == 3);
+  BOOST_CHECK(data_geom.collision_results[2].object1 == 0 && data_geom.collision_results[2].object2 == 2);
+}
+
+BOOST_AUTO_TEST_CASE ( broad_phase )
+{
+  using namespace se3;
+
+  se3::Model model;
+  buildModels::humanoidSimple(model);
+  se3::GeometryModel model_geom(model);
+
+  // Two boxes and a sphere on each joint
+  boost::shared_ptr<fcl::Box> box(new fcl::Box(0.2,0.1,0.3));
+  boost::shared_ptr<fcl::Sphere> sphere(new fcl::Sphere(0.15));
+  for (Model::JointIndex i = 1; i < (Model::JointIndex)model.nbody; ++i)
+  {
+    model_geom.addCollisionObject(i, fcl::CollisionObject(box), SE3::Random(), "", "");
+    model_geom.addCollisionObject(i, fcl::CollisionObject(box), SE3::Random(), "", "");
+    model_geom.addCollisionObject(i, fcl::CollisionObject(sphere), SE3::Random(), "", "");
+  }
+
+  se3::Data data(model);
+  se3::GeometryData data_geom(data, model_geom);
+  se3::GeometryData data_geom_ref(data, model_geom);
+  data_geom.addAllCollisionPairs();
+  data_geom_ref.addAllCollisionPairs();
+  data_geom.removeCollisionPair(0,1);
+  data_geom_ref.removeCollisionPair(0,1);
+  BOOST_CHECK(data_geom.broad_phase_enabled);
+  data_geom_ref.setBroadPhase(false);
+
+  for (int k = 0; k < 20; ++k)
+  {
+    Eigen::VectorXd q = Eigen::VectorXd::Random(model.nq);
+    q.segment<4>(3).normalize();
+    
+    se3::updateGeometryPlacements(model, data, model_geom, data_geom_ref, q);
+    se3::updateGeometryPlacements(model, data, model_geom, data_geom, q);
+    const bool colliding_ref = computeCollisions(data_geom_ref);
+    BOOST_CHECK(computeCollisions(data_geom) == colliding_ref);
+    BOOST_CHECK(data_geom.collision_status == data_geom_ref.collision_status);
+    BOOST_CHECK(data_geom.collision_results == data_geom_ref.collision_results);
+    BOOST_CHECK(data_geom.broad_phase_candidates.size() < data_geom.collision_pairs.size());
+
+    // The selected pairs are those whose bounding boxes overlap
+    for (std::size_t cpt = 0; cpt < data_geom.collision_pairs.size(); ++cpt)
+    {
+      const long co1 = (long)data_geom.collision_pairs[cpt].first;
+      const long co2 = (long)data_geom.collision_pairs[cpt].second;
+      const bool overlap = (data_geom.oAABB_min.col(co1).array() <= data_geom.oAABB_max.col(co2).array()).all()
+                        && (data_geom.oAABB_min.col(co2).array() <= data_geom.oAABB_max.col(co1).array()).all();
+      const bool selected = std::binary_search(data_geom.broad_phase_candidates.begin(),
+                                               data_geom.broad_phase_candidates.end(), cpt);
+      BOOST_CHECK(overlap == selected);
+    }
+
+    // The first collision is the same
+    BOOST_CHECK(computeCollisions(data_geom, true) == computeCollisions(data_geom_ref, true));
+  }
+}
+
+BOOST_AUTO_TEST_CASE ( parallel_narrow_phase )
+{
+  using namespace se3;
+
+  se3::Model model;
+  buildModels::humanoidSimple(model);
+  se3::GeometryModel model_geom(model);
+
+  boost::shared_ptr<fcl::Box> box(new fcl::Box(0.2,0.1,0.3));
+  boost::shared_ptr<fcl::Sphere> sphere(new fcl::Sphere(0.15));
+  for (Model::JointIndex i = 1; i < (Model::JointIndex)model.nbody; ++i)
+  {
+    model_geom.addCollisionObject(i, fcl::CollisionObject(box), SE3::Random(), "", "");
+    model_geom.addCollisionObject(i, fcl::CollisionObject(sphere), SE3::Random(), "", "");
+  }
+
+  se3::Data data(model);
+  se3::GeometryData data_geom(data, model_geom);
+  se3::GeometryData data_geom_ref(data, model_geom);
+  data_geom.addAllCollisionPairs();
+  data_geom_ref.addAllCollisionPairs();
+
+  se3::parallel::NarrowPhasePool pool(4);
+
+  for (int k = 0; k < 40; ++k)
+  {
+    const bool broad_phase = (k%2 == 0);
+    const bool boolean_only = (k%4 >= 2);
+    data_geom.setBroadPhase(broad_phase); data_geom_ref.setBroadPhase(broad_phase);
+    data_geom.setBooleanOnlyCollisions(boolean_only); data_geom_ref.setBooleanOnlyCollisions(boolean_only);
+
+    Eigen::VectorXd q = Eigen::VectorXd::Random(model.nq);
+    q.segment<4>(3).normalize();
+    se3::updateGeometryPlacements(model, data, model_geom, data_geom_ref, q);
+
+    BOOST_CHECK(se3::parallel::computeCollisions(pool, model, data, model_geom, data_geom, q)
+                == se3::computeCollisions(data_geom_ref));
+    BOOST_CHECK(data_geom.collision_status == data_geom_ref.collision_status);
+    BOOST_CHECK(data_geom.collision_results == data_geom_ref.collision_results);
+
+    // With broad phase, the sequential algorithm also resets the pairs after the first collision
+    if (broad_phase)
+    {
+      BOOST_CHECK(se3::parallel::computeCollisions(pool, data_geom, true) == se3::computeCollisions(data_geom_ref, true));
+      BOOST_CHECK(data_geom.collision_status == data_geom_ref.collision_status);
+      BOOST_CHECK(data_geom.collision_results == data_geom_ref.collision_results);
+    }
+
+    se3::parallel::computeDistances(pool, data_geom);
+    se3::computeDistances(data_geom_ref);
+    BOOST_CHECK(data_geom.distance_results == data_geom_ref.distance_results);
+  }
+}
+
+BOOST_AUTO_TEST_CASE ( continuous_collisions )
+{
+  using namespace se3;
+
+  se3::Model model;
+  model.addBody(model.getBodyId("universe"),JointModelPlanar(),SE3::Identity(),Inertia::Random(),
+                "planar1_joint", "planar1_body");
+  se3::GeometryModel model_geom(model);
+
+  boost::shared_ptr<fcl::Box> box(new fcl::Box(1));
+  boost::shared_ptr<fcl::Box> thin_box(new fcl::Box(0.01,1,1));
+  model_geom.addCollisionObject(model.getJointId("planar1_joint"), fcl::CollisionObject(box), SE3::Identity(), "moving_box", "");
+  model_geom.addCollisionObject(0, fcl::CollisionObject(thin_box), SE3::Identity(), "thin_obstacle", "");
+
+  se3::Data data(model);
+  se3::GeometryData data_geom(data, model_geom);
+  data_geom.addAllCollisionPairs();
+
+  Eigen::VectorXd q0(model.nq), q1(model.nq);
+  q0 << -3, 0, 0;
+  q1 <<  3, 0, 0;
+
+  // The motion bound is the speed of the box
+  Eigen::VectorXd motion_bounds;
+  computeMotionBounds(model, data, model_geom, data_geom, q0, q1, motion_bounds);
+  BOOST_CHECK(motion_bounds.size() == 1);
+  BOOST_CHECK_CLOSE(motion_bounds[0], 6., 1e-8);
+
+  // The thin obstacle is hit when the box has moved by 3 - 0.505
+  double time_of_contact;
+  GeometryData::Index pair_index;
+  BOOST_CHECK(computeContinuousCollisions(model, data, model_geom, data_geom, q0, q1, time_of_contact, pair_index));
+  BOOST_CHECK(std::fabs(time_of_contact - (3.-0.505)/6.) < 1e-4);
+  BOOST_CHECK(pair_index == 0);
+
+  // A discretization of the motion in 5 steps misses it
+  bool discrete_collision = false;
+  for (int k = 0; k <= 5; ++k)
+    discrete_collision |= computeCollisions(model, data, model_geom, data_geom, interpolate(model, q0, q1, k/5.));
+  BOOST_CHECK(!discrete_collision);
+
+  // Free motion
+  q0 << -3, 2, 0;
+  q1 <<  3, 2, 1;
+  BOOST_CHECK(!computeContinuousCollisions(model, data, model_geom, data_geom, q0, q1, time_of_contact));
+  BOOST_CHECK(time_of_contact == 1.);
+}
+
+BOOST_AUTO_TEST_CASE ( continuous_collisions_humanoid )
+{
+  using namespace se3;
+
+  se3::Model model;
+  buildModels::humanoidSimple(model);
+  se3::GeometryModel model_geom(model);
+
+  boost::shared_ptr<fcl::Sphere> sphere(new fcl::Sphere(0.1));
+  for (Model::JointIndex i = 1; i < (Model::JointIndex)model.nbody; ++i)
+    model_geom.addCollisionObject(i, fcl::CollisionObject(sphere), SE3::Random(), "", "");
+
+  se3::Data data(model);
+  se3::GeometryData data_geom(data, model_geom);
+  data_geom.addAllCollisionPairs();
+
+  for (int k = 0; k < 10; ++k)
+  {
+    Eigen::VectorXd q0 = Eigen::VectorXd::Random(model.nq);
+    q0.segment<4>(3).normalize();
+    Eigen::VectorXd q1 = Eigen::VectorXd::Random(model.nq);
+    q1.segment<4>(3).normalize();
+
+    double time_of_contact;
+    const bool collision = computeContinuousCollisions(model, data, model_geom, data_geom, q0, q1, time_of_contact);
+
+    // No collision is found by a dense discretization before the time of contact
+    const int nsteps = 1000;
+    for (int s = 0; s <= nsteps; ++s)
+    {
+      const double t = s / (double)nsteps;
+      if (collision && t >= time_of_contact) break;
+      BOOST_CHECK(!computeCollisions(model, data, model_geom, data_geom, interpolate(model, q0, q1, t)));
+    }
+
+    // The contact is real
+    if (collision)
+    {
+      updateGeometryPlacements(model, data, model_geom, data_geom, interpolate(model, q0, q1, time_of_contact));
+      computeDistances(data_geom);
+      double min_distance = std::numeric_limits<double>::infinity();
+      for (std::size_t p = 0; p < data_geom.distance_results.size(); ++p)
+        min_distance = std::min(min_distance, data_geom.distance_results[p].distance());
+      BOOST_CHECK(min_distance <= 1e-4);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE ( distance_cache )
+{
+  using namespace se3;
+
+  se3::Model model;
+  buildModels::humanoidSimple(model);
+  se3::GeometryModel model_geom(model);
+
+  boost::shared_ptr<fcl::Sphere> small_sphere(new fcl::Sphere(0.05));
+  boost::shared_ptr<fcl::Sphere> large_sphere(new fcl::Sphere(0.2));
+  for (Model::JointIndex i = 1; i < (Model::JointIndex)model.nbody; ++i)
+  {
+    model_geom.addCollisionObject(i, fcl::CollisionObject(small_sphere), SE3::Random(), "", "");
+    model_geom.addCollisionObject(i, fcl::CollisionObject(large_sphere), SE3::Random(), "", "");
+  }
+
+  se3::Data data(model);
+  se3::GeometryData data_geom(data, model_geom);
+  se3::GeometryData data_geom_ref(data, model_geom);
+  data_geom.addAllCollisionPairs();
+  data_geom_ref.addAllCollisionPairs();
+
+  const double threshold = 0.5;
+  Eigen::VectorXd q = Eigen::VectorXd::Random(model.nq);
+  q.segment<4>(3).normalize();
+
+  std::size_t nskipped = 0;
+  for (int k = 0; k < 50; ++k)
+  {
+    q = integrate(model, q, 0.05 * Eigen::VectorXd::Random(model.nv));
+
+    computeDistances(model, data, model_geom, data_geom, q, threshold);
+    computeDistances(model, data, model_geom, data_geom_ref, q);
+
+    for (std::size_t p = 0; p < data_geom.distance_results.size(); ++p)
+    {
+      const double distance = data_geom_ref.distance_results[p].distance();
+      BOOST_CHECK(data_geom.distance_lower_bounds[(long)p] <= distance + 1e-12);
+      if (distance <= threshold)
+        BOOST_CHECK_CLOSE(data_geom.distance_results[p].distance(), distance, 1e-12);
+      if (data_geom.distance_lower_bounds[(long)p] != data_geom.distance_results[p].distance())
+        ++nskipped;
+    }
+  }
+  BOOST_CHECK(nskipped > 0);
+
+  // Modifying the collision pairs invalidates the cache
+  data_geom.removeCollisionPair(data_geom.collision_pairs.back());
+  BOOST_CHECK(data_geom.distance_cache_dirty);
+  computeDistances(model, data, model_geom, data_geom, q, threshold);
+  for (std::size_t p = 0; p < data_geom.distance_results.size(); ++p)
+    BOOST_CHECK_CLOSE(data_geom.distance_results[p].distance(), data_geom_ref.distance_results[p].distance(), 1e-12);
+  data_geom_ref.removeCollisionPair(data_geom_ref.collision_pairs.back());
+
+  // The bounds do not depend on the distance results, which may be cleared (resetDistances, which also resets the cache)
+  // or overwritten by other queries between two calls
+  for (int k = 0; k < 10; ++k)
+  {
+    q = integrate(model, q, 0.05 * Eigen::VectorXd::Random(model.nv));
+
+    if (k % 2 == 0)
+    {
+      data_geom.resetDistances();
+      BOOST_CHECK(data_geom.distance_cache_dirty);
+    }
+    else
+    {
+      for (std::size_t p = 0; p < data_geom.distance_results.size(); ++p)
+        data_geom.distance_results[p].fcl_distance_result.clear();
+    }
+    computeDistances(model, data, model_geom, data_geom, q, threshold);
+    computeDistances(model, data, model_geom, data_geom_ref, q);
+
+    for (std::size_t p = 0; p < data_geom.distance_results.size(); ++p)
+    {
+      const double distance = data_geom_ref.distance_results[p].distance();
+      BOOST_CHECK(data_geom.distance_lower_bounds[(long)p] <= distance + 1e-12);
+      if (distance <= threshold)
+        BOOST_CHECK_CLOSE(data_geom.distance_results[p].distance(), distance, 1e-12);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE ( admissible_collision_pairs )
+{
+  using namespace se3;
+
+  se3::Model model;
+  buildModels::humanoidSimple(model);
+  se3::GeometryModel model_geom(model);
+
+  boost::shared_ptr<fcl::Sphere> sphere(new fcl::Sphere(0.1));
+  for (Model::JointIndex i = 0; i < (Model::JointIndex)model.nbody; ++i)
+  {
+    model_geom.addCollisionObject(i, fcl::CollisionObject(sphere), SE3::Random(), "", "");
+    model_geom.addCollisionObject(i, fcl::CollisionObject(sphere), SE3::Random(), "", "");
+  }
+
+  se3::Data data(model);
+  se3::GeometryData data_geom(data, model_geom);
+  data_geom.addAdmissibleCollisionPairs();
+
+  std::size_t nadmissible = 0;
+  for (GeometryData::Index i = 0; i < model_geom.ncollisions; ++i)
+    for (GeometryData::Index j = i+1; j < model_geom.ncollisions; ++j)
+    {
+      const Model::JointIndex joint1 = model_geom.collision_objects[i].parent;
+      const Model::JointIndex joint2 = model_geom.collision_objects[j].parent;
+      const bool adjacent = (joint1 == joint2) || (joint1 > 0 && model.parents[joint2] == joint1);
+      BOOST_CHECK(data_geom.existCollisionPair(CollisionPair(i,j)) == !adjacent);
+      if (!adjacent) ++nadmissible;
+    }
+  BOOST_CHECK(data_geom.nCollisionPairs == nadmissible);
+  BOOST_CHECK(nadmissible < model_geom.ncollisions * (model_geom.ncollisions-1) / 2);
+
+  // Put the objects of the first joint in a group ignored by the other objects
+  model_geom.collision_objects[2].collision_group = 2u;
+  model_geom.collision_objects[3].collision_group = 2u;
+  for (GeometryData::Index i = 0; i < model_geom.ncollisions; ++i)
+    if (i != 2 && i != 3)
+      model_geom.collision_objects[i].collision_mask = ~2u;
+  data_geom.addAdmissibleCollisionPairs();
+  for (std::size_t k = 0; k < data_geom.nCollisionPairs; ++k)
+  {
+    BOOST_CHECK(data_geom.collision_pairs[k].first != 2 && data_geom.collision_pairs[k].first != 3);
+    BOOST_CHECK(data_geom.collision_pairs[k].second != 2 && data_geom.collision_pairs[k].second != 3);
+  }
+}
+
+BOOST_AUTO_TEST_CASE ( never_colliding_pairs )
+{
+  using namespace se3;
+
+  se3::Model model;
+  buildModels::humanoidSimple(model);
+  se3::GeometryModel model_geom(model);
+
+  boost::shared_ptr<fcl::Sphere> sphere(new fcl::Sphere(0.3));
+  for (Model::JointIndex i = 1; i < (Model::JointIndex)model.nbody; ++i)
+    model_geom.addCollisionObject(i, fcl::CollisionObject(sphere), SE3::Random(), "", "");
+
+  se3::Data data(model);
+  se3::GeometryData data_geom(data, model_geom);
+  data_geom.addAdmissibleCollisionPairs();
+
+  const Eigen::VectorXd upper = Eigen::VectorXd::Ones(model.nq);
+  const Eigen::VectorXd lower = -upper;
+  const std::size_t nsamples = 100;
+  srdf::BodyPairsVector never_colliding_pairs;
+  srand(0);
+  computeNeverCollidingBodyPairs(model, data, model_geom, data_geom, nsamples, lower, upper, never_colliding_pairs);
+  BOOST_CHECK(!never_colliding_pairs.empty());
+
+  // Replay the same samples: a body pair is reported iff none of its collision pairs collided
+  std::vector<bool> colliding(data_geom.nCollisionPairs, false);
+  Eigen::VectorXd q(model.nq);
+  srand(0);
+  for (std::size_t s = 0; s < nsamples; ++s)
+  {
+    randomConfiguration(model, lower, upper, q);
+    computeCollisions(model, data, model_geom, data_geom, q);
+    for (std::size_t k = 0; k < data_geom.nCollisionPairs; ++k)
+      colliding[k] = colliding[k] || data_geom.collision_status[k];
+  }
+  for (std::size_t k = 0; k < data_geom.nCollisionPairs; ++k)
+  {
+    const srdf::BodyPair body_pair(model_geom.collision_objects[data_geom.collision_pairs[k].first].parent,
+                                   model_geom.collision_objects[data_geom.collision_pairs[k].second].parent);
+    const bool reported = std::find(never_colliding_pairs.begin(), never_colliding_pairs.end(), body_pair)
+                          != never_colliding_pairs.end();
+    BOOST_CHECK(reported == !colliding[k]);
+  }
+
+  // The SRDF file removes these pairs from the runtime list
+  const std::string filename = "never-colliding-pairs.srdf";
+  srdf::writeDisabledCollisionsToSrdf(model, "humanoid", never_colliding_pairs, filename);
+  data_geom.addCollisionPairsFromSrdf(filename, false);
+  BOOST_CHECK(data_geom.nCollisionPairs == model_geom.ncollisions * (model_geom.ncollisions-1) / 2
+                                           - never_colliding_pairs.size());
+}
+
+BOOST_AUTO_TEST_CASE ( collision_proxies )
+{
+  using namespace se3;
+
+  // The bounding capsule encloses all the vertices
+  std::vector<fcl::Vec3f> vertices;
+  const SE3 cloud_placement (SE3::Random());
+  for (int i = 0; i < 200; ++i)
+  {
+    const Eigen::Vector3d p (cloud_placement.act(Eigen::Vector3d(Eigen::Vector3d::Random().cwiseProduct(Eigen::Vector3d(0.1,0.2,1.)))));
+    vertices.push_back(toFclVec3f(p));
+  }
+  SE3 capsule_placement;
+  boost::shared_ptr<fcl::Capsule> capsule = computeBoundingCapsule(vertices, capsule_placement);
+  for (std::size_t i = 0; i < vertices.size(); ++i)
+  {
+    const Eigen::Vector3d p (capsule_placement.actInv(toVector3d(vertices[i])));
+    const double z = std::max(-0.5 * capsule->lz, std::min(0.5 * capsule->lz, p[2]));
+    BOOST_CHECK((p - Eigen::Vector3d(0.,0.,z)).norm() <= capsule->radius + 1e-9);
+  }
+  BOOST_CHECK(capsule->lz > 0.5);
+  BOOST_CHECK(capsule->radius < 0.5);
+
+  // The proxies do not change the results of the collision tests
+  se3::Model model;
+  buildModels::humanoidSimple(model);
+  se3::GeometryModel model_geom(model);
+
+  boost::shared_ptr<fcl::Box> box(new fcl::Box(0.1, 0.2, 0.6));
+  std::vector<fcl::Vec3f> corners;
+  for (int i = 0; i < 8; ++i)
+    corners.push_back(fcl::Vec3f((i & 1) ? 0.05 : -0.05, (i & 2) ? 0.1 : -0.1, (i & 4) ? 0.3 : -0.3));
+  SE3 box_proxy_placement;
+  boost::shared_ptr<fcl::CollisionGeometry> box_proxy = computeBoundingCapsule(corners, box_proxy_placement);
+  for (Model::JointIndex i = 1; i < (Model::JointIndex)model.nbody; ++i)
+  {
+    const GeometryModel::GeomIndex idx = model_geom.addCollisionObject(i, fcl::CollisionObject(box), SE3::Random(), "", "");
+    model_geom.collision_objects[idx].proxy_geometry = box_proxy;
+    model_geom.collision_objects[idx].proxy_placement = box_proxy_placement;
+  }
+
+  se3::Data data(model);
+  se3::GeometryData data_geom(data, model_geom);
+  data_geom.addAllCollisionPairs();
+  data_geom.setBroadPhase(false);
+
+  for (int k = 0; k < 20; ++k)
+  {
+    Eigen::VectorXd q = Eigen::VectorXd::Random(model.nq);
+    q.segment<4>(3).normalize();
+
+    data_geom.setCollisionProxies(true);
+    const bool collision = computeCollisions(model, data, model_geom, data_geom, q);
+    const std::vector<bool> collision_status (data_geom.collision_status);
+
+    data_geom.setCollisionProxies(false);
+    BOOST_CHECK(computeCollisions(model, data, model_geom, data_geom, q) == collision);
+    BOOST_CHECK(data_geom.collision_status == collision_status);
+  }
+}
+
 BOOST_AUTO_TEST_CASE ( loading_model )
 {
   typedef se3::Model Model;
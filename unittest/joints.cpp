@@ -835,3 +835,54 @@ BOOST_AUTO_TEST_CASE (vsFreeFlyer)
 
 }
 BOOST_AUTO_TEST_SUITE_END ()
+
+struct CheckDispatchVisitor
+{
+  CheckDispatchVisitor(const se3::JointModelVariant & jmodel, bool & ok) : jmodel(jmodel), ok(ok) {}
+
+  template<typename D>
+  void operator() (const se3::JointModelBase<D> & jmodel_dispatched) const
+  {
+    ok = (boost::get<D>(&jmodel) == &jmodel_dispatched.derived());
+  }
+
+  const se3::JointModelVariant & jmodel;
+  bool & ok;
+};
+
+template<typename JointModel>
+void checkDispatch(const JointModel & jmodel, const se3::JointTypeTag tag)
+{
+  using namespace se3;
+
+  const JointModelVariant jmodel_variant(jmodel);
+  BOOST_CHECK(jmodel_variant.which() == tag);
+
+  bool ok = false;
+  fusion::dispatch(CheckDispatchVisitor(jmodel_variant,ok),jmodel_variant);
+  BOOST_CHECK(ok);
+}
+
+BOOST_AUTO_TEST_SUITE ( JointDispatch )
+
+BOOST_AUTO_TEST_CASE ( test_all_joint_types )
+{
+  using namespace se3;
+
+  checkDispatch(JointModelRX(),JOINT_RX);
+  checkDispatch(JointModelRY(),JOINT_RY);
+  checkDispatch(JointModelRZ(),JOINT_RZ);
+  checkDispatch(JointModelRevoluteUnaligned(Eigen::Vector3d::UnitX()),JOINT_REVOLUTE_UNALIGNED);
+  checkDispatch(JointModelSpherical(),JOINT_SPHERICAL);
+  checkDispatch(JointModelSphericalZYX(),JOINT_SPHERICAL_ZYX);
+  checkDispatch(JointModelPX(),JOINT_PX);
+  checkDispatch(JointModelPY(),JOINT_PY);
+  checkDispatch(JointModelPZ(),JOINT_PZ);
+  checkDispatch(JointModelPrismaticUnaligned(Eigen::Vector3d::UnitX()),JOINT_PRISMATIC_UNALIGNED);
+  checkDispatch(JointModelFreeFlyer(),JOINT_FREE_FLYER);
+  checkDispatch(JointModelPlanar(),JOINT_PLANAR);
+  checkDispatch(JointModelTranslation(),JOINT_TRANSLATION);
+  checkDispatch(JointModelDense<-1,-1>(),JOINT_DENSE);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
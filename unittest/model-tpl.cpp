@@ -0,0 +1,252 @@
+//
+// Copyright (c) 2016 CNRS
+//
+// This file is part of Pinocchio
+// Pinocchio is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// Pinocchio is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Lesser Public License for more details. You should have
+// received a copy of the GNU Lesser General Public License along with
+// Pinocchio If not, see
+// <http://www.gnu.org/licenses/>.
+
+#include "pinocchio/multibody/model.hpp"
+#include "pinocchio/multibody/model-tpl.hpp"
+#include "pinocchio/algorithm/kinematics.hpp"
+#include "pinocchio/algorithm/rnea.hpp"
+#include "pinocchio/algorithm/aba.hpp"
+#include "pinocchio/algorithm/crba.hpp"
+#include "pinocchio/algorithm/center-of-mass.hpp"
+#include "pinocchio/algorithm/energy.hpp"
+#include "pinocchio/algorithm/operational-frames.hpp"
+#include "pinocchio/algorithm/rnea-derivatives.hpp"
+#include "pinocchio/multibody/parser/sample-models.hpp"
+
+#include <iostream>
+#include <unsupported/Eigen/AutoDiff>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE ModelTplTest
+#include <boost/test/unit_test.hpp>
+#include <boost/utility/binary.hpp>
+
+namespace
+{
+  /// Model with one joint of each type supported by se3::ModelTpl.
+  void buildAllJointsModel(se3::Model & model)
+  {
+    using namespace se3;
+    JointIndex i = 0;
+    i = model.addBody(i,JointModelFreeFlyer(),SE3::Random(),Inertia::Random(),"ff_joint","ff_body");
+    i = model.addBody(i,JointModelRX(),SE3::Random(),Inertia::Random(),"rx_joint","rx_body");
+    i = model.addBody(i,JointModelRevoluteUnaligned(0.6,-0.8,0.),SE3::Random(),Inertia::Random(),"ru_joint","ru_body");
+    const JointIndex branch = i;
+    i = model.addBody(i,JointModelSpherical(),SE3::Random(),Inertia::Random(),"sph_joint","sph_body");
+    i = model.addBody(i,JointModelPY(),SE3::Random(),Inertia::Random(),"py_joint","py_body");
+    i = model.addBody(branch,JointModelPrismaticUnaligned(0.,0.6,0.8),SE3::Random(),Inertia::Random(),"pu_joint","pu_body");
+    i = model.addBody(i,JointModelPlanar(),SE3::Random(),Inertia::Random(),"planar_joint","planar_body");
+    i = model.addBody(i,JointModelTranslation(),SE3::Random(),Inertia::Random(),"trans_joint","trans_body");
+    i = model.addBody(i,JointModelRZ(),SE3::Random(),Inertia::Random(),"rz_joint","rz_body");
+  }
+
+  Eigen::VectorXd randomConfiguration(const se3::Model & model)
+  {
+    Eigen::VectorXd q (Eigen::VectorXd::Random(model.nq));
+    for(se3::JointIndex i=1;i<(se3::JointIndex)model.nbody;++i)
+    {
+      const int idx_q = se3::idx_q(model.joints[i]);
+      if(model.joints[i].which() == se3::JOINT_FREE_FLYER) q.segment<4>(idx_q+3).normalize();
+      if(model.joints[i].which() == se3::JOINT_SPHERICAL) q.segment<4>(idx_q).normalize();
+    }
+    return q;
+  }
+}
+
+BOOST_AUTO_TEST_SUITE ( BOOST_TEST_MODULE )
+
+BOOST_AUTO_TEST_CASE ( test_all_joints_double )
+{
+  using namespace Eigen;
+  using namespace se3;
+
+  se3::Model model;
+  buildAllJointsModel(model);
+  se3::Data data(model);
+
+  const ModelTpl<double> model_tpl (model);
+  DataTpl<double> data_tpl (model_tpl);
+
+  VectorXd q = randomConfiguration(model);
+  VectorXd v = VectorXd::Random(model.nv);
+  VectorXd a = VectorXd::Random(model.nv);
+
+  forwardKinematics(model,data,q,v);
+  forwardKinematics(model_tpl,data_tpl,q,v);
+  for(JointIndex i=1;i<(JointIndex)model.nbody;++i)
+  {
+    BOOST_CHECK(data_tpl.oMi[i].isApprox(data.oMi[i], 1e-12));
+    BOOST_CHECK(data_tpl.v[i].toVector().isApprox(data.v[i].toVector(), 1e-12));
+  }
+
+  rnea(model,data,q,v,a);
+  rnea(model_tpl,data_tpl,q,v,a);
+  BOOST_CHECK(data_tpl.tau.isApprox(data.tau, 1e-12));
+
+  aba(model,data,q,v,a);
+  aba(model_tpl,data_tpl,q,v,a);
+  BOOST_CHECK(data_tpl.ddq.isApprox(data.ddq, 1e-10));
+
+  crba(model,data,q);
+  crba(model_tpl,data_tpl,q);
+  BOOST_CHECK(data_tpl.M.triangularView<Eigen::Upper>().toDenseMatrix()
+              .isApprox(data.M.triangularView<Eigen::Upper>().toDenseMatrix(), 1e-12));
+}
+
+BOOST_AUTO_TEST_CASE ( test_float )
+{
+  using namespace Eigen;
+  using namespace se3;
+
+  se3::Model model;
+  buildModels::humanoidSimple(model,true);
+  se3::Data data(model);
+
+  const ModelTpl<float> model_f (model);
+  DataTpl<float> data_f (model_f);
+
+  VectorXd q = randomConfiguration(model);
+  VectorXd v = VectorXd::Random(model.nv);
+  VectorXd a = VectorXd::Random(model.nv);
+  const VectorXf q_f (q.cast<float>()), v_f (v.cast<float>()), a_f (a.cast<float>());
+
+  forwardKinematics(model,data,q);
+  forwardKinematics(model_f,data_f,q_f);
+  for(JointIndex i=1;i<(JointIndex)model.nbody;++i)
+  {
+    BOOST_CHECK(data_f.oMi[i].rotation().cast<double>().isApprox(data.oMi[i].rotation(), 1e-5));
+    BOOST_CHECK(data_f.oMi[i].translation().cast<double>().isApprox(data.oMi[i].translation(), 1e-5));
+  }
+
+  rnea(model,data,q,v,a);
+  rnea(model_f,data_f,q_f,v_f,a_f);
+  BOOST_CHECK(data_f.tau.cast<double>().isApprox(data.tau, 1e-4));
+
+  aba(model,data,q,v,a);
+  aba(model_f,data_f,q_f,v_f,a_f);
+  BOOST_CHECK(data_f.ddq.cast<double>().isApprox(data.ddq, 1e-3));
+
+  crba(model,data,q);
+  crba(model_f,data_f,q_f);
+  BOOST_CHECK(data_f.M.cast<double>().triangularView<Eigen::Upper>().toDenseMatrix()
+              .isApprox(data.M.triangularView<Eigen::Upper>().toDenseMatrix(), 1e-4));
+
+  // Casting a ModelTpl is the same as converting the model directly
+  const ModelTpl<float> model_cast (ModelTpl<double>(model).cast<float>());
+  DataTpl<float> data_cast (model_cast);
+  rnea(model_cast,data_cast,q_f,v_f,a_f);
+  BOOST_CHECK(data_cast.tau.isApprox(data_f.tau));
+}
+
+BOOST_AUTO_TEST_CASE ( test_autodiff )
+{
+  using namespace Eigen;
+  using namespace se3;
+  typedef AutoDiffScalar<VectorXd> AD;
+  typedef Matrix<AD,Dynamic,1> VectorXad;
+
+  se3::Model model;
+  buildAllJointsModel(model);
+  model.addFrame(Frame("tool",model.getJointId("rz_joint"),SE3::Random()));
+
+  const ModelTpl<double> model_d (model);
+  DataTpl<double> data_d (model_d);
+  const ModelTpl<AD> model_ad (model_d.cast<AD>());
+  DataTpl<AD> data_ad (model_ad);
+
+  const VectorXd q = randomConfiguration(model);
+  const VectorXd v = VectorXd::Random(model.nv);
+  const VectorXd a = VectorXd::Random(model.nv);
+
+  // Seed the derivatives wrt the configuration coordinates, then wrt the velocity
+  VectorXad q_ad (model.nq), v_ad (model.nv), a_ad (a.cast<AD>());
+  for(int k=0;k<model.nq;++k) q_ad[k] = AD(q[k],model.nq,k);
+  for(int k=0;k<model.nv;++k) v_ad[k] = AD(v[k],VectorXd::Zero(model.nq));
+  for(int k=0;k<model.nv;++k) a_ad[k].derivatives() = VectorXd::Zero(model.nq);
+
+  rnea(model_ad,data_ad,q_ad,v_ad,a_ad);
+  MatrixXd dtau_dq (model.nv,model.nq);
+  for(int k=0;k<model.nv;++k) dtau_dq.row(k) = data_ad.tau[k].derivatives().transpose();
+
+  centerOfMass(model_ad,data_ad,q_ad);
+  MatrixXd dcom_dq (3,model.nq);
+  for(int k=0;k<3;++k) dcom_dq.row(k) = data_ad.com[k].derivatives().transpose();
+
+  const VectorXd dT_dq (kineticEnergy(model_ad,data_ad,q_ad,v_ad).derivatives());
+  const VectorXd dV_dq (potentialEnergy(model_ad,data_ad,q_ad).derivatives());
+
+  framesForwardKinematics(model_ad,data_ad,q_ad);
+  MatrixXd dframe_dq (3,model.nq);
+  for(int k=0;k<3;++k) dframe_dq.row(k) = data_ad.oMof[0].translation()[k].derivatives().transpose();
+
+  // Central finite differences on the configuration coordinates
+  const double eps = 1e-6;
+  MatrixXd dtau_dq_fd (model.nv,model.nq), dcom_dq_fd (3,model.nq), dframe_dq_fd (3,model.nq);
+  VectorXd dT_dq_fd (model.nq), dV_dq_fd (model.nq);
+  for(int k=0;k<model.nq;++k)
+  {
+    VectorXd q_plus (q), q_minus (q);
+    q_plus[k] += eps; q_minus[k] -= eps;
+
+    dtau_dq_fd.col(k) = rnea(model_d,data_d,q_plus,v,a);
+    dtau_dq_fd.col(k) -= rnea(model_d,data_d,q_minus,v,a);
+    dcom_dq_fd.col(k) = centerOfMass(model_d,data_d,q_plus);
+    dcom_dq_fd.col(k) -= centerOfMass(model_d,data_d,q_minus);
+    dT_dq_fd[k] = kineticEnergy(model_d,data_d,q_plus,v) - kineticEnergy(model_d,data_d,q_minus,v);
+    dV_dq_fd[k] = potentialEnergy(model_d,data_d,q_plus) - potentialEnergy(model_d,data_d,q_minus);
+    framesForwardKinematics(model_d,data_d,q_plus);
+    dframe_dq_fd.col(k) = data_d.oMof[0].translation();
+    framesForwardKinematics(model_d,data_d,q_minus);
+    dframe_dq_fd.col(k) -= data_d.oMof[0].translation();
+  }
+
+  BOOST_CHECK(dtau_dq.isApprox(dtau_dq_fd/(2.*eps), 1e-6));
+  BOOST_CHECK(dcom_dq.isApprox(dcom_dq_fd/(2.*eps), 1e-6));
+  BOOST_CHECK(dT_dq.isApprox(dT_dq_fd/(2.*eps), 1e-6));
+  BOOST_CHECK(dV_dq.isApprox(dV_dq_fd/(2.*eps), 1e-6));
+  BOOST_CHECK(dframe_dq.isApprox(dframe_dq_fd/(2.*eps), 1e-6));
+
+  // The values match the double versions, and the derivatives wrt v match the analytical derivatives of RNEA.
+  // Eigen::AutoDiffScalar resizes the derivatives of the constants to the number of seeds: a new model is needed.
+  const ModelTpl<AD> model_ad_v (model_d.cast<AD>());
+  DataTpl<AD> data_ad_v (model_ad_v);
+  for(int k=0;k<model.nv;++k) v_ad[k] = AD(v[k],model.nv,k);
+  for(int k=0;k<model.nq;++k) q_ad[k] = AD(q[k],VectorXd::Zero(model.nv));
+  for(int k=0;k<model.nv;++k) a_ad[k].derivatives() = VectorXd::Zero(model.nv);
+  rnea(model_ad_v,data_ad_v,q_ad,v_ad,a_ad);
+  se3::Data data(model);
+  computeRNEADerivatives(model,data,q,v,a);
+  for(int k=0;k<model.nv;++k)
+  {
+    BOOST_CHECK_SMALL(data_ad_v.tau[k].value() - data.tau[k], 1e-10);
+    BOOST_CHECK(data_ad_v.tau[k].derivatives().isApprox(data.dtau_dv.row(k).transpose(), 1e-10));
+  }
+
+  se3::framesForwardKinematics(model,data,q);
+  BOOST_CHECK_SMALL(centerOfMass(model_d,data_d,q).norm() - se3::centerOfMass(model,data,q).norm(), 1e-12);
+  BOOST_CHECK_SMALL(potentialEnergy(model_d,data_d,q) - se3::potentialEnergy(model,data,q), 1e-12);
+  BOOST_CHECK_SMALL(kineticEnergy(model_d,data_d,q,v) - se3::kineticEnergy(model,data,q,v), 1e-12);
+}
+
+BOOST_AUTO_TEST_CASE ( test_unsupported_joint )
+{
+  se3::Model model;
+  model.addBody(0,se3::JointModelSphericalZYX(),se3::SE3::Random(),se3::Inertia::Random(),"zyx_joint","zyx_body");
+  BOOST_CHECK_THROW(se3::ModelTpl<float> model_f (model), se3::Exception);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
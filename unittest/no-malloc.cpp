@@ -0,0 +1,212 @@
+//
+// Copyright (c) 2016 CNRS
+//
+// This file is part of Pinocchio
+// Pinocchio is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// Pinocchio is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Lesser Public License for more details. You should have
+// received a copy of the GNU Lesser General Public License along with
+// Pinocchio If not, see
+// <http://www.gnu.org/licenses/>.
+
+/*
+ * Check that the algorithms make no heap allocation once se3::Data is constructed.
+ * The Eigen allocations are detected through EIGEN_RUNTIME_NO_MALLOC, which makes Eigen call eigen_assert before any
+ * allocation when it is forbidden: eigen_assert is redefined to count the failures instead of aborting, whatever NDEBUG.
+ * The other allocations (e.g. of std::vector) are detected by replacing the global operator new.
+ */
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+  int nb_allocations = 0;
+  bool count_allocations = false;
+}
+
+#define EIGEN_RUNTIME_NO_MALLOC
+#define eigen_assert(x) do { if(!(x) && count_allocations) ++nb_allocations; } while(false)
+
+#include "pinocchio/multibody/model.hpp"
+#include "pinocchio/algorithm/kinematics.hpp"
+#include "pinocchio/algorithm/rnea.hpp"
+#include "pinocchio/algorithm/aba.hpp"
+#include "pinocchio/algorithm/crba.hpp"
+#include "pinocchio/algorithm/jacobian.hpp"
+#include "pinocchio/algorithm/operational-frames.hpp"
+#include "pinocchio/algorithm/center-of-mass.hpp"
+#include "pinocchio/algorithm/energy.hpp"
+#include "pinocchio/algorithm/compute-all-terms.hpp"
+#include "pinocchio/algorithm/cholesky.hpp"
+#include "pinocchio/algorithm/dynamics.hpp"
+#include "pinocchio/algorithm/joint-configuration.hpp"
+#include "pinocchio/multibody/parser/sample-models.hpp"
+
+#include <iostream>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE NoMallocTest
+#include <boost/test/unit_test.hpp>
+#include <boost/utility/binary.hpp>
+
+void * operator new(std::size_t size)
+{
+  if(count_allocations) ++nb_allocations;
+  void * p = std::malloc(size ? size : 1);
+  if(p == NULL) throw std::bad_alloc();
+  return p;
+}
+
+void operator delete(void * p) throw() { std::free(p); }
+
+namespace
+{
+  /// Count the heap allocations during its lifetime (until stop is called).
+  struct AllocationCounter
+  {
+    AllocationCounter()
+    {
+      nb_allocations = 0;
+      count_allocations = true;
+      Eigen::internal::set_is_malloc_allowed(false);
+    }
+    ~AllocationCounter() { stop(); }
+
+    int stop()
+    {
+      Eigen::internal::set_is_malloc_allowed(true);
+      count_allocations = false;
+      return nb_allocations;
+    }
+  };
+}
+
+#define CHECK_NO_MALLOC(expr)                                                   \
+  {                                                                             \
+    AllocationCounter counter;                                                  \
+    expr;                                                                       \
+    const int nb = counter.stop();                                              \
+    BOOST_CHECK_MESSAGE(nb == 0, #expr " made " << nb << " heap allocations");  \
+  }
+
+BOOST_AUTO_TEST_SUITE ( BOOST_TEST_MODULE )
+
+BOOST_AUTO_TEST_CASE ( test_counter )
+{
+  AllocationCounter counter;
+  Eigen::VectorXd x (12);
+  std::vector<int> y (3);
+  BOOST_CHECK_EQUAL(counter.stop(), 2);
+}
+
+BOOST_AUTO_TEST_CASE ( test_algorithms )
+{
+  using namespace Eigen;
+  using namespace se3;
+
+  se3::Model model;
+  buildModels::humanoidSimple(model,true);
+  model.addFrame("rh_tool",(JointIndex)(model.nbody-1),SE3::Random());
+
+  VectorXd q = VectorXd::Random(model.nq); q.segment<4>(3).normalize();
+  const VectorXd v = VectorXd::Random(model.nv);
+  const VectorXd a = VectorXd::Random(model.nv);
+  const VectorXd tau = VectorXd::Random(model.nv);
+  Data::Matrix6x J (Data::Matrix6x::Zero(6,model.nv));
+
+  se3::Data data(model);
+
+  CHECK_NO_MALLOC(forwardKinematics(model,data,q));
+  CHECK_NO_MALLOC(forwardKinematics(model,data,q,v));
+  CHECK_NO_MALLOC(forwardKinematics(model,data,q,v,a));
+  CHECK_NO_MALLOC(framesForwardKinematics(model,data,q));
+  CHECK_NO_MALLOC(rnea(model,data,q,v,a));
+  CHECK_NO_MALLOC(nonLinearEffects(model,data,q,v));
+  CHECK_NO_MALLOC(aba(model,data,q,v,tau));
+  // The first call sizes data.Minv and its workspace.
+  computeMinverse(model,data,q);
+  CHECK_NO_MALLOC(computeMinverse(model,data,q));
+  CHECK_NO_MALLOC(crba(model,data,q));
+  CHECK_NO_MALLOC(crbaSparse(model,data,q));
+  CHECK_NO_MALLOC(ccrba(model,data,q,v));
+  CHECK_NO_MALLOC(cholesky::decompose(model,data));
+  CHECK_NO_MALLOC(computeJacobians(model,data,q));
+  CHECK_NO_MALLOC(getJacobian<true>(model,data,(JointIndex)(model.nbody-1),J));
+  CHECK_NO_MALLOC(getFrameJacobian<false>(model,data,0,J));
+  CHECK_NO_MALLOC(centerOfMass(model,data,q,v,a));
+  CHECK_NO_MALLOC(jacobianCenterOfMass(model,data,q));
+  CHECK_NO_MALLOC(kineticEnergy(model,data,q,v));
+  CHECK_NO_MALLOC(potentialEnergy(model,data,q));
+  CHECK_NO_MALLOC(computeAllTerms(model,data,q,v));
+}
+
+BOOST_AUTO_TEST_CASE ( test_contact_dynamics )
+{
+  using namespace Eigen;
+  using namespace se3;
+
+  se3::Model model;
+  buildModels::humanoidSimple(model,true);
+  se3::Data data(model);
+
+  VectorXd q = VectorXd::Random(model.nq); q.segment<4>(3).normalize();
+  const VectorXd v = VectorXd::Random(model.nv);
+  const VectorXd tau = VectorXd::Random(model.nv);
+
+  // Contacts on the two feet
+  std::vector<Model::JointIndex> contacts;
+  contacts.push_back(model.getJointId("rleg6_joint"));
+  contacts.push_back(model.getJointId("lleg6_joint"));
+  computeJacobians(model,data,q);
+  MatrixXd J (MatrixXd::Zero(12,model.nv));
+  Data::Matrix6x Jc (Data::Matrix6x::Zero(6,model.nv));
+  for(std::size_t c=0;c<contacts.size();++c)
+  {
+    Jc.setZero(); getJacobian<true>(model,data,contacts[c],Jc);
+    J.middleRows<6>(6*(int)c) = Jc;
+  }
+  const VectorXd gamma (VectorXd::Random(12));
+
+  // The first call sizes the buffers depending on the number of constraints.
+  forwardDynamics(model,data,q,v,tau,J,gamma);
+  CHECK_NO_MALLOC(forwardDynamics(model,data,q,v,tau,J,gamma));
+  forwardDynamicsSparse(model,data,q,v,tau,J,gamma);
+  CHECK_NO_MALLOC(forwardDynamicsSparse(model,data,q,v,tau,J,gamma));
+  forwardDynamicsRecursive(model,data,q,v,tau,contacts,gamma);
+  CHECK_NO_MALLOC(forwardDynamicsRecursive(model,data,q,v,tau,contacts,gamma));
+  impulseDynamics(model,data,q,v,J);
+  CHECK_NO_MALLOC(impulseDynamics(model,data,q,v,J));
+}
+
+BOOST_AUTO_TEST_CASE ( test_joint_configuration )
+{
+  using namespace Eigen;
+  using namespace se3;
+
+  se3::Model model;
+  buildModels::humanoidSimple(model,true);
+
+  VectorXd q0 = VectorXd::Random(model.nq); q0.segment<4>(3).normalize();
+  VectorXd q1 = VectorXd::Random(model.nq); q1.segment<4>(3).normalize();
+  const VectorXd v = VectorXd::Random(model.nv);
+  const VectorXd lower (-VectorXd::Ones(model.nq)), upper (VectorXd::Ones(model.nq));
+  VectorXd q (model.nq), dq (model.nv), d (model.nbody-1);
+
+  CHECK_NO_MALLOC(integrate(model,q0,v,q));
+  BOOST_CHECK(q.isApprox(integrate(model,q0,v), 1e-12));
+  CHECK_NO_MALLOC(interpolate(model,q0,q1,0.3,q));
+  BOOST_CHECK(q.isApprox(interpolate(model,q0,q1,0.3), 1e-12));
+  CHECK_NO_MALLOC(differentiate(model,q0,q1,dq));
+  BOOST_CHECK(dq.isApprox(differentiate(model,q0,q1), 1e-12));
+  CHECK_NO_MALLOC(distance(model,q0,q1,d));
+  BOOST_CHECK(d.isApprox(distance(model,q0,q1), 1e-12));
+  CHECK_NO_MALLOC(randomConfiguration(model,lower,upper,q));
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
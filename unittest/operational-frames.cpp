@@ -53,6 +53,56 @@ BOOST_AUTO_TEST_CASE ( test_kinematics )
 
 }
 
+BOOST_AUTO_TEST_CASE ( test_kinematics_incremental )
+{
+  using namespace Eigen;
+  using namespace se3;
+
+  se3::Model model;
+  se3::buildModels::humanoidSimple(model);
+  const Model::Index rarm_idx = model.getJointId("rarm2_joint");
+  const Model::Index lleg_idx = model.getJointId("lleg2_joint");
+  model.addFrame("rarm_frame", rarm_idx, SE3::Random());
+  model.addFrame("lleg_frame", lleg_idx, SE3::Random());
+  se3::Data data(model), data_ref(model);
+
+  VectorXd q = VectorXd::Random(model.nq);
+  q.middleRows<4> (3).normalize();
+
+  // First call: everything is computed.
+  framesForwardKinematicsIncremental(model, data, q);
+  framesForwardKinematics(model, data_ref, q);
+  for(Model::JointIndex i=1;i<(Model::JointIndex)model.nbody;++i)
+  {
+    BOOST_CHECK(data.oMi_updated[i]);
+    BOOST_CHECK(data.oMi[i].isApprox(data_ref.oMi[i]));
+  }
+
+  // Only the right arm moves.
+  q[idx_q(model.joints[rarm_idx])] += 0.3;
+  framesForwardKinematicsIncremental(model, data, q);
+  framesForwardKinematics(model, data_ref, q);
+  for(Model::JointIndex i=1;i<(Model::JointIndex)model.nbody;++i)
+  {
+    const bool in_subtree = ((int)i >= (int)rarm_idx && (int)i <= data.lastChild[rarm_idx]);
+    BOOST_CHECK(data.oMi_updated[i] == in_subtree);
+    BOOST_CHECK(data.oMi[i].isApprox(data_ref.oMi[i]));
+  }
+  for(Model::FrameIndex k=0;k<(Model::FrameIndex)model.nOperationalFrames;++k)
+    BOOST_CHECK(data.oMof[k].isApprox(data_ref.oMof[k]));
+
+  // Nothing moves.
+  forwardKinematicsIncremental(model, data, q);
+  for(Model::JointIndex i=1;i<(Model::JointIndex)model.nbody;++i)
+    BOOST_CHECK(!data.oMi_updated[i]);
+
+  // The placements are recomputed from scratch after a reset.
+  forwardKinematics(model, data, VectorXd::Zero(model.nq));
+  resetIncrementalKinematics(data);
+  forwardKinematicsIncremental(model, data, q);
+  for(Model::JointIndex i=1;i<(Model::JointIndex)model.nbody;++i)
+    BOOST_CHECK(data.oMi[i].isApprox(data_ref.oMi[i]));
+}
 
 BOOST_AUTO_TEST_CASE ( test_jacobian )
 {
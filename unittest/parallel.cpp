@@ -0,0 +1,95 @@
+//
+// Copyright (c) 2016 CNRS
+//
+// This file is part of Pinocchio
+// Pinocchio is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// Pinocchio is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Lesser Public License for more details. You should have
+// received a copy of the GNU Lesser General Public License along with
+// Pinocchio If not, see
+// <http://www.gnu.org/licenses/>.
+
+#include "pinocchio/multibody/model.hpp"
+#include "pinocchio/algorithm/parallel.hpp"
+#include "pinocchio/multibody/parser/sample-models.hpp"
+
+#include <iostream>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE ParallelTest
+#include <boost/test/unit_test.hpp>
+#include <boost/utility/binary.hpp>
+
+BOOST_AUTO_TEST_SUITE ( Parallel )
+
+BOOST_AUTO_TEST_CASE ( test_thread_pool )
+{
+  using namespace se3::parallel;
+
+  struct CountJob : public Job
+  {
+    CountJob(const int n, const int nthreads) : count(n,0), worker_count(nthreads,0) {}
+    void operator() (const int worker, const int k) { ++count[(std::size_t)k]; ++worker_count[(std::size_t)worker]; }
+    std::vector<int> count, worker_count;
+  };
+
+  ThreadPool pool(4);
+  BOOST_CHECK(pool.size() == 4);
+
+  const int n = 1003;
+  for(int run=0;run<10;++run)
+  {
+    CountJob job(n,pool.size());
+    pool.run(job,n);
+
+    int total = 0;
+    for(int k=0;k<n;++k) BOOST_CHECK(job.count[(std::size_t)k] == 1);
+    for(int w=0;w<pool.size();++w) total += job.worker_count[(std::size_t)w];
+    BOOST_CHECK(total == n);
+  }
+
+  CountJob empty_job(0,pool.size());
+  pool.run(empty_job,0);
+}
+
+BOOST_AUTO_TEST_CASE ( test_batch_algorithms )
+{
+  using namespace Eigen;
+  using namespace se3;
+  using namespace se3::parallel;
+
+  se3::Model model; buildModels::humanoidSimple(model);
+  se3::Data data(model);
+  DataPool pool(model,3);
+
+  const int nsamples = 17;
+  MatrixXd Q (MatrixXd::Random(model.nq,nsamples));
+  MatrixXd V (MatrixXd::Random(model.nv,nsamples));
+  MatrixXd A (MatrixXd::Random(model.nv,nsamples));
+  for(int k=0;k<nsamples;++k) Q.col(k).segment<4>(3).normalize();
+
+  MatrixXd tau, ddq, M;
+  Data::Matrix6x J;
+  rneaBatch(pool,Q,V,A,tau);
+  abaBatch(pool,Q,V,tau,ddq);
+  crbaBatch(pool,Q,M);
+  computeJacobiansBatch(pool,Q,J);
+
+  for(int k=0;k<nsamples;++k)
+  {
+    VectorXd q (Q.col(k)), v (V.col(k)), a (A.col(k));
+
+    BOOST_CHECK(tau.col(k).isApprox(rnea(model,data,q,v,a), 1e-12));
+    BOOST_CHECK(ddq.col(k).isApprox(a, 1e-10));
+    BOOST_CHECK(M.middleCols(k*model.nv,model.nv).isApprox(crba(model,data,q), 1e-12));
+    BOOST_CHECK(J.middleCols(k*model.nv,model.nv).isApprox(computeJacobians(model,data,q), 1e-12));
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
@@ -0,0 +1,116 @@
+//
+// Copyright (c) 2016 CNRS
+//
+// This file is part of Pinocchio
+// Pinocchio is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// Pinocchio is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Lesser Public License for more details. You should have
+// received a copy of the GNU Lesser General Public License along with
+// Pinocchio If not, see
+// <http://www.gnu.org/licenses/>.
+
+#include "pinocchio/multibody/model.hpp"
+#include "pinocchio/algorithm/rnea.hpp"
+#include "pinocchio/algorithm/crba.hpp"
+#include "pinocchio/algorithm/rnea-derivatives.hpp"
+#include "pinocchio/spatial/explog.hpp"
+#include "pinocchio/multibody/parser/sample-models.hpp"
+
+#include <iostream>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE RneaDerivativesTest
+#include <boost/test/unit_test.hpp>
+#include <boost/utility/binary.hpp>
+
+/* Move the dof k of q by eps along its motion subspace. The free flyer, if any, is the first joint. */
+Eigen::VectorXd perturb(const se3::Model & model, const Eigen::VectorXd & q,
+                        const int k, const double eps, const bool usingFF)
+{
+  using namespace se3;
+  Eigen::VectorXd q_plus (q);
+  if(usingFF && k < 6)
+  {
+    Eigen::Map<const Eigen::Quaterniond> quat(q.segment<4>(3).data());
+    SE3 M (quat.toRotationMatrix(), q.head<3>());
+    Motion::Vector6 dv (Motion::Vector6::Zero()); dv[k] = eps;
+    M = M * exp6(Motion(dv));
+    q_plus.head<3>() = M.translation();
+    q_plus.segment<4>(3) = Eigen::Quaterniond(M.rotation()).coeffs();
+  }
+  else
+    q_plus[k + model.nq - model.nv] += eps;
+  return q_plus;
+}
+
+BOOST_AUTO_TEST_SUITE ( RneaDerivativesTest )
+
+BOOST_AUTO_TEST_CASE ( test_rnea_derivatives_vs_finite_differences )
+{
+  using namespace Eigen;
+  using namespace se3;
+  
+  for(int usingFF=0;usingFF<2;++usingFF)
+  {
+    se3::Model model; buildModels::humanoidSimple(model,usingFF==1);
+    se3::Data data(model), data_fd(model);
+    
+    VectorXd q (VectorXd::Random(model.nq));
+    if(usingFF==1) q.segment<4>(3).normalize();
+    VectorXd v (VectorXd::Random(model.nv));
+    VectorXd a (VectorXd::Random(model.nv));
+    
+    computeRNEADerivatives(model,data,q,v,a);
+    
+    const VectorXd tau (rnea(model,data_fd,q,v,a));
+    BOOST_CHECK(data.tau.isApprox(tau, 1e-12));
+    
+    crba(model,data_fd,q);
+    data_fd.M.triangularView<Eigen::StrictlyLower>() = data_fd.M.transpose().triangularView<Eigen::StrictlyLower>();
+    BOOST_CHECK(data.M.isApprox(data_fd.M, 1e-12));
+    
+    const double eps = 1e-6;
+    MatrixXd dtau_dq_fd (model.nv,model.nv), dtau_dv_fd (model.nv,model.nv);
+    for(int k=0;k<model.nv;++k)
+    {
+      const VectorXd q_plus (perturb(model,q,k,eps,usingFF==1));
+      const VectorXd q_minus (perturb(model,q,k,-eps,usingFF==1));
+      dtau_dq_fd.col(k) = rnea(model,data_fd,q_plus,v,a);
+      dtau_dq_fd.col(k) -= rnea(model,data_fd,q_minus,v,a);
+      dtau_dq_fd.col(k) /= 2.*eps;
+      
+      VectorXd v_plus (v), v_minus (v);
+      v_plus[k] += eps; v_minus[k] -= eps;
+      dtau_dv_fd.col(k) = rnea(model,data_fd,q,v_plus,a);
+      dtau_dv_fd.col(k) -= rnea(model,data_fd,q,v_minus,a);
+      dtau_dv_fd.col(k) /= 2.*eps;
+    }
+    
+    BOOST_CHECK(data.dtau_dq.isApprox(dtau_dq_fd, 1e-6));
+    BOOST_CHECK(data.dtau_dv.isApprox(dtau_dv_fd, 1e-6));
+  }
+}
+
+BOOST_AUTO_TEST_CASE ( test_rnea_derivatives_spherical_zyx )
+{
+  using namespace Eigen;
+  using namespace se3;
+  
+  se3::Model model;
+  const JointIndex i = model.addBody(0,JointModelRX(),SE3::Random(),Inertia::Random(),"rx_joint","rx_body");
+  model.addBody(i,JointModelSphericalZYX(),SE3::Random(),Inertia::Random(),"zyx_joint","zyx_body");
+  se3::Data data(model);
+  
+  const VectorXd q (VectorXd::Random(model.nq));
+  const VectorXd v (VectorXd::Random(model.nv));
+  const VectorXd a (VectorXd::Random(model.nv));
+  BOOST_CHECK_THROW(computeRNEADerivatives(model,data,q,v,a), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
@@ -28,6 +28,7 @@
 #include "pinocchio/multibody/visitor.hpp"
 #include "pinocchio/multibody/model.hpp"
 #include "pinocchio/algorithm/rnea.hpp"
+#include "pinocchio/algorithm/rnea-batch.hpp"
 #include "pinocchio/multibody/parser/sample-models.hpp"
 #include "pinocchio/tools/timer.hpp"
 
@@ -132,4 +133,34 @@ BOOST_AUTO_TEST_CASE ( test_nle_vs_rnea )
   
   BOOST_CHECK (tau_nle.isApprox(tau_rnea, 1e-12));
 }
+
+BOOST_AUTO_TEST_CASE ( test_rnea_batch )
+{
+  using namespace Eigen;
+  using namespace se3;
+  
+  const int nsamples = 7;
+  for(int usingFF=0;usingFF<2;++usingFF)
+  {
+    se3::Model model; buildModels::humanoidSimple(model,usingFF==1);
+    se3::Data data(model);
+    se3::BatchData batch_data(model,nsamples);
+    
+    MatrixXd Q (MatrixXd::Random(model.nq,nsamples));
+    MatrixXd V (MatrixXd::Random(model.nv,nsamples));
+    MatrixXd A (MatrixXd::Random(model.nv,nsamples));
+    if(usingFF==1)
+      for(int k=0;k<nsamples;++k) Q.col(k).segment<4>(3).normalize();
+    
+    const MatrixXd & tau_batch = rnea(model,batch_data,Q,V,A);
+    BOOST_CHECK(tau_batch.rows() == model.nv && tau_batch.cols() == nsamples);
+    
+    for(int k=0;k<nsamples;++k)
+    {
+      VectorXd q (Q.col(k)), v (V.col(k)), a (A.col(k));
+      const VectorXd & tau = rnea(model,data,q,v,a);
+      BOOST_CHECK(tau.isApprox(tau_batch.col(k), 1e-12));
+    }
+  }
+}
 BOOST_AUTO_TEST_SUITE_END ()
@@ -0,0 +1,92 @@
+//
+// Copyright (c) 2016 CNRS
+//
+// This file is part of Pinocchio
+// Pinocchio is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// Pinocchio is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Lesser Public License for more details. You should have
+// received a copy of the GNU Lesser General Public License along with
+// Pinocchio If not, see
+// <http://www.gnu.org/licenses/>.
+
+#include "pinocchio/multibody/model.hpp"
+#include "pinocchio/algorithm/kinematics.hpp"
+#include "pinocchio/algorithm/rnea.hpp"
+#include "pinocchio/algorithm/aba.hpp"
+#include "pinocchio/algorithm/crba.hpp"
+#include "pinocchio/algorithm/static-model.hpp"
+#include "pinocchio/multibody/parser/sample-models.hpp"
+#include "pinocchio/tools/timer.hpp"
+
+// Generated at build time by pinocchio_generate_static_model HS StaticHumanoidSimple
+#include "static-humanoid-simple.hpp"
+
+#include <iostream>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE StaticModelTest
+#include <boost/test/unit_test.hpp>
+#include <boost/utility/binary.hpp>
+
+BOOST_AUTO_TEST_SUITE ( StaticModel )
+
+BOOST_AUTO_TEST_CASE ( test_generated_code )
+{
+  using namespace se3;
+
+  se3::Model model; buildModels::humanoidSimple(model);
+  std::ostringstream code;
+  generateStaticModel(model,"StaticHumanoidSimple",code);
+
+  BOOST_CHECK(code.str().find("class StaticHumanoidSimple") != std::string::npos);
+  BOOST_CHECK(code.str().find("se3::RneaForwardStep::algo<se3::JointModelFreeFlyer>(jmodel_1,jdata_1,model,data,q,v,a);") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE ( test_static_vs_generic )
+{
+  using namespace Eigen;
+  using namespace se3;
+
+  se3::Model model; buildModels::humanoidSimple(model);
+  se3::Data data(model), data_ref(model);
+  static_model::StaticHumanoidSimple robot(model,data);
+
+  VectorXd q = VectorXd::Random(model.nq); q.segment<4>(3).normalize();
+  VectorXd v = VectorXd::Random(model.nv);
+  VectorXd a = VectorXd::Random(model.nv);
+
+  forwardKinematics(model,data_ref,q);
+  robot.forwardKinematics(q);
+  for(Model::JointIndex i=1;i<(Model::JointIndex)model.nbody;++i)
+    BOOST_CHECK(data.oMi[i].isApprox(data_ref.oMi[i]));
+
+  BOOST_CHECK(robot.rnea(q,v,a).isApprox(rnea(model,data_ref,q,v,a), 1e-12));
+  const VectorXd tau = data.tau;
+  BOOST_CHECK(robot.aba(q,v,tau).isApprox(aba(model,data_ref,q,v,tau), 1e-12));
+  BOOST_CHECK(robot.aba(q,v,tau).isApprox(a, 1e-10));
+  BOOST_CHECK(robot.crba(q).isApprox(crba(model,data_ref,q), 1e-12));
+
+  #ifdef NDEBUG
+    const size_t NBT = 100000;
+  #else
+    const size_t NBT = 1;
+    std::cout << "(the time score in debug mode is not relevant)  " ;
+  #endif
+
+  StackTicToc timer(StackTicToc::US);
+  timer.tic();
+  SMOOTH(NBT) { rnea(model,data_ref,q,v,a); }
+  std::cout << "RNEA = \t\t"; timer.toc(std::cout,NBT);
+
+  timer.tic();
+  SMOOTH(NBT) { robot.rnea(q,v,a); }
+  std::cout << "static RNEA = \t"; timer.toc(std::cout,NBT);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
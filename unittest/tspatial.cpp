@@ -23,6 +23,7 @@
 #include "pinocchio/spatial/se3.hpp"
 #include "pinocchio/spatial/inertia.hpp"
 #include "pinocchio/spatial/act-on-set.hpp"
+#include "pinocchio/spatial/act-on-batch.hpp"
 #include "pinocchio/spatial/explog.hpp"
 
 #define BOOST_TEST_DYN_LINK
@@ -312,6 +313,56 @@ BOOST_AUTO_TEST_CASE ( test_ActOnSet )
 
 }
 
+BOOST_AUTO_TEST_CASE ( test_ActOnPack )
+{
+  using namespace se3;
+  typedef batch::Vector6x8 Vector6x8;
+  const int N = 8;
+
+  batch::SE3x8 M1, M2, M12;
+  batch::Matrix6x V (batch::Matrix6x::Random(6,N)), F (batch::Matrix6x::Random(6,N));
+  for(int l=0;l<N;++l) { M1.set(l,SE3::Random()); M2.set(l,SE3::Random()); }
+
+  Vector6x8 v, f, res;
+  v.load(V,0); f.load(F,0);
+  batch::compose(M1,M2,M12);
+  for(int l=0;l<N;++l)
+    BOOST_CHECK(M12.get(l).isApprox(M1.get(l)*M2.get(l), 1e-12));
+
+  batch::Matrix6x out (batch::Matrix6x::Zero(6,N));
+  batch::motionAction(M1,v,res); res.addTo(out,0);
+  for(int l=0;l<N;++l)
+    BOOST_CHECK(out.col(l).isApprox(M1.get(l).act(Motion(V.col(l))).toVector(), 1e-12));
+
+  out.setZero(); batch::motionActionInverse(M1,v,res); res.addTo(out,0);
+  for(int l=0;l<N;++l)
+    BOOST_CHECK(out.col(l).isApprox(M1.get(l).actInv(Motion(V.col(l))).toVector(), 1e-12));
+
+  out.setZero(); batch::forceAction(M1,f,res); res.addTo(out,0);
+  for(int l=0;l<N;++l)
+    BOOST_CHECK(out.col(l).isApprox(M1.get(l).act(Force(F.col(l))).toVector(), 1e-12));
+
+  out.setZero(); batch::forceActionInverse(M1,f,res); res.addTo(out,0);
+  for(int l=0;l<N;++l)
+    BOOST_CHECK(out.col(l).isApprox(M1.get(l).actInv(Force(F.col(l))).toVector(), 1e-12));
+
+  // Batch kernels, with a number of samples which is not a multiple of the pack size
+  const int n = 6;
+  batch::SE3Batch B1(n), B2(n), B12(n);
+  for(int k=0;k<n;++k) { B1.set(k,SE3::Random()); B2.set(k,SE3::Random()); }
+  batch::compose(B1,B2,B12);
+  batch::Matrix6x iV (batch::Matrix6x::Random(6,n)), jV (batch::Matrix6x::Zero(6,n));
+  batch::Matrix6x iF (batch::Matrix6x::Random(6,n)), jF (batch::Matrix6x::Zero(6,n));
+  batch::motionActionInverse(B1,iV,jV);
+  batch::forceAction(B1,iF,jF);
+  for(int k=0;k<n;++k)
+  {
+    BOOST_CHECK(B12.get(k).isApprox(B1.get(k)*B2.get(k), 1e-12));
+    BOOST_CHECK(jV.col(k).isApprox(B1.get(k).actInv(Motion(iV.col(k))).toVector(), 1e-12));
+    BOOST_CHECK(jF.col(k).isApprox(B1.get(k).act(Force(iF.col(k))).toVector(), 1e-12));
+  }
+}
+
 BOOST_AUTO_TEST_CASE ( test_Explog )
 {
   typedef se3::SE3::Vector3 Vector3;
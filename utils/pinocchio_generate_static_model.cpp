@@ -0,0 +1,111 @@
+//
+// Copyright (c) 2016 CNRS
+//
+// This file is part of Pinocchio
+// Pinocchio is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// Pinocchio is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Lesser Public License for more details. You should have
+// received a copy of the GNU Lesser General Public License along with
+// Pinocchio If not, see
+// <http://www.gnu.org/licenses/>.
+
+#include <iostream>
+#include <fstream>
+
+#include "pinocchio/multibody/model.hpp"
+#include "pinocchio/multibody/parser/sample-models.hpp"
+#include "pinocchio/algorithm/static-model.hpp"
+
+#ifdef WITH_URDFDOM
+  #include "pinocchio/multibody/parser/urdf.hpp"
+#endif
+
+#ifdef WITH_LUA
+  #include "pinocchio/multibody/parser/lua.hpp"
+#endif
+
+#include "pinocchio/multibody/parser/utils.hpp"
+
+using namespace std;
+
+void usage (const char* application_name) {
+  cerr << "Usage: " << application_name << " [-f] <model.extension|HS|H2> <ClassName> <output.hpp>" << endl;
+  cerr << "  -f | --free-flyer         add a free flyer joint at the root of the model" << endl;
+  cerr << "  HS, H2                    use the sample models humanoidSimple or humanoid2d (-f is not supported by H2)" << endl;
+  exit (1);
+}
+
+int main(int argc, char *argv[])
+{
+  std::vector<std::string> args;
+  bool free_flyer = false;
+
+  for (int i = 1; i < argc; i++) {
+    if (string(argv[i]) == "-f" || string (argv[i]) == "--free-flyer")
+      free_flyer = true;
+    else if (string(argv[i]) == "-h" || string (argv[i]) == "--help")
+      usage(argv[0]);
+    else
+      args.push_back(argv[i]);
+  }
+  if (args.size() != 3)
+    usage(argv[0]);
+
+  const std::string & filename = args[0];
+  se3::Model model;
+
+  if (filename == "HS")
+    se3::buildModels::humanoidSimple(model, free_flyer);
+  else if (filename == "H2")
+  {
+    if (free_flyer)
+    {
+      std::cerr << "The sample model H2 cannot be built with a free flyer." << std::endl;
+      return -1;
+    }
+    se3::buildModels::humanoid2d(model);
+  }
+  else
+  {
+    switch(se3::checkModelFileExtension(filename))
+    {
+      case se3::URDF:
+#ifdef WITH_URDFDOM
+        if (free_flyer)
+          model = se3::urdf::buildModel(filename, se3::JointModelFreeFlyer());
+        else
+          model = se3::urdf::buildModel(filename);
+#else
+        std::cerr << "It seems that the URDFDOM module has not been found during the Cmake process." << std::endl;
+        return -1;
+#endif
+        break;
+      case se3::LUA:
+#ifdef WITH_LUA
+        model = se3::lua::buildModel(filename, free_flyer);
+#else
+        std::cerr << "It seems that the LUA module has not been found during the Cmake process." << std::endl;
+        return -1;
+#endif
+        break;
+      case se3::UNKNOWN:
+        std::cerr << "Unknown extension of " << filename << std::endl;
+        return -1;
+    }
+  }
+
+  std::ofstream file(args[2].c_str());
+  if (!file)
+  {
+    std::cerr << "Impossible to open " << args[2] << std::endl;
+    return -1;
+  }
+  se3::generateStaticModel(model, args[1], file);
+  return 0;
+}